@@ -43,4 +43,22 @@ static inline void cpu_relax_yield(void) {
 #endif
 }
 
+// Architecture Primitive: SIMD Capability Probe (Runtime Dispatch)
+// x86-64: AVX2 por CPUID. RISC-V: bit 'V' de misa; si existe, habilita
+// mstatus.VS (Initial) para que las instrucciones vectoriales no atrapen.
+static inline int arch_probe_vector(void) {
+#if defined(ARCH_X86_64)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? 1 : 0;
+#elif defined(ARCH_RISCV) && !defined(QCORE_TEST_ENV)
+    unsigned long misa;
+    __asm__ volatile ("csrr %0, misa" : "=r" (misa));
+    if (!(misa & (1UL << ('V' - 'A')))) return 0;
+    __asm__ volatile ("csrs mstatus, %0" :: "r" (1UL << 9)); // mstatus.VS = Initial
+    return 1;
+#else
+    return 0;
+#endif
+}
+
 #endif // QCORE_ARCH_H
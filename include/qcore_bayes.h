@@ -2,23 +2,122 @@
 #define QCORE_BAYES_H
 
 #include <stdint.h>
+#include <stddef.h>
 #include "qcore_math.h"
 
+// Caché de sorpresa: una entrada por byte de Majorana (7 bits de fase + 1 de colapso)
+#define SURPRISE_CACHE_SIZE 256
+
 // Estructura del "Prior" Bayesiano (El estado del atractor)
 typedef struct {
     int32_t mu[2];          // Media [Fase, Entropía]
     int32_t cov[2][2];      // Matriz de Covarianza 2x2
     int32_t inv_cov[2][2];  // Inversa (Cacheada para velocidad)
+
+    // D^2 memorizada por byte de Majorana. Se invalida en update_belief();
+    // mientras el atractor no aprende (p.ej. ciclos lavados por Lindblad)
+    // el juicio se resuelve con una consulta a tabla.
+    int32_t surprise_cache[SURPRISE_CACHE_SIZE];
+    uint32_t cache_valid[SURPRISE_CACHE_SIZE / 32]; // Bitmap de entradas válidas
+    uint32_t cache_hits;
+    uint32_t cache_misses;
 } bayesian_attractor_t;
 
+// Atractor N-dimensional: hasta BAYES_ND_MAX_DIM rasgos (fase, entropía,
+// visibilidad Lindblad, acumulador de fase, coherencia wetware, ...).
+// En vez de Σ y Σ^-1 guarda el factor de Cholesky Σ = L·Lᵀ, que la EMA
+// mantiene con una actualización de rango 1 en O(N²): nunca se invierte.
+#define BAYES_ND_MAX_DIM 16
+
+typedef struct {
+    uint32_t dim;                                   // N efectivo (1..BAYES_ND_MAX_DIM)
+    int32_t mu[BAYES_ND_MAX_DIM];                   // Media
+    int32_t chol[BAYES_ND_MAX_DIM][BAYES_ND_MAX_DIM]; // L triangular inferior
+    int32_t inv_diag[BAYES_ND_MAX_DIM];             // 1 / L[k][k] (sustitución sin divisiones)
+} bayesian_attractor_nd_t;
+
+// Banco de atractores: mezcla de K componentes para estadísticas multimodales
+// (el QPU deriva entre regímenes de calibración). Los parámetros de scoring
+// se reflejan en SoA para evaluar los K componentes en una pasada vectorial.
+#define ATTRACTOR_BANK_MAX 32
+#define ATTRACTOR_BANK_SPAWN_D2 0x00060000 // D²_min que abre un componente nuevo (6.0)
+
+// Filas del espejo SoA
+enum {
+    BANK_MU_PHASE, BANK_MU_ENTROPY,
+    BANK_INV00, BANK_INV01, BANK_INV10, BANK_INV11,
+    BANK_SOA_ROWS
+};
+
+// Componente del banco: solo los momentos. Sin caché de sorpresa (el scoring
+// va por el espejo SoA, que también guarda Σ^-1); el peso π_k está en weight[].
+typedef struct {
+    int32_t mu[2];          // Media [Fase, Entropía]
+    int32_t cov[2][2];      // Covarianza 2x2
+} bank_component_t;
+
+typedef struct {
+    uint32_t capacity;                              // K máximo (<= ATTRACTOR_BANK_MAX)
+    uint32_t active;                                // Componentes en uso
+    int32_t soa[BANK_SOA_ROWS][ATTRACTOR_BANK_MAX]; // mu e inv_cov por componente
+    int32_t weight[ATTRACTOR_BANK_MAX];             // π_k (suman ~1.0)
+    int32_t inv_sqrt_det[ATTRACTOR_BANK_MAX];       // 1/sqrt(det Σ_k)
+    int32_t d2[ATTRACTOR_BANK_MAX];                 // D² del último scoring
+    int32_t resp[ATTRACTOR_BANK_MAX];               // Responsabilidades del último scoring
+    bank_component_t comp[ATTRACTOR_BANK_MAX];
+} attractor_bank_t;
+
 // Initialization
 void init_bayesian_attractor(bayesian_attractor_t *attractor);
 
 // 1. Actualización de la Covarianza (Manual)
 void update_belief(bayesian_attractor_t *attractor, int32_t input_phase, int32_t input_entropy);
+// Igual con tasa de aprendizaje explícita (update_belief usa ALPHA ~0.05)
+void update_belief_weighted(bayesian_attractor_t *attractor, int32_t input_phase, int32_t input_entropy,
+                            int32_t alpha);
 
 // 2. Cálculo de Distancia de Mahalanobis (Al cuadrado)
 // Retorna D^2. Si D^2 > Umbral, es una anomalía.
 int32_t calculate_mahalanobis_sq(bayesian_attractor_t *attractor, int32_t input_phase, int32_t input_entropy);
 
+// 2b. D^2 en lote sobre arrays SoA (re-puntuación offline de flujos de colapso).
+// out[i] == calculate_mahalanobis_sq(attractor, phase[i], entropy[i]); usa el
+// backend SIMD de qcore_fixed_vec (AVX2 en el host, RVV en el target).
+void calculate_mahalanobis_sq_batch(const bayesian_attractor_t *attractor, const int32_t *phase,
+                                    const int32_t *entropy, int32_t *out, size_t n);
+// Variante fusionada: además retorna cuántas muestras superan threshold
+// (p.ej. MAX_ENTROPY_TOLERANCE), sin una segunda pasada sobre out.
+size_t calculate_mahalanobis_sq_batch_count(const bayesian_attractor_t *attractor, const int32_t *phase,
+                                            const int32_t *entropy, int32_t *out, size_t n,
+                                            int32_t threshold);
+
+// 3. Sorpresa memorizada por byte de Majorana
+// Equivale a calculate_mahalanobis_sq(int_to_fixed(raw & 0x7F), int_to_fixed(raw >> 7)).
+int32_t calculate_surprise_cached(bayesian_attractor_t *attractor, uint8_t majorana_raw);
+void invalidate_surprise_cache(bayesian_attractor_t *attractor);
+
+// 4. Atractor N-dimensional (Σ = I al iniciar; dim se satura a BAYES_ND_MAX_DIM)
+void init_bayesian_attractor_nd(bayesian_attractor_nd_t *attractor, uint32_t dim);
+// Misma EMA que update_belief() sobre x[0..dim-1]. O(N²).
+void update_belief_nd(bayesian_attractor_nd_t *attractor, const int32_t *x);
+// D^2 = |L^-1 (x - mu)|², resuelto por sustitución hacia adelante. O(N²).
+int32_t calculate_mahalanobis_sq_nd(const bayesian_attractor_nd_t *attractor, const int32_t *x);
+
+// 5. Banco de atractores (mezcla online)
+// EM online: cada bank_component_t sigue la misma EMA de (mu, Σ) que
+// update_belief, con tasa α·r_k; Σ^-1 se refleja en el espejo SoA.
+// Arranca con un componente (el atractor clásico) y abre uno nuevo por cada
+// muestra que ninguno explica (D² > ATTRACTOR_BANK_SPAWN_D2) hasta capacity.
+void attractor_bank_init(attractor_bank_t *bank, uint32_t capacity);
+// D² de los componentes [k_begin, k_end) en bank->d2. Los rangos disjuntos no
+// comparten escrituras: cada hart/hilo puede evaluar el suyo en paralelo.
+void attractor_bank_score_range(attractor_bank_t *bank, int32_t phase, int32_t entropy,
+                                uint32_t k_begin, uint32_t k_end);
+// Responsabilidades a partir de bank->d2. Retorna la D² mínima (sorpresa frente a la mezcla).
+int32_t attractor_bank_finish_score(attractor_bank_t *bank);
+// score_range sobre todos los componentes + finish_score
+int32_t attractor_bank_score(attractor_bank_t *bank, int32_t phase, int32_t entropy);
+// Paso E + M: pesos y componentes aprenden en proporción a su responsabilidad
+void attractor_bank_update(attractor_bank_t *bank, int32_t phase, int32_t entropy);
+
 #endif // QCORE_BAYES_H
@@ -0,0 +1,83 @@
+#ifndef QCORE_DENSITY_H
+#define QCORE_DENSITY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "qcore_math.h"
+
+/**
+ * INTEGRADOR DE LA ECUACIÓN MAESTRA DE LINDBLAD
+ *
+ *   dρ/dt = -i[H, ρ] + Σ_k Γ_k (L_k ρ L_k† - 1/2 {L_k† L_k, ρ})
+ *
+ * para matrices densidad pequeñas (dim <= DENSITY_MAX_DIM).
+ *
+ * Representación compacta: ρ es hermítica, así que basta el triángulo
+ * superior. Un canal son dim² parámetros reales:
+ *   x[0 .. dim-1]      ρ_kk (diagonal, real)
+ *   x[dim ..]          Re ρ_ab, Im ρ_ab para cada a < b en orden de filas
+ *
+ * En esa base el generador es una matriz real G (dim² x dim²). Para un
+ * generador lineal e invariante, las cuatro etapas de RK4 colapsan en
+ * P = Σ_{k<=4} (G·dt)^k / k!, que se precalcula una vez en Q2.30
+ * (density_prop_build). Cada paso es entonces x ← P·x.
+ *
+ * Lotes: muchos canales independientes que comparten P se guardan en SoA,
+ * x[k*stride + c] = parámetro k del canal c, y se integran en grupos de
+ * DENSITY_LANES canales (un carril SIMD por canal). Cada grupo se carga
+ * una vez y recorre todos los pasos en registros.
+ *   - density_step_q16 : Q16.16, C portable (kernel y host)
+ *   - density_step_f32 : float, AVX2/FMA en el host (solo libqcore.so)
+ */
+
+#define DENSITY_MAX_DIM 4
+#define DENSITY_MAX_PARAMS (DENSITY_MAX_DIM * DENSITY_MAX_DIM)
+#define DENSITY_LANES 8
+
+typedef struct {
+    fixed_t re;
+    fixed_t im;
+} cfixed_t;
+
+// Propagador de un paso (RK4 precalculado)
+typedef struct {
+    uint32_t dim;
+    uint32_t n_params;                                  // dim²
+    int32_t p[DENSITY_MAX_PARAMS][DENSITY_MAX_PARAMS];  // Q2.30
+} density_prop_t;
+
+/**
+ * Precalcula el propagador de paso dt
+ *
+ * @param h: Hamiltoniano dim x dim por filas (Q16.16, hermítico)
+ * @param jumps: n_jumps operadores L_k dim x dim consecutivos por filas
+ * @param rates: Γ_k (Q16.16)
+ * @return: 0, o -1 si dim no es válido o ||G·dt||∞ > 1/2 (paso demasiado
+ *          largo para RK4 y para que P quepa en Q2.30)
+ */
+int density_prop_build(density_prop_t *prop, uint32_t dim, const cfixed_t *h,
+                       const cfixed_t *jumps, const fixed_t *rates, uint32_t n_jumps,
+                       fixed_t dt);
+
+/**
+ * Qubit del Lindblad Filter: H = ω/2·σ_z,
+ *   L_π = σ⁻ (colapso a |0>)  con Γ_π = φ²·Γ_φ
+ *   L_φ = σ_z (desfase)       con Γ_φ / 2
+ * Población: ρ_11 decae a Γ_π. Coherencia: ρ_01 gira a -ω y decae a Γ_π/2 + Γ_φ.
+ */
+int density_prop_qubit(density_prop_t *prop, fixed_t omega, fixed_t gamma_phi, fixed_t dt);
+
+// steps pasos sobre n_channels canales (Q16.16). La traza de cada canal se
+// conserva exactamente: la última población se reconstruye a partir de ella.
+void density_step_q16(const density_prop_t *prop, fixed_t *x, size_t stride,
+                      size_t n_channels, uint32_t steps);
+
+// Versión float (solo host). AVX2/FMA si el procesador lo soporta.
+void density_step_f32(const density_prop_t *prop, float *x, size_t stride,
+                      size_t n_channels, uint32_t steps);
+
+// Activa (1) o desactiva (0) los kernels AVX2 de density_step_f32 (tests).
+// Retorna el estado efectivo: 0 si el hardware no los soporta.
+int density_f32_set_simd(int enable);
+
+#endif // QCORE_DENSITY_H
@@ -0,0 +1,57 @@
+#ifndef QCORE_ENTROPY_H
+#define QCORE_ENTROPY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * POOL DE ENTROPÍA DEL QPU
+ *
+ * Cosecha: entropy_harvest() llena un anillo de ENTROPY_RING_WORDS palabras
+ * de 64 bits. Con hardware, cada palabra son dos lecturas de DATA_LATCH
+ * mezcladas con el tick (el jitter de la espera también es ruido); en modo
+ * simulación, un flujo splitmix64 sembrado por entropy_seed(). El bridge
+ * rellena el anillo mientras espera un colapso (bridge_wait_collapse), así
+ * que las lecturas MMIO ocurren en tiempo que ya estaba perdido.
+ *
+ * Servicio: un generador por contador, w_k = mix64(key + k·φ·2^64). Cada
+ * ENTROPY_RESEED_INTERVAL palabras la llave absorbe lo que haya en el anillo
+ * (key = mix64(key ^ r)). Los consumidores solo tocan memoria: con el
+ * anillo vacío el generador sigue con la llave actual (en simulación lo
+ * rellena del flujo sembrado).
+ *
+ * No reentrante: un solo hart (el bucle del kernel).
+ */
+
+#define ENTROPY_RING_WORDS      32
+#define ENTROPY_IDLE_BATCH      4    // Palabras cosechadas por espera del bridge
+#define ENTROPY_RESEED_INTERVAL 256  // Palabras de 64 bits entre rellaves
+#define ENTROPY_RESEED_WORDS    4    // Cosecha simulada por rellave con el anillo vacío
+#define ENTROPY_DEFAULT_SEED    0x51425247ULL
+
+// Reinicia generador, anillo y flujo simulado a partir de seed
+void entropy_seed(uint64_t seed);
+
+// Cosecha hasta max_words en el anillo (MMIO solo con hardware). Retorna las cosechadas.
+size_t entropy_harvest(size_t max_words);
+
+// Cosecha de fondo durante las esperas del bridge
+void entropy_idle_refill(void);
+
+// Palabras cosechadas aún sin absorber
+size_t entropy_available(void);
+
+// Rellaves hechas desde entropy_seed
+uint64_t entropy_reseeds(void);
+
+uint64_t entropy_next64(void);
+uint32_t entropy_next32(void);
+
+// Un bit (sirve 64 por palabra del generador)
+uint32_t entropy_bit(void);
+
+// n palabras de 32 bits en bloque
+void entropy_fill(uint32_t *out, size_t n);
+void entropy_fill64(uint64_t *out, size_t n);
+
+#endif // QCORE_ENTROPY_H
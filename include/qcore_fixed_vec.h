@@ -0,0 +1,90 @@
+#ifndef QCORE_FIXED_VEC_H
+#define QCORE_FIXED_VEC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "qcore_math.h"
+
+/**
+ * ARITMÉTICA Q16.16 SOBRE ARRAYS
+ *
+ * Kernels en bloque para el procesamiento masivo de señales. Cada función
+ * procesa n elementos con una sola llamada, sin el coste de invocar
+ * mult_q16/div_q16/fixed_cos por elemento.
+ *
+ * Backends (seleccionados en runtime en la primera llamada):
+ *   - FIXED_VEC_BACKEND_C    : C portable (siempre disponible)
+ *   - FIXED_VEC_BACKEND_AVX2 : x86-64 con AVX2 (libqcore.so en el host)
+ *   - FIXED_VEC_BACKEND_RVV  : RISC-V Vector 1.0 (smopsys.elf, vía misa)
+ *
+ * Todos los backends producen resultados bit a bit idénticos a las
+ * funciones escalares, salvo fixed_vec_div_scalar (ver abajo).
+ * Se permite out == a (in-place).
+ */
+
+typedef enum {
+    FIXED_VEC_BACKEND_C,
+    FIXED_VEC_BACKEND_AVX2,
+    FIXED_VEC_BACKEND_RVV
+} fixed_vec_backend_t;
+
+// Backend activo (detecta el hardware en la primera consulta)
+fixed_vec_backend_t fixed_vec_get_backend(void);
+
+// Fuerza un backend (benchmarks/tests). Retorna 0 si el hardware no lo soporta.
+int fixed_vec_set_backend(fixed_vec_backend_t backend);
+
+// out[i] = mult_q16(a[i], b[i])
+void fixed_vec_mul(fixed_t *out, const fixed_t *a, const fixed_t *b, size_t n);
+
+// out[i] = a[i] + b[i], saturado a [INT32_MIN, INT32_MAX]
+void fixed_vec_add_sat(fixed_t *out, const fixed_t *a, const fixed_t *b, size_t n);
+
+// out[i] = a[i] / d mediante un recíproco calculado una sola vez.
+// Difiere de div_q16(a[i], d) como máximo en 1 LSB mientras |resultado| < 2^30.
+// d == 0 satura igual que div_q16 (0x7FFFFFFF).
+void fixed_vec_div_scalar(fixed_t *out, const fixed_t *a, fixed_t d, size_t n);
+
+// out[i] = fixed_cos(angle[i])
+void fixed_vec_cos(fixed_t *out, const fixed_t *angle, size_t n);
+
+// Forma cuadrática 2x2 sobre arrays SoA: con d = (x[i] - c[0], y[i] - c[1]),
+// out[i] = dᵀ·M·d evaluada como calculate_mahalanobis_sq (mult_q16 y sumas
+// modulares, bit a bit idéntica). Retorna cuántos out[i] > threshold.
+size_t fixed_vec_quad_form2(fixed_t *out, const fixed_t *x, const fixed_t *y,
+                            const fixed_t c[2], const fixed_t m[2][2], fixed_t threshold, size_t n);
+
+// Variante transpuesta: un único punto (x, y) contra n juegos de parámetros
+// en SoA. params contiene 6 filas {cx, cy, m00, m01, m10, m11} de stride
+// elementos cada una; el carril i usa la columna i de todas ellas.
+void fixed_vec_quad_form2_lanes(fixed_t *out, fixed_t x, fixed_t y,
+                                const fixed_t *params, size_t stride, size_t n);
+
+// Iteración de Grover fusionada sobre amplitudes SoA (registro cuántico).
+// Oráculo: s[i] = (data[i] == target) ? -amp[i] : amp[i].
+// fixed_vec_grover_oracle_sum deja amp intacto; *sum = Σ s[i] en 64 bits
+// (exacta para cualquier n < 2^32) y retorna cuántos s[i] != 0: la media de
+// la difusión sin otra pasada.
+size_t fixed_vec_grover_oracle_sum(const fixed_t *amp, const int32_t *data, size_t n,
+                                   int32_t target, int64_t *sum);
+// Oráculo + inversión sobre la media en una pasada: amp[i] = s[i] != 0 ?
+// two_mean - s[i] : 0. Retorna además el oracle_sum del resultado (*sum y
+// activos), que alimenta la iteración siguiente.
+size_t fixed_vec_grover_step(fixed_t *amp, const int32_t *data, size_t n,
+                             int32_t target, fixed_t two_mean, int64_t *sum);
+
+// Visibilidad del Lindblad Filter por canal, como lindblad_update():
+// s = surprise[i] saturada a ±LINDBLAD_MAX_SURPRISE, f = s / MAX_SURPRISE por
+// recíproco y vis[i] = clamp(1 - f - penalización (majorana[i] == 1) o
+// + bonificación, 0, 1). Retorna cuántos vis[i] < FERMIONIC_THRESHOLD.
+size_t fixed_vec_lindblad_visibility(fixed_t *vis, const fixed_t *surprise,
+                                     const uint8_t *majorana, size_t n);
+
+// buf[i] ^= key (cifrado de fase de qcore_security): palabras de 64 bits en C,
+// líneas de caché completas en AVX2 y strip-mining en RVV
+void fixed_vec_xor_key(uint32_t *buf, size_t n, uint32_t key);
+
+// out[i] = calculate_golden_operator(n0 + i), i = 0..count-1
+void fixed_vec_golden(fixed_t *out, int32_t n0, size_t count);
+
+#endif // QCORE_FIXED_VEC_H
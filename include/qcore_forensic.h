@@ -0,0 +1,72 @@
+#ifndef QCORE_FORENSIC_H
+#define QCORE_FORENSIC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "qcore_port.h"
+#include "qcore_math.h"
+
+/**
+ * CAJA NEGRA FORENSE
+ *
+ * Anillo de FORENSIC_LOG_RECORDS registros en FORENSIC_MEM_ADDR (fuera de
+ * la RAM que borra la Singularidad; en el host, un buffer estático).
+ *
+ * Escritura wait-free: cada escritor reserva su registro con un único
+ * fetch_add sobre head y lo rellena sin esperar a nadie, así que se puede
+ * registrar desde el heartbeat, desde otro hart o desde un trap que
+ * interrumpa a otro escritor. Cada registro lleva su número de secuencia
+ * (n + 1) como sello. El escritor toma el registro con un CAS del sello a
+ * FORENSIC_SEQ_WRITING, escribe los campos y publica n + 1: un lector
+ * descarta los registros a medio escribir o ya sobrescritos por la
+ * siguiente vuelta del anillo.
+ * Solo el dueño del sello escribe los campos. Si el registro está en manos
+ * de otro escritor (uno de hace una vuelta que se quedó parado) o ya tiene
+ * un sello más reciente, el registro nuevo se descarta en vez de mezclar
+ * campos de dos escritores.
+ *
+ * El formato es fijo (little-endian) para que tools/forensic_decode.py lo
+ * lea de un volcado de memoria.
+ */
+
+#define FORENSIC_LOG_MAGIC   0x464C4F47 // "FLOG"
+#define FORENSIC_LOG_RECORDS 64         // Potencia de 2
+#define FORENSIC_SEQ_WRITING 0xFFFFFFFFu // Sello de un registro a medio escribir
+
+typedef struct {
+    uint64_t tick;        // get_hardware_tick()
+    int32_t surprise;     // Q16.16
+    uint32_t cycle;       // Heartbeat en el que se registró
+    uint32_t seq;         // n + 1; 0 = vacío, FORENSIC_SEQ_WRITING = a medio escribir
+    uint8_t majorana;     // majorana_byte_t.raw
+    uint8_t state;        // security_state_t
+    uint16_t reserved;
+} forensic_record_t;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t record_size;
+    uint16_t capacity;
+    uint64_t head;        // Registros escritos desde el formateo
+    forensic_record_t rec[FORENSIC_LOG_RECORDS];
+} forensic_log_t;
+
+// Región del anillo (FORENSIC_MEM_ADDR en hardware)
+forensic_log_t* forensic_log_region(void);
+
+// Formatea la región si no contiene un anillo válido; si lo contiene, lo
+// conserva (los registros sobreviven a un reinicio en caliente).
+void forensic_log_init(void);
+
+// Vacía el anillo incondicionalmente
+void forensic_log_reset(void);
+
+// Añade un registro (wait-free una vez formateado el anillo: sin
+// forensic_log_init previo, el primer registro lo formatea). Retorna su n;
+// si se descartó (ver arriba), forensic_log_read(n) lo indica con -1.
+uint64_t forensic_log_append(fixed_t surprise, majorana_byte_t q_state, uint8_t state, uint32_t cycle);
+
+// Copia el registro n. Retorna 0, o -1 si ya se sobrescribió o aún se escribe.
+int forensic_log_read(uint64_t n, forensic_record_t *out);
+
+#endif // QCORE_FORENSIC_H
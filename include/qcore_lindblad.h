@@ -2,6 +2,7 @@
 #define QCORE_LINDBLAD_H
 
 #include <stdint.h>
+#include <stddef.h>
 #include "qcore_math.h"
 
 /**
@@ -39,6 +40,17 @@
 // Ratio Áureo al cuadrado (Γ_π / Γ_φ) en Q16.16
 #define PHI_SQUARED_FIXED 0x00029E3A  // φ² ≈ 2.618
 
+// Modulación de la visibilidad (lindblad_update y lindblad_bank_update)
+#define LINDBLAD_MAX_SURPRISE 393216        // MAX_ENTROPY_TOLERANCE = 6.0
+// s / MAX_SURPRISE en Q16.16 = |s| / 6 = |s|·⌈2^34/6⌉ >> 34 (exacto para
+// |s| < 2^32): el recíproco sustituye a div_q16 y da el mismo resultado
+#define LINDBLAD_SURPRISE_RECIP 0xAAAAAAABu
+#define LINDBLAD_SURPRISE_SHIFT 34
+#define LINDBLAD_COLLAPSE_PENALTY 0x00001999 // -10% si majorana_state == 1
+#define LINDBLAD_COHERENCE_BONUS 0x00000CCC  // +5% en otro caso
+// Si visibility_score < 0.3, consideramos el estado como Fermiónico
+#define FERMIONIC_THRESHOLD 0x00004CCC       // 0.3 en Q16.16
+
 // Estructura de estado del Lindblad Filter
 typedef struct {
     fixed_t bf_axis;           // Eje Bosónico-Fermiónico [-1, +1]
@@ -46,6 +58,7 @@ typedef struct {
     uint32_t cycle_count;      // Contador de ciclos para oscilación
     fixed_t gamma_pi;          // Tasa de decoherencia Polaridad
     fixed_t gamma_phi;         // Tasa de decoherencia Laminar
+    golden_seq_t golden;       // Generador incremental de O_n (n = cycle_count)
 } LindblادState;
 
 /**
@@ -69,6 +82,14 @@ void lindblad_init(LindblادState* state);
  */
 void lindblad_update(LindblادState* state, fixed_t surprise, uint8_t majorana_state);
 
+/**
+ * Aplica lindblad_update() a una ráfaga de n ciclos (bridge_tick_sync_batch)
+ *
+ * @return: Ciclos de la ráfaga que terminaron en modo Fermiónico (launder)
+ */
+uint32_t lindblad_update_batch(LindblادState* state, const fixed_t* surprise,
+                               const uint8_t* majorana_state, size_t n);
+
 /**
  * Calcula el factor de atenuación para la información
  * 
@@ -85,4 +106,36 @@ fixed_t lindblad_get_visibility(const LindblادState* state);
  */
 int lindblad_should_launder(const LindblادState* state);
 
+/**
+ * BANCO DE FILTROS (un canal por electrodo MEA o por puerto QPU)
+ *
+ * Todos los canales avanzan el mismo ciclo n en cada llamada. bf_axis = O_n
+ * solo depende de n, así que es común al banco y sale de un acumulador de
+ * fase de 64 bits (πφn en ángulo binario, más la paridad de n): una suma y
+ * un coseno por llamada, sin deriva. La visibilidad de cada canal se
+ * calcula en SoA con fixed_vec_lindblad_visibility (C/AVX2/RVV).
+ * cycle_count es de 64 bits como el acumulador, así que n no se desborda;
+ * bf_axis coincide bit a bit con calculate_golden_operator(n) mientras n
+ * cabe en su argumento (n <= INT32_MAX).
+ */
+typedef struct {
+    uint32_t n_channels;
+    uint64_t cycle_count;      // n común a todos los canales
+    uint64_t phase;            // frac(n·φ/2)·2^64: ángulo binario de cos(πφn)
+    fixed_t bf_axis;           // O_n del ciclo actual
+    fixed_t gamma_pi;
+    fixed_t gamma_phi;
+    fixed_t *visibility;       // n_channels elementos, memoria del llamador
+} lindblad_bank_t;
+
+// Banco en estado Bosónico sobre visibility[0..n_channels-1]
+void lindblad_bank_init(lindblad_bank_t *bank, fixed_t *visibility, uint32_t n_channels);
+
+// Un ciclo para todos los canales: surprise[c] y majorana_state[c] del canal c.
+// Cada canal queda igual que con lindblad_update(). Retorna cuántos lavar.
+uint32_t lindblad_bank_update(lindblad_bank_t *bank, const fixed_t *surprise,
+                              const uint8_t *majorana_state);
+
+int lindblad_bank_should_launder(const lindblad_bank_t *bank, uint32_t channel);
+
 #endif // QCORE_LINDBLAD_H
@@ -7,6 +7,12 @@
 #define PHI 0x00019E37      // 1.618033... en punto fijo
 #define PI_FIXED 0x0003243F // 3.14159... en punto fijo
 
+// 2^32 / (2π) con 16 bits fraccionarios: radianes Q16.16 -> ángulo binario
+#define FIXED_RAD_TO_BAM_Q16 683565276LL
+
+// frac(φ/2) · 2^64: avance del ángulo binario de cos(πφn) por cada n
+#define GOLDEN_HALF_TURN_BAM64 0xCF1BBCDCBFA53E0BULL
+
 typedef int32_t fixed_t;
 
 // Lagrangian components structure per Rule 3.1
@@ -20,13 +26,68 @@ fixed_t int_to_fixed(int32_t i);
 fixed_t fixed_to_int(fixed_t f);
 fixed_t mult_q16(fixed_t a, fixed_t b);
 fixed_t div_q16(fixed_t a, fixed_t b);
+fixed_t fixed_sqrt(fixed_t x);       // sqrt(x), 0 si x <= 0
+uint32_t isqrt_u64(uint64_t v);      // floor(sqrt(v)) entero
+fixed_t fixed_exp_neg(fixed_t x);    // e^-x, 1.0 si x <= 0
 fixed_t fixed_cos(fixed_t angle);
+fixed_t fixed_sin(fixed_t angle);
+
+// Ángulo binario (BAM): 2^32 = un giro completo. Reducción en O(1).
+uint32_t fixed_to_bam(fixed_t angle);
+fixed_t fixed_cos_bam(uint32_t bam);
+fixed_t fixed_sin_bam(uint32_t bam);
+
+// Tabla de cuarto de onda Q2.30 (generada en build-time, ver tools/gen_sintab.c)
+#define QCORE_SINTAB_BITS 8
+#define QCORE_SINTAB_FRAC_BITS (30 - QCORE_SINTAB_BITS)
+extern const int32_t qcore_sintab_q30[(1 << QCORE_SINTAB_BITS) + 2];
+
+// Núcleo de seno sobre ángulo binario en Q2.30, compartido por fixed_sin_bam
+// y los kernels de arrays: simetría de cuadrante + interpolación lineal.
+// Sin bucles ni ramas dependientes del ángulo salvo el espejo/signo.
+static inline int32_t qcore_sin_bam_q30(uint32_t bam) {
+    uint32_t quadrant = bam >> 30;
+    uint32_t q = bam & 0x3FFFFFFF;
+    if (quadrant & 1) q = 0x40000000 - q; // Espejo en cuadrantes II y IV
+
+    uint32_t idx = q >> QCORE_SINTAB_FRAC_BITS;
+    int64_t frac = (int64_t)(q & ((1u << QCORE_SINTAB_FRAC_BITS) - 1u));
+    int64_t y0 = qcore_sintab_q30[idx];
+    int64_t y1 = qcore_sintab_q30[idx + 1];
+    int32_t v = (int32_t)(y0 + (((y1 - y0) * frac) >> QCORE_SINTAB_FRAC_BITS));
+
+    return (quadrant & 2) ? -v : v;
+}
+
+// Q2.30 -> Q16.16 con redondeo
+static inline fixed_t qcore_q30_to_fixed(int32_t v) {
+    return (fixed_t)(((int64_t)v + (1 << 13)) >> 14);
+}
 
 #define FIX_MUL(a, b) mult_q16(a, b)
 #define FIX_DIV(a, b) div_q16(a, b)
 
 // Core Physics Functions
 fixed_t calculate_golden_operator(int32_t n);
+
+// Iterador incremental de O_n: O(1) por paso, sin evaluar cosenos.
+// Se re-siembra desde el ángulo exacto cada GOLDEN_SEQ_RENORM_PERIOD pasos.
+#define GOLDEN_SEQ_RENORM_PERIOD 64
+
+typedef struct {
+    int32_t n;             // Índice actual de la secuencia
+    int32_t cos_q30;       // cos(πφn) en Q2.30
+    int32_t sin_q30;       // sin(πφn) en Q2.30
+    uint32_t since_renorm; // Pasos desde la última renormalización
+} golden_seq_t;
+
+// Inicializador estático equivalente a golden_seq_init(seq, 0)
+#define GOLDEN_SEQ_ORIGIN { 0, 0x40000000, 0, 0 }
+
+void golden_seq_init(golden_seq_t *seq, int32_t n0);
+fixed_t golden_seq_value(const golden_seq_t *seq);   // O_n actual
+fixed_t golden_seq_next(golden_seq_t *seq);          // Avanza a n+1, retorna O_{n+1}
+fixed_t golden_seq_seek(golden_seq_t *seq, int32_t n); // O(1) si n es n o n+1
 LagrangianState compute_lagrangian(fixed_t u, fixed_t v);
 
 #endif // QCORE_MATH_H
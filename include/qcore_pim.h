@@ -2,6 +2,7 @@
 #define QCORE_PIM_H
 
 #include <stdint.h>
+#include "qcore_arch.h"
 
 typedef struct {
     float weight;      // El "peso" neuronal (Memoria)
@@ -10,6 +11,7 @@ typedef struct {
 } LaminarCell;
 
 #define TENSOR_BASE_N 4448
+#define PIM_ENTROPY_THRESHOLD 1.618033f // Debe coincidir con entropy_threshold (qcore_pim_asm.S)
 #define VIRTUAL_NEURON_TARGET 88000000000ULL
 
 /* The 88B virtual neurons are projected from these 3 physical vectors */
@@ -22,8 +24,41 @@ LaminarCell pim_tensor_y[TENSOR_BASE_N];
 extern __attribute__((section(".smop_laminar_mem"), aligned(4096)))
 LaminarCell pim_tensor_z[TENSOR_BASE_N];
 
-// Rutina de actualización Bayesiana-Neuronal (RISC-V Assembly)
-// fa0: Golden Prior (float)
+// Rutina de actualización Bayesiana-Neuronal:
+//   weight ← (golden_prior · weight · probability) / φ
+// En el kernel despacha a kernel/qcore_pim_asm.S (RVV si misa tiene 'V',
+// escalar si no; ver allí la diferencia de ULP entre ambas).
 extern void smopsys_bayesian_update(LaminarCell* core, uint32_t count, float golden_prior);
 
+// Elige la implementación al arrancar (antes del primer update)
+void pim_init(void);
+
+#if defined(ARCH_RISCV) && !defined(QCORE_TEST_ENV)
+// fa0: Golden Prior (float)
+extern void smopsys_bayesian_update_scalar(LaminarCell* core, uint32_t count, float golden_prior);
+extern void smopsys_bayesian_update_rvv(LaminarCell* core, uint32_t count, float golden_prior);
+#endif
+
+// --- Host (solo libqcore.so, kernel/qcore_pim_host.c) ---
+// Misma semántica que la versión escalar en ensamblador, bit a bit.
+// smopsys_bayesian_update usa AVX2 si el procesador lo soporta.
+#define PIM_MAX_THREADS 64
+// Celdas mínimas por hilo: crear y esperar un hilo cuesta ~19 µs y una
+// celda ~3 ns, así que un hilo necesita ~100 µs de trabajo para compensar.
+// Los tres tensores de TENSOR_BASE_N (13344 celdas) van en serie.
+#define PIM_PARALLEL_MIN_CELLS 32768
+
+void smopsys_bayesian_update_c(LaminarCell* core, uint32_t count, float golden_prior);
+// AVX2 (8 celdas por iteración); C si no hay soporte
+void smopsys_bayesian_update_avx2(LaminarCell* core, uint32_t count, float golden_prior);
+
+// Activa (1) o desactiva (0) AVX2 (tests). Retorna el estado efectivo.
+int pim_set_simd(int enable);
+
+// Actualiza n_tensors tensores de count celdas repartiendo el espacio
+// tensor × celda en rangos contiguos entre n_threads hilos (0 = uno por
+// CPU en línea). Retorna los hilos usados.
+uint32_t pim_update_tensors(LaminarCell *const *tensors, uint32_t n_tensors, uint32_t count,
+                            float golden_prior, uint32_t n_threads);
+
 #endif // QCORE_PIM_H
@@ -2,6 +2,7 @@
 #define QCORE_PORT_H
 
 #include <stdint.h>
+#include <stddef.h>
 
 // --- Phase 1: Physical Interface Definition ---
 
@@ -13,12 +14,20 @@
 #define CMD_CALIBRATE     0x02
 #define CMD_PREPARE_STATE 0x04
 #define CMD_MEASURE       0x08
+#define CMD_PREPARE_BATCH 0x10 // Colapsa BATCH_COUNT trayectorias de BATCH_WINDOW
 
 // Status Bits (STATUS_REG)
 #define STATUS_READY            0x01 // QPU Ready for commands
 #define STATUS_TEMP_OK          0x02 // Superconducting temp reached (mK)
 #define STATUS_DATA_READY       0x04 // Collapse complete, data valid
 #define STATUS_DECOHERENCE_WARN 0x08 // Warning: State degrading
+#define STATUS_BATCH_CAPABLE    0x10 // QPU implements CMD_PREPARE_BATCH
+
+// Batch Window: el CPU escribe K fases empaquetadas (4 por palabra, byte 0
+// en los bits 0-7), emite CMD_PREPARE_BATCH y el QPU las colapsa seguidas;
+// DATA_READY indica que la ventana contiene los K bytes colapsados.
+#define QPORT_BATCH_MAX   32
+#define QPORT_BATCH_WORDS (QPORT_BATCH_MAX / 4)
 
 // Register Map Structure
 // Must be packed or aligned to 32-bit words as per hardware spec
@@ -28,6 +37,9 @@ typedef struct {
     volatile uint32_t STATUS_REG;  // 0x08: Read-Only Status
     volatile uint32_t DATA_LATCH;  // 0x0C: Read/Write Majorana Byte
     volatile uint32_t PHASE_LOCK;  // 0x10: Read-Only Cycle Counter
+    volatile uint32_t BATCH_COUNT; // 0x14: Write-Only Trayectorias en la ventana (1..QPORT_BATCH_MAX)
+    volatile uint32_t RESERVED[2]; // 0x18
+    volatile uint32_t BATCH_WINDOW[QPORT_BATCH_WORDS]; // 0x20: Bytes de Majorana empaquetados (LE)
 } quantum_port_t;
 
 // Majorana Topological Byte
@@ -40,10 +52,16 @@ typedef union {
     } topology;
 } majorana_byte_t;
 
+// Board Windows: cada placa QPU expone su quantum_port_t en una ventana de
+// 4 KiB consecutiva a partir de QPORT_BASE_ADDR (placa 0 = QPORT).
+#define QPORT_MAX_BOARDS    4
+#define QPORT_BOARD_STRIDE  0x1000
+#define QPORT_MMIO_SIZE     (QPORT_MAX_BOARDS * QPORT_BOARD_STRIDE)
+
 // Base Address Configuration
 #ifdef QCORE_TEST_ENV
     // In Test Environment, we map to a static buffer to avoid SegFault
-    extern uint8_t mock_mmio_buffer[1024];
+    extern uint8_t mock_mmio_buffer[QPORT_MMIO_SIZE];
     #define QPORT_BASE_ADDR ((uintptr_t)mock_mmio_buffer)
 #else
     // Production: Physical Address
@@ -51,11 +69,116 @@ typedef union {
 #endif
 
 // Pointer Accessor
-#define QPORT ((quantum_port_t *)QPORT_BASE_ADDR)
+#define QPORT_AT(board) ((quantum_port_t *)(QPORT_BASE_ADDR + (uintptr_t)(board) * QPORT_BOARD_STRIDE))
+#define QPORT QPORT_AT(0)
+
+// Command Write
+// En hardware, el QPU acepta el comando y baja DATA_READY en la misma
+// transacción del bus. En el host (emulador en otro hilo) esa parte se
+// emula aquí para que la CPU nunca lea un DATA_READY del colapso anterior.
+#ifdef QCORE_TEST_ENV
+#include "qcore_trap.h"
+// Línea PLIC del colapso de la placa detrás de port (QPORT_COLLAPSE_IRQ + placa)
+static inline uint32_t qport_collapse_irq(const quantum_port_t *port) {
+    return QPORT_COLLAPSE_IRQ + (uint32_t)(((uintptr_t)port - QPORT_BASE_ADDR) / QPORT_BOARD_STRIDE);
+}
+#endif
+
+static inline void qport_command_at(quantum_port_t *port, uint32_t cmd) {
+#ifdef QCORE_TEST_ENV
+    __atomic_fetch_and(&port->STATUS_REG, ~(uint32_t)STATUS_DATA_READY, __ATOMIC_SEQ_CST);
+    trap_host_set_irq_line(qport_collapse_irq(port), 0);
+    __atomic_store_n(&port->CONTROL_REG, cmd, __ATOMIC_SEQ_CST);
+#else
+    port->CONTROL_REG = cmd;
+#endif
+}
+
+static inline void qport_command(uint32_t cmd) {
+    qport_command_at(QPORT, cmd);
+}
 
 // --- Public API Prototypes ---
 extern int g_simulation_mode;
 void qport_handshake(void);
 void bridge_tick_sync(majorana_byte_t *cycle);
 
+// Fuente de colapsos del modo simulación: recibe la trayectoria (bits 0-6)
+// y retorna majorana_state (0/1). NULL = un bit del pool de entropía (por defecto).
+typedef uint8_t (*bridge_sim_source_t)(uint8_t phase);
+void bridge_set_sim_source(bridge_sim_source_t source);
+
+// --- Phase 4: Asynchronous Pipeline ---
+// El QPU tiene un solo latch: como mucho un colapso en vuelo en el hardware y
+// el resto de propuestas esperan en una cola FIFO de software. Cada colapso
+// recogido lanza inmediatamente la siguiente propuesta, así que el QPU trabaja
+// en el ciclo N+1 mientras la CPU juzga el ciclo N.
+// No mezclar con bridge_tick_sync() mientras haya propuestas en la cola.
+#define BRIDGE_QUEUE_DEPTH 4
+
+// Encola una trayectoria de fase (bits 0-6). Retorna 0, o -1 si la cola está llena.
+int bridge_submit(uint8_t phase);
+// Avanza el pipeline sin bloquear. Retorna cuántos colapsos esperan a bridge_complete().
+int bridge_poll(void);
+// Retira el colapso más antiguo (espera si aún no llegó). Retorna 0, o -1 si la cola está vacía.
+int bridge_complete(majorana_byte_t *cycle);
+// Propuestas encoladas aún no retiradas
+uint32_t bridge_inflight(void);
+
+// --- Phase 5: Batched Transactions ---
+// Colapsa cycles[0..n-1] en ráfagas de hasta QPORT_BATCH_MAX: un solo
+// handshake por ráfaga. Sin STATUS_BATCH_CAPABLE cae a bridge_tick_sync().
+// No mezclar con la cola asíncrona mientras haya propuestas en vuelo.
+void bridge_tick_sync_batch(majorana_byte_t *cycles, size_t n);
+// Separa una ráfaga en arrays para las etapas en bloque
+// (calculate_mahalanobis_sq_batch, lindblad_update_batch)
+void bridge_batch_unpack(const majorana_byte_t *cycles, int32_t *phase, int32_t *collapse,
+                         uint8_t *majorana_state, size_t n);
+
+// --- Phase 6: Multi-QPU Fan-out / Fan-in ---
+// Tabla de placas descubiertas por firma. Cada placa tiene su propia
+// calibración (PHASE_LOCK de referencia) y una cola corta de propuestas con
+// un solo colapso en vuelo; las propuestas se reparten entre placas y los
+// colapsos se recogen en el orden en que terminan, identificados por tag.
+// Independiente del pipeline de la Phase 4 (que solo usa la placa 0).
+#define QPORT_BOARD_DEPTH 4
+
+typedef enum {
+    QPORT_DISPATCH_ROUND_ROBIN,   // Siguiente placa con hueco
+    QPORT_DISPATCH_LEAST_LOADED   // Placa con menos propuestas pendientes
+} qport_dispatch_t;
+
+typedef struct {
+    uint32_t tag;            // Retornado por qport_table_submit()
+    uint32_t board;          // Índice físico de la placa (ventana MMIO)
+    majorana_byte_t cycle;   // Byte colapsado
+} qport_result_t;
+
+// Sondea las QPORT_MAX_BOARDS ventanas, calibra en paralelo las que tienen
+// firma y activa su IRQ de colapso (QPORT_COLLAPSE_IRQ + placa).
+// Retorna el número de placas en línea.
+uint32_t qport_table_discover(void);
+uint32_t qport_table_boards(void);
+void qport_table_set_policy(qport_dispatch_t policy);
+// PHASE_LOCK de la placa al calibrarse (fase cero propia de cada QPU)
+uint32_t qport_table_phase_zero(uint32_t board);
+// Reparte una trayectoria (bits 0-6). Retorna 0 y *tag, o -1 si todas las colas están llenas.
+int qport_table_submit(uint8_t phase, uint32_t *tag);
+// Recoge sin bloquear hasta max colapsos terminados, en cualquier orden
+size_t qport_table_gather(qport_result_t *out, size_t max);
+// Espera al primer colapso que termine. Retorna 0, o -1 si no hay nada en vuelo.
+int qport_table_complete(qport_result_t *out);
+uint32_t qport_table_inflight(void);
+
+// Trabajo a ejecutar cuando la espera de un colapso pasa de spin a wfi
+typedef void (*bridge_idle_hook_t)(void);
+void bridge_set_idle_hook(bridge_idle_hook_t hook);
+
+// ISR del colapso de la placa 0 (QPORT_COLLAPSE_IRQ): marca la llegada con la
+// que bridge_wait_collapse calibra su ventana de spin. qport_table_discover()
+// la reutiliza para la placa 0 en vez de sustituirla.
+void bridge_collapse_isr(uint32_t irq);
+// Ventana de spin actual en ticks (BRIDGE_SPIN_DEFAULT_TICKS tras el handshake)
+uint64_t bridge_spin_window(void);
+
 #endif // QCORE_PORT_H
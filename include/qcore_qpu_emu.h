@@ -0,0 +1,54 @@
+#ifndef QCORE_QPU_EMU_H
+#define QCORE_QPU_EMU_H
+
+#include <stdint.h>
+
+/**
+ * EMULADOR DE QPU (solo host, libqcore.so)
+ *
+ * Un hilo por placa que responde detrás de su quantum_port_t de memoria
+ * compartida (mock_mmio_buffer) como lo haría el hardware: atiende CMD_RESET,
+ * CMD_CALIBRATE, CMD_PREPARE_STATE, CMD_PREPARE_BATCH y CMD_MEASURE, avanza PHASE_LOCK en
+ * cada colapso y contesta con latencia y sesgo configurables. Así el
+ * camino real de qport_handshake()/bridge_tick_sync()/bridge_complete()
+ * se puede cargar y medir en Linux.
+ */
+
+typedef enum {
+    QPU_EMU_LATENCY_FIXED,       // Siempre mean_ns
+    QPU_EMU_LATENCY_UNIFORM,     // Uniforme en [mean_ns - spread_ns, mean_ns + spread_ns]
+    QPU_EMU_LATENCY_EXPONENTIAL  // spread_ns + Exp(mean_ns - spread_ns): cola larga
+} qpu_emu_latency_t;
+
+typedef struct {
+    qpu_emu_latency_t latency_dist;
+    uint64_t mean_ns;         // Latencia media de un colapso
+    uint64_t spread_ns;       // Dispersión (UNIFORM) o mínimo (EXPONENTIAL)
+    uint64_t calibrate_ns;    // Tiempo hasta STATUS_TEMP_OK tras CMD_CALIBRATE
+    uint32_t collapse_bias;   // P(majorana_state = 1) en Q16.16
+    uint32_t seed;            // Semilla del generador (0 = fija por defecto)
+    uint32_t no_batch;        // 1 = no anunciar STATUS_BATCH_CAPABLE (QPU antiguo)
+} qpu_emu_config_t;
+
+typedef struct {
+    uint64_t commands;        // Comandos atendidos
+    uint64_t collapses;       // CMD_PREPARE_STATE completados
+    uint64_t measures;        // CMD_MEASURE completados
+    uint64_t batches;         // CMD_PREPARE_BATCH completados
+    uint64_t ones;            // Colapsos con bit 7 = 1
+    uint64_t busy_ns;         // Tiempo total simulando latencia
+} qpu_emu_stats_t;
+
+// Arranca el hilo del emulador (MAGIC_SIG y STATUS_READY visibles al volver).
+// Retorna 0, o -1 si ya estaba en marcha o no se pudo crear el hilo.
+int qpu_emu_start(const qpu_emu_config_t *config);
+// Detiene todas las placas y deja los puertos como un QPU ausente (todo a 0)
+void qpu_emu_stop(void);
+void qpu_emu_get_stats(qpu_emu_stats_t *stats);
+
+// Varias placas: un hilo por ventana QPORT_AT(board) (qpu_emu_start = placa 0)
+int qpu_emu_start_board(uint32_t board, const qpu_emu_config_t *config);
+void qpu_emu_stop_board(uint32_t board);
+void qpu_emu_get_stats_board(uint32_t board, qpu_emu_stats_t *stats);
+
+#endif // QCORE_QPU_EMU_H
@@ -2,33 +2,96 @@
 #define QCORE_QUANTUM_H
 
 #include <stdint.h>
+#include <stddef.h>
 #include "qcore_math.h"
 
-// Number of simulated qubits/states for the associative memory
-#define QUANTUM_MEMORY_SIZE 64 
+// Number of simulated qubits/states for the default associative memory
+// (el registro de la API clásica; se puede redefinir con -DQUANTUM_MEMORY_SIZE=...).
+// Memorias mayores se crean en runtime con quantum_register_create().
+#ifndef QUANTUM_MEMORY_SIZE
+#define QUANTUM_MEMORY_SIZE 64
+#endif
 
-// Represents a single quantum state in the superposition
-typedef struct {
-    fixed_t amplitude_real; // Real component of the wave function
-    fixed_t amplitude_imag; // Imaginary component
-    int32_t data;           // The actual data value "stored" in this basis state
-} QuantumBasisState;
+// Clases de desalojo: una lista por potencia de 2 de |amplitud|
+#define QUANTUM_AMP_CLASSES 32
+
+#define QUANTUM_SLOT_NONE 0xFFFFFFFFu
 
 // The full quantum register
+// Estados base en SoA: el oráculo y la difusión recorren amplitude_real y
+// data como arrays contiguos (kernels fixed_vec_grover_* en AVX2/RVV).
+// Todos los arrays viven en la arena que pasa quantum_register_create().
 typedef struct {
-    QuantumBasisState states[QUANTUM_MEMORY_SIZE];
+    uint32_t capacity;          // Estados base
+    uint32_t index_mask;        // Cubetas del índice - 1 (potencia de 2 >= 2·capacity)
+
+    fixed_t *amplitude_real;    // Real component of the wave function
+    fixed_t *amplitude_imag;    // Imaginary component
+    int32_t *data;              // The actual data value "stored" in each basis state
     fixed_t global_phase;
-    fixed_t coherence_residue; // For passing to wetware
+    fixed_t coherence_residue;  // For passing to wetware
+
+    // Índice de datos escritos (slot + 1; 0 = cubeta vacía), sondeo lineal
+    // con factor de carga <= 1/2. Las fugas de vacío no se indexan.
+    uint32_t *index;
+
+    // Slots vacíos (amplitude_real == 0) como pila; free_pos permite sacar
+    // un slot concreto (la fuga al vecino) en O(1).
+    uint32_t *free_stack;
+    uint32_t *free_pos;
+    uint32_t free_count;
+
+    // Slots activos encadenados por clase floor(log2|amplitud|). El desalojo
+    // toma la clase más baja no vacía del bitmap: O(1), y el estado
+    // expulsado está a menos de un factor 2 del mínimo |amplitud| real.
+    uint32_t class_head[QUANTUM_AMP_CLASSES];
+    uint32_t *class_next;
+    uint32_t *class_prev;
+    uint8_t *slot_class;
+    uint32_t class_bitmap;
+
+    // Estadísticos incrementales (sumas exactas en 64 bits): la media de la
+    // difusión y el número de marcados M salen de aquí sin recorrer el registro.
+    uint32_t active;            // Estados con amplitude_real != 0 (N)
+    int64_t amp_sum;            // Σ amplitude_real
+    uint32_t zero_active;       // Activos con data == 0 (fugas y el dato 0)
+    int64_t zero_sum;
+    uint32_t last_iterations;   // Iteraciones de Grover de la última lectura
+
+    // Las amplitudes cambiaron en bloque (Grover): la próxima escritura
+    // reconstruye listas e índice.
+    uint32_t dirty;
 } QuantumRegister;
 
-// Public API
+// Cota superior de quantum_register_footprint(cap) evaluable en compilación
+// (arenas estáticas): cabecera, 8 arrays alineados a 64 bytes e índice <= 4·cap.
+#define QUANTUM_REGISTER_BYTES(cap) \
+    (sizeof(QuantumRegister) + 64 * 11 + (size_t)(cap) * (7 * 4 + 1 + 16))
+
+// Registros de tamaño arbitrario sobre memoria del llamador (sin heap)
+// Bytes de arena necesarios para capacity estados
+size_t quantum_register_footprint(uint32_t capacity);
+// Crea un registro vacío en arena. NULL si capacity es 0, > 2^30 o la arena es pequeña.
+QuantumRegister *quantum_register_create(void *arena, size_t arena_size, uint32_t capacity);
+void quantum_register_clear(QuantumRegister *reg);
+void quantum_register_write(QuantumRegister *reg, int32_t data);          // O(1)
+int32_t quantum_register_read(QuantumRegister *reg, int32_t search_target); // Grover adaptativo
+// Slot que guarda data, o -1 si no está en el registro
+int32_t quantum_register_slot_of(QuantumRegister *reg, int32_t data);
+
+// ⌊π/4·√(N/M)⌋ iteraciones para M marcados entre N activos; 0 si M == 0 o
+// M >= N/2 (con θ >= π/4 ninguna iteración mejora la medida)
+uint32_t quantum_grover_iterations(uint32_t n_active, uint32_t m_marked);
+
+// Public API (registro por defecto de QUANTUM_MEMORY_SIZE estados)
 void init_quantum_register(void);
-void write_superposition(int32_t data);
+void write_superposition(int32_t data);  // O(1): índice hash + lista libre
 int32_t read_quantum_register(int32_t search_target); // Returns best match via Grover
 fixed_t get_quantum_residue(void);
 
 // Internal helper exposed for testing
 void apply_grover_oracle(int32_t target);
 void apply_diffusion_operator(void);
+int32_t quantum_slot_of(int32_t data);
 
 #endif // QCORE_QUANTUM_H
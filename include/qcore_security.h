@@ -18,6 +18,9 @@ typedef enum {
     SINGULARITY       // Autodestrucción en progreso
 } security_state_t;
 
+// Línea de caché en palabras: unidad del cifrado incremental
+#define SECURITY_CRYPT_LINE_WORDS 16
+
 // --- API Pública ---
 void apply_phase_encryption(uint32_t* buffer, size_t size, majorana_byte_t q_state);
 void write_forensic_log(fixed_t surprise, majorana_byte_t last_q);
@@ -25,4 +28,36 @@ void trigger_singularity(void);
 void security_heartbeat(uint32_t* main_buffer, size_t size, fixed_t surprise, majorana_byte_t q_state);
 security_state_t get_security_state(void);
 
+/**
+ * Hibernación por páginas e incremental
+ *
+ * El buffer del heartbeat se divide en páginas de SECURITY_PAGE_WORDS
+ * palabras (más grandes si no caben en SECURITY_MAX_PAGES). Cada página
+ * guarda su llave y cuántas palabras de su prefijo están cifradas.
+ *   - LAMINAR → HIBERNATION: fija la llave del colapso y lanza una pasada
+ *     que cifra las páginas en claro. Una anomalía sostenida solo continúa
+ *     esa pasada; terminada, el heartbeat no toca el buffer (O(1)).
+ *   - Condensación: el estado vuelve a LAMINAR_ACTIVE en el acto.
+ *     security_access() descifra las páginas que se tocan y los heartbeats
+ *     siguientes descifran el resto, cada página con su propia llave
+ *     (una hibernación nueva respeta las páginas aún cifradas).
+ *
+ * Cada heartbeat cifra o descifra como mucho lines_per_heartbeat líneas de
+ * caché (SECURITY_CRYPT_LINE_WORDS palabras), así que la latencia por ciclo
+ * está acotada y el buffer queda cubierto en
+ * ceil(size / (SECURITY_CRYPT_LINE_WORDS · lines)) ciclos.
+ * lines_per_heartbeat = 0 (por defecto): la pasada completa en un ciclo.
+ */
+#define SECURITY_PAGE_WORDS 1024   // 4 KiB
+#define SECURITY_MAX_PAGES 1024
+
+void security_set_crypt_budget(size_t lines_per_heartbeat);
+// Palabras del buffer cifradas ahora mismo
+size_t security_crypt_progress(void);
+size_t security_encrypted_pages(void);
+
+// Acceso a [offset, offset+count) del buffer del heartbeat tras descifrar
+// las páginas que toca. NULL en HIBERNATION/SINGULARITY o fuera de rango.
+uint32_t* security_access(size_t offset, size_t count);
+
 #endif // QCORE_SECURITY_H
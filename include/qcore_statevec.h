@@ -0,0 +1,92 @@
+#ifndef QCORE_STATEVEC_H
+#define QCORE_STATEVEC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * SIMULADOR DE VECTOR DE ESTADO (solo host, libqcore.so)
+ *
+ * 2^n amplitudes complejas en float, en SoA (re[], im[]) alineadas a 64
+ * bytes. Q16.16 no sirve aquí: con n qubits la amplitud típica es 2^(-n/2)
+ * y a partir de ~20 qubits cae por debajo del LSB.
+ *
+ * Kernels:
+ *   - Puertas de 1 qubit (H, X, Z, fase) y CNOT como matriz 2x2 con
+ *     máscara de control. Qubits >= 3: pares (i, i + 2^t) en carriles AVX2
+ *     contiguos. Qubits 0..2: la pareja vive en el mismo vector y se
+ *     combina con una permutación en registro.
+ *   - Bloqueo de caché: una racha de puertas sobre qubits < SV_BLOCK_QUBITS
+ *     se aplica bloque a bloque (2^SV_BLOCK_QUBITS amplitudes = 64 KiB), así
+ *     cada bloque se lee de memoria una vez para toda la racha.
+ *   - Oráculo (fase -1 sobre un estado base) y difusión 2|s><s| - I.
+ *   - Cada pasada se reparte entre n_threads hilos persistentes por rangos disjuntos.
+ *
+ * Con 28 qubits el vector ocupa 2 GiB.
+ */
+
+#define SV_MAX_QUBITS 30
+#define SV_BLOCK_QUBITS 13
+#define SV_MAX_THREADS 64
+
+typedef enum {
+    SV_GATE_H,
+    SV_GATE_X,
+    SV_GATE_Z,
+    SV_GATE_PHASE,  // diag(1, e^{iθ})
+    SV_GATE_CNOT    // X sobre target si control = 1
+} sv_gate_type_t;
+
+typedef struct {
+    sv_gate_type_t type;
+    uint32_t target;
+    uint32_t control;   // Solo SV_GATE_CNOT
+    float theta;        // Solo SV_GATE_PHASE (radianes)
+} sv_gate_t;
+
+typedef struct {
+    uint32_t n_qubits;
+    uint32_t n_threads;
+    uint64_t dim;       // 2^n_qubits
+    float *re;
+    float *im;
+    uint64_t rng;       // Muestreo de medidas (splitmix64)
+    void *pool;         // Hilos persistentes (privado, se crea en la primera pasada paralela)
+} statevec_t;
+
+// Reserva el vector en |0...0>. n_threads = 0: un hilo por CPU en línea.
+// NULL si n_qubits > SV_MAX_QUBITS o no hay memoria.
+statevec_t *statevec_create(uint32_t n_qubits, uint32_t n_threads, uint64_t seed);
+void statevec_destroy(statevec_t *sv);
+void statevec_reset(statevec_t *sv);       // |0...0>
+void statevec_uniform(statevec_t *sv);     // H^n |0...0> sin aplicar n puertas
+
+// Aplica gates[0..n-1] en orden, agrupando las rachas de qubits bajos por bloques.
+// Las puertas con target/control >= n_qubits o CNOT con control == target son no-op.
+void statevec_apply(statevec_t *sv, const sv_gate_t *gates, size_t n);
+void statevec_h(statevec_t *sv, uint32_t target);
+void statevec_x(statevec_t *sv, uint32_t target);
+void statevec_z(statevec_t *sv, uint32_t target);
+void statevec_phase(statevec_t *sv, uint32_t target, float theta);
+void statevec_cnot(statevec_t *sv, uint32_t control, uint32_t target);
+
+// Grover: fase -1 sobre |marked>; inversión de todas las amplitudes sobre la media
+void statevec_oracle(statevec_t *sv, uint64_t marked);
+void statevec_diffusion(statevec_t *sv);
+// Estado uniforme + iterations rondas de oráculo y difusión
+void statevec_grover(statevec_t *sv, uint64_t marked, uint32_t iterations);
+
+// P(qubit = 1); 0 si qubit >= n_qubits
+double statevec_prob_one(const statevec_t *sv, uint32_t qubit);
+// Mide qubit: colapsa y renormaliza. Retorna 0 o 1 (0 sin tocar el estado
+// si qubit >= n_qubits).
+uint32_t statevec_measure(statevec_t *sv, uint32_t qubit);
+// Muestrea un estado base según |amp|² sin colapsar
+uint64_t statevec_sample(statevec_t *sv);
+
+// Colapsos del bridge en modo simulación: cada tick aplica H·P(2π·fase/128)·H
+// sobre qubit y lo mide, así majorana_state sigue la estadística real
+// (P(cambio) = sin²(θ/2)). sv = NULL vuelve al generador pseudoaleatorio.
+void statevec_attach_bridge(statevec_t *sv, uint32_t qubit);
+
+#endif // QCORE_STATEVEC_H
@@ -0,0 +1,120 @@
+#ifndef QCORE_TRAP_H
+#define QCORE_TRAP_H
+
+#include <stdint.h>
+#include "qcore_arch.h"
+
+// --- Mapa de Interrupciones (QEMU virt / SoC de referencia) ---
+#define PLIC_BASE_ADDR      0x0C000000UL
+#define CLINT_BASE_ADDR     0x02000000UL
+#define PLIC_MAX_IRQ        64
+#define QPORT_COLLAPSE_IRQ  12 // Línea PLIC del evento DATA_READY del puerto MMQI
+
+// Registros del PLIC (contexto 0 = hart 0 en M-mode)
+#define PLIC_PRIORITY(irq)  (PLIC_BASE_ADDR + 4UL * (irq))
+#define PLIC_ENABLE(word)   (PLIC_BASE_ADDR + 0x2000UL + 4UL * (word))
+#define PLIC_THRESHOLD      (PLIC_BASE_ADDR + 0x200000UL)
+#define PLIC_CLAIM          (PLIC_BASE_ADDR + 0x200004UL)
+
+// Registros del CLINT (hart 0)
+#define CLINT_MSIP          (CLINT_BASE_ADDR + 0x0000UL)
+#define CLINT_MTIMECMP      (CLINT_BASE_ADDR + 0x4000UL)
+#define CLINT_MTIME         (CLINT_BASE_ADDR + 0xBFF8UL)
+#define CLINT_MSIP_HART(h)  (CLINT_BASE_ADDR + 4UL * (h)) // IPI a cualquier hart
+
+// mcause / mie / mstatus
+#define MCAUSE_INTERRUPT    (1UL << 63)
+#define IRQ_M_SOFT          3
+#define IRQ_M_TIMER         7
+#define IRQ_M_EXT           11
+#define EXC_LOAD_ACCESS_FAULT 5
+#define MSTATUS_MIE         0x8UL
+
+// Contexto que guarda trap_vector (kernel/entry.S): x0..x31, mepc, mstatus
+// y los registros FP que no preserva el ABI. trap_handler puede modificar
+// regs[] y mepc; se restauran antes del mret.
+// Los manejadores corren con mstatus.VS = Off: no pueden usar RVV (ni
+// llamar a fixed_vec_* / smopsys_bayesian_update), porque v0-v31 no se guardan.
+typedef struct {
+    uint64_t regs[32];
+    uint64_t mepc;
+    uint64_t mstatus;
+    uint64_t fregs[20];     // ft0-ft7, fa0-fa7, ft8-ft11 (f0-f7, f10-f17, f28-f31)
+    uint64_t fcsr;
+    uint64_t reserved;      // Pila alineada a 16 bytes
+} trap_frame_t;
+
+#define TRAP_FRAME_SIZE 448 // Debe coincidir con kernel/entry.S
+
+typedef void (*irq_handler_t)(uint32_t irq);
+
+#if defined(ARCH_RISCV) && !defined(QCORE_TEST_ENV)
+
+// Rutas PLIC a cero, MEIE y MIE activos (el timer solo se arma bajo demanda)
+void trap_init(void);
+void trap_handler(trap_frame_t *frame);
+void trap_register_irq(uint32_t irq, irq_handler_t handler);
+
+void plic_enable_irq(uint32_t irq);
+void plic_disable_irq(uint32_t irq);
+
+// Timer de un solo disparo: despierta un wfi tras delta_ticks de mtime
+void clint_arm_timer(uint64_t delta_ticks);
+void clint_disarm_timer(void);
+
+static inline unsigned long trap_irq_disable(void) {
+    unsigned long prev;
+    __asm__ volatile ("csrrci %0, mstatus, 8" : "=r" (prev) :: "memory");
+    return prev;
+}
+
+static inline void trap_irq_restore(unsigned long prev) {
+    if (prev & MSTATUS_MIE) __asm__ volatile ("csrsi mstatus, 8" ::: "memory");
+}
+
+// Abre MIE un instante para atender lo que esté pendiente
+static inline void trap_irq_window(void) {
+    __asm__ volatile ("csrsi mstatus, 8\n\tcsrci mstatus, 8" ::: "memory");
+}
+
+// wfi despierta con cualquier interrupción pendiente en mie, aunque MIE = 0
+static inline void trap_wfi(void) {
+    __asm__ volatile ("wfi" ::: "memory");
+}
+
+#else
+
+// Host (libqcore.so): no hay traps; wfi equivale a ceder la CPU al resto de hilos
+#ifdef QCORE_TEST_ENV
+#include <sched.h>
+
+// PLIC emulado (kernel/qcore_trap_host.c): trap_irq_window() ejecuta los
+// manejadores de las fuentes habilitadas con la línea activa
+void trap_register_irq(uint32_t irq, irq_handler_t handler);
+void plic_enable_irq(uint32_t irq);
+void plic_disable_irq(uint32_t irq);
+void trap_irq_window(void);
+// Nivel de la línea irq (lo mueve el emulador de QPU con DATA_READY)
+void trap_host_set_irq_line(uint32_t irq, int level);
+#else
+static inline void trap_register_irq(uint32_t irq, irq_handler_t handler) { (void)irq; (void)handler; }
+static inline void plic_enable_irq(uint32_t irq) { (void)irq; }
+static inline void plic_disable_irq(uint32_t irq) { (void)irq; }
+static inline void trap_irq_window(void) {}
+#endif
+static inline void trap_init(void) {}
+static inline void clint_arm_timer(uint64_t delta_ticks) { (void)delta_ticks; }
+static inline void clint_disarm_timer(void) {}
+static inline unsigned long trap_irq_disable(void) { return 0; }
+static inline void trap_irq_restore(unsigned long prev) { (void)prev; }
+static inline void trap_wfi(void) {
+#ifdef QCORE_TEST_ENV
+    sched_yield();
+#else
+    cpu_relax_yield();
+#endif
+}
+
+#endif
+
+#endif // QCORE_TRAP_H
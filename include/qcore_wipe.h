@@ -0,0 +1,95 @@
+#ifndef QCORE_WIPE_H
+#define QCORE_WIPE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "qcore_arch.h"
+
+/**
+ * MOTOR DE BORRADO DE LA SINGULARIDAD
+ *
+ * Sobrescribe una lista de regiones (en orden de prioridad) con un flujo de
+ * clave derivado de un pool pequeño de entropía del QPU, sin una lectura
+ * MMIO por palabra:
+ *
+ *   w_i = mix64(pool[i mod WIPE_POOL_WORDS] + i·φ·2^64)
+ *
+ * donde i es el índice de palabra de 64 bits dentro del trabajo y mix64 el
+ * finalizador de splitmix64. Al depender solo de i, cada hart genera su
+ * parte sin estado compartido.
+ *
+ * Las regiones se dividen en trozos de WIPE_CHUNK_BYTES que los workers
+ * (harts en el kernel, hilos en los tests) reclaman con un contador
+ * atómico. El orden de reclamo es el de las regiones, así que la región 0
+ * (.smop_laminar_mem en trigger_singularity) la borran todos los harts a la
+ * vez antes de pasar a la siguiente. Un hart que no arranca no deja huecos:
+ * sus trozos los toman los demás.
+ * Cada trozo se escribe por líneas de caché completas (8 stores de 64 bits).
+ */
+
+#define WIPE_POOL_WORDS 8
+#define WIPE_MAX_REGIONS 6
+#define WIPE_CHUNK_BYTES (256 * 1024)
+#define WIPE_MAX_HARTS 8             // Debe coincidir con kernel/entry.S
+#define WIPE_STACK_RESERVE 1024      // Bajo sp: marcos de wipe_run_all_harts y sus llamados
+
+typedef struct {
+    uintptr_t start;                // Alineados a 8 bytes
+    uintptr_t end;
+    uint64_t first_chunk;           // Índice global del primer trozo
+    uint64_t n_chunks;
+    uint64_t first_word;            // Índice global de su primera palabra
+} wipe_region_t;
+
+typedef struct {
+    wipe_region_t region[WIPE_MAX_REGIONS];
+    uint32_t n_regions;
+    uint64_t total_chunks;
+    uint64_t total_bytes;
+    uint64_t pool[WIPE_POOL_WORDS];
+
+    // Progreso (acceso atómico)
+    uint64_t next_chunk;            // Siguiente trozo sin reclamar
+    uint64_t chunks_done;
+    uint64_t bytes_done;
+    uint64_t region_chunks_done[WIPE_MAX_REGIONS];
+    uint64_t tick_start;
+    uint64_t tick_first_region;     // get_hardware_tick() al terminar la región 0
+    uint64_t tick_end;
+} wipe_job_t;
+
+// Trabajo vacío. pool = NULL: cosecha WIPE_POOL_WORDS palabras de DATA_LATCH.
+void wipe_job_init(wipe_job_t *job, const uint64_t *pool);
+
+// Añade [start, end) recortado a 8 bytes. Retorna -1 si no caben más regiones.
+int wipe_add_region(wipe_job_t *job, uintptr_t start, uintptr_t end);
+
+// Pila [bottom, top) salvo la ventana viva [live_lo, live_hi): añade hasta
+// dos regiones. Retorna -1 si no caben.
+int wipe_add_stack(wipe_job_t *job, uintptr_t bottom, uintptr_t top, uintptr_t live_lo, uintptr_t live_hi);
+
+// Reclama y borra trozos hasta agotarlos. Cualquier número de workers
+// concurrentes. Retorna los trozos que borró este worker.
+uint64_t wipe_run_worker(wipe_job_t *job);
+
+// Bytes ya sobrescritos (trozos completos)
+uint64_t wipe_progress(const wipe_job_t *job);
+int wipe_done(const wipe_job_t *job);
+
+// Palabra i del flujo de clave (referencia para tests y forense)
+uint64_t wipe_keystream_word(const wipe_job_t *job, uint64_t i);
+
+// Harts secundarios registrados y aparcados (0 en el host)
+uint32_t wipe_harts_online(void);
+
+// Reparte el trabajo entre todos los harts aparcados, participa y espera a
+// que termine. En el host solo trabaja el hilo llamante.
+void wipe_run_all_harts(wipe_job_t *job);
+
+#if defined(ARCH_RISCV) && !defined(QCORE_TEST_ENV)
+// entry.S salta aquí con mhartid != 0: se registra, duerme en wfi hasta
+// recibir un trabajo por IPI (CLINT MSIP) y no vuelve.
+void hart_secondary_main(uint64_t hartid);
+#endif
+
+#endif // QCORE_WIPE_H
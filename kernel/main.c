@@ -6,12 +6,15 @@
 #include "../include/qcore_bayes.h"
 #include "../include/qcore_port.h"
 #include "../include/qcore_security.h"
+#include "../include/qcore_forensic.h"
+#include "../include/qcore_entropy.h"
 #include "../include/qcore_lindblad.h"
 #include "../include/qcore_uart.h"
 #include "../include/qcore_pim.h"
 #include "../include/qcore_viz.h"
 #include "../include/qcore_topology.h"
 #include "../include/qcore_phase.h"
+#include "../include/qcore_trap.h"
 
 // Umbral de Sorpresa (Chi-Cuadrado > 6.0 en Q16.16)
 // Si la distancia de Mahalanobis supera esto, disipamos energía.
@@ -19,9 +22,10 @@
 
 // Setup básico de arquitectura (GDT/IDT para x86 o CSR para RISC-V)
 void setup_hardware_arch(void) {
-    // En Bare-Metal real, aquí configuramos la tabla de vectores
-    // para manejar excepciones, pero NO habilitamos interrupciones de timer.
+    // mtvec ya apunta a trap_vector (entry.S). Habilitamos solo las rutas
+    // externas del PLIC (colapso del QPU); NO habilitamos interrupciones de timer.
     disable_interrupts(); 
+    trap_init();
 }
 
 // Inicializador mock del wetware si no está definido en bios_interface
@@ -65,11 +69,17 @@ void kernel_main(void) {
 
     // 1. Configuración de Arquitectura Clásica
     setup_hardware_arch();
+    forensic_log_init(); // Conserva los incidentes previos a un reinicio en caliente
+    pim_init();          // Actualización PIM: RVV o escalar según misa
 
     // 2. Handshake con el Hardware Cuántico (MMQI)
     // El sistema se congelará aquí si el QPU no responde (Safety First).
     qport_handshake();
-    
+
+    // Pool de entropía: primera cosecha fuera del camino caliente
+    entropy_seed(get_hardware_tick());
+    entropy_harvest(ENTROPY_RING_WORDS);
+
     // 3. Inicialización de Subsistemas
     wetware_init(); // Prepara MEA (Canales Iónicos)
     
@@ -101,6 +111,7 @@ void kernel_main(void) {
     float current_entropy = 1.0f;
     PhaseState p_breath;
     phase_init(&p_breath);
+    golden_seq_t breath_seq = GOLDEN_SEQ_ORIGIN;
 
     // Bucle de estabilización visual (Matrix effect)
     while(current_entropy > 0.05f) {
@@ -109,8 +120,8 @@ void kernel_main(void) {
 
         // 2. Monitoreo del "Aliento Pentagonal"
         // Simulamos innovación basada en el latido del sistema
-        static int tick = 0;
-        fixed_t innovation = calculate_golden_operator(tick++);
+        fixed_t innovation = golden_seq_value(&breath_seq);
+        golden_seq_next(&breath_seq);
         if (phase_update_pentagonal(&p_breath, innovation)) {
             uart_puts(ANSI_COLOR_CYAN " [ BREATH: RESIDUE SYNC ] " ANSI_COLOR_RESET);
         }
@@ -159,20 +170,25 @@ void kernel_main(void) {
     // ========================================================================
     // BUCLE INFINITO (Sin Sleep Clásico)
     // ========================================================================
+    // Cebamos el pipeline: el QPU ya trabaja en el primer ciclo
+    bridge_submit((uint8_t)metriplectic_scheduler_get_next_phase());
+
     while (1) {
         
         // --- FASE A: PROPUESTA (The Question) ---
         // El Scheduler determina la trayectoria de fase ideal (0-6)
-        // basada en la dinámica interna actual.
-        q_cycle.topology.phase_trajectory = metriplectic_scheduler_get_next_phase();
-        phase_val_raw = q_cycle.topology.phase_trajectory; // Mock capture
+        // basada en la dinámica interna actual. Se encola el ciclo N+1
+        // mientras el ciclo N sigue en el QPU.
+        bridge_submit((uint8_t)metriplectic_scheduler_get_next_phase());
         
         // --- FASE B: COLAPSO (The Answer) ---
-        // Aquí ocurre la magia. La CPU se detiene (Stall/WFI) dentro de esta función.
-        // Solo retorna cuando el hardware cuántico ha colapsado la función de onda.
+        // Aquí ocurre la magia. La CPU se detiene (Stall/WFI) hasta que el
+        // hardware cuántico colapsa el ciclo N; al recogerlo, el ciclo N+1
+        // se lanza y colapsa mientras juzgamos este.
         // El QPU escribe el bit 7 (majorana_state).
-        bridge_tick_sync(&q_cycle);
-        collapse_val_raw = q_cycle.topology.majorana_state; // Mock capture
+        bridge_complete(&q_cycle);
+        phase_val_raw = q_cycle.topology.phase_trajectory;
+        collapse_val_raw = q_cycle.topology.majorana_state;
 
         
         // --- FASE C: OBSERVACIÓN (The Judgement) ---
@@ -180,8 +196,11 @@ void kernel_main(void) {
         fixed_t phase_val = int_to_fixed(phase_val_raw);
         fixed_t collapse_val = int_to_fixed(collapse_val_raw); // 0 o 1 (Fixed)
 
-        // Calculamos qué tan "rara" fue esta respuesta del QPU
-        int32_t surprise = calculate_mahalanobis_sq(&attractor, phase_val, collapse_val);
+        // Calculamos qué tan "rara" fue esta respuesta del QPU.
+        // (fase, colapso) caben en un byte: la D^2 sale de la caché del
+        // atractor salvo que haya aprendido desde la última vez.
+        uint8_t judgement_key = (uint8_t)((phase_val_raw & 0x7F) | (collapse_val_raw << 7));
+        int32_t surprise = calculate_surprise_cached(&attractor, judgement_key);
 
         
         // --- FASE C.5: LINDBLAD FILTER (The Launderer) ---
@@ -241,6 +260,7 @@ void kernel_main(void) {
         smopsys_bayesian_update(pim_tensor_z, TENSOR_BASE_N, golden_prior);
         
         // El ciclo termina. Inmediatamente volvemos a proponer y esperar.
-        // La velocidad del bucle depende puramente de la latencia del QPU.
+        // Con el pipeline, la velocidad del bucle tiende a la cadencia del QPU
+        // en lugar de latencia del QPU + trabajo de la CPU.
     }
 }
@@ -1,4 +1,5 @@
 #include "../include/qcore_bayes.h"
+#include "../include/qcore_fixed_vec.h"
 
 // Constante de aprendizaje (Alpha). Digamos 0.05 en Q16.16
 #define ALPHA 3276  // ~0.05 * 65536
@@ -19,19 +20,31 @@ void init_bayesian_attractor(bayesian_attractor_t *attractor) {
     attractor->inv_cov[0][1] = 0;
     attractor->inv_cov[1][0] = 0;
     attractor->inv_cov[1][1] = 0x00010000;
+
+    attractor->cache_hits = 0;
+    attractor->cache_misses = 0;
+    invalidate_surprise_cache(attractor);
 }
 
-// 1. Actualización de la Covarianza (Manual)
-void update_belief(bayesian_attractor_t *attractor, int32_t input_phase, int32_t input_entropy) {
+void invalidate_surprise_cache(bayesian_attractor_t *attractor) {
+    for (int i = 0; i < SURPRISE_CACHE_SIZE / 32; i++) {
+        attractor->cache_valid[i] = 0;
+    }
+}
+
+// EMA de (mu, Σ) y Σ^-1 recalculada. Compartida por el atractor y los
+// componentes del banco, que no llevan caché de sorpresa.
+static void ema_update_moments(int32_t mu[2], int32_t cov[2][2], int32_t inv_cov[2][2],
+                               int32_t input_phase, int32_t input_entropy, int32_t alpha) {
     int32_t x[2] = {input_phase, input_entropy};
     int32_t diff[2];
 
     // --- Paso A: Actualizar Media (EMA) ---
     // mu_new = mu_old + alpha * (x - mu_old)
     for(int i=0; i<2; i++) {
-        diff[i] = x[i] - attractor->mu[i];
+        diff[i] = x[i] - mu[i];
         // mu += alpha * diff
-        attractor->mu[i] += FIX_MUL(ALPHA, diff[i]);
+        mu[i] += FIX_MUL(alpha, diff[i]);
     }
 
     // --- Paso B: Actualizar Covarianza ---
@@ -40,28 +53,28 @@ void update_belief(bayesian_attractor_t *attractor, int32_t input_phase, int32_t
     
     // Recalculamos diff con la NUEVA media para mayor estabilidad (Welford-like but EMA)
     int32_t diff_new[2];
-    for(int i=0; i<2; i++) diff_new[i] = x[i] - attractor->mu[i];
+    for(int i=0; i<2; i++) diff_new[i] = x[i] - mu[i];
 
     // Actualización manual elemento por elemento
     // Sigma_00 (Varianza Fase)
     int32_t term_00 = FIX_MUL(diff[0], diff_new[0]); 
-    attractor->cov[0][0] += FIX_MUL(ALPHA, (term_00 - attractor->cov[0][0]));
+    cov[0][0] += FIX_MUL(alpha, (term_00 - cov[0][0]));
 
     // Sigma_11 (Varianza Entropía)
     int32_t term_11 = FIX_MUL(diff[1], diff_new[1]); 
-    attractor->cov[1][1] += FIX_MUL(ALPHA, (term_11 - attractor->cov[1][1]));
+    cov[1][1] += FIX_MUL(alpha, (term_11 - cov[1][1]));
 
     // Sigma_01 y 10 (Covarianza cruzada)
     int32_t term_01 = FIX_MUL(diff[0], diff_new[1]);
-    int32_t update_cov = FIX_MUL(ALPHA, (term_01 - attractor->cov[0][1]));
-    attractor->cov[0][1] += update_cov;
-    attractor->cov[1][0] = attractor->cov[0][1]; // Simetría
+    int32_t update_cov = FIX_MUL(alpha, (term_01 - cov[0][1]));
+    cov[0][1] += update_cov;
+    cov[1][0] = cov[0][1]; // Simetría
 
     // --- Paso C: Invertir Matriz (Determinante y Adjunta) ---
-    int32_t a = attractor->cov[0][0];
-    int32_t b = attractor->cov[0][1];
-    int32_t c = attractor->cov[1][0];
-    int32_t d = attractor->cov[1][1];
+    int32_t a = cov[0][0];
+    int32_t b = cov[0][1];
+    int32_t c = cov[1][0];
+    int32_t d = cov[1][1];
 
     // Det = ad - bc
     int32_t det = FIX_MUL(a, d) - FIX_MUL(b, c);
@@ -73,10 +86,23 @@ void update_belief(bayesian_attractor_t *attractor, int32_t input_phase, int32_t
 
     // Matriz Inversa: (1/det) * [d, -b; -c, a]
     // Nota: FIX_DIV(NUM, DEN) maneja el escalado Q16.16
-    attractor->inv_cov[0][0] = FIX_DIV(d, det);
-    attractor->inv_cov[0][1] = FIX_DIV(-b, det);
-    attractor->inv_cov[1][0] = FIX_DIV(-c, det);
-    attractor->inv_cov[1][1] = FIX_DIV(a, det);
+    inv_cov[0][0] = FIX_DIV(d, det);
+    inv_cov[0][1] = FIX_DIV(-b, det);
+    inv_cov[1][0] = FIX_DIV(-c, det);
+    inv_cov[1][1] = FIX_DIV(a, det);
+}
+
+// 1. Actualización de la Covarianza (Manual)
+void update_belief(bayesian_attractor_t *attractor, int32_t input_phase, int32_t input_entropy) {
+    update_belief_weighted(attractor, input_phase, input_entropy, ALPHA);
+}
+
+void update_belief_weighted(bayesian_attractor_t *attractor, int32_t input_phase, int32_t input_entropy,
+                            int32_t alpha) {
+    ema_update_moments(attractor->mu, attractor->cov, attractor->inv_cov, input_phase, input_entropy, alpha);
+
+    // El atractor cambió: las sorpresas memorizadas ya no valen
+    invalidate_surprise_cache(attractor);
 }
 
 // 2. Cálculo de Distancia de Mahalanobis (Al cuadrado)
@@ -102,3 +128,259 @@ int32_t calculate_mahalanobis_sq(bayesian_attractor_t *attractor, int32_t input_
 
     return d_squared; // Retornamos distancia al cuadrado para evitar sqrt()
 }
+
+// 2b. D^2 en lote: la forma cuadrática 2x2 vectorizada de qcore_fixed_vec
+void calculate_mahalanobis_sq_batch(const bayesian_attractor_t *attractor, const int32_t *phase,
+                                    const int32_t *entropy, int32_t *out, size_t n) {
+    fixed_vec_quad_form2(out, phase, entropy, attractor->mu, attractor->inv_cov, INT32_MAX, n);
+}
+
+size_t calculate_mahalanobis_sq_batch_count(const bayesian_attractor_t *attractor, const int32_t *phase,
+                                            const int32_t *entropy, int32_t *out, size_t n,
+                                            int32_t threshold) {
+    return fixed_vec_quad_form2(out, phase, entropy, attractor->mu, attractor->inv_cov, threshold, n);
+}
+
+// 3. Sorpresa memorizada por byte de Majorana
+// Solo hay 256 combinaciones (fase, colapso) por estado del atractor, así que
+// cada D^2 se calcula una vez y se reutiliza hasta el siguiente update_belief().
+int32_t calculate_surprise_cached(bayesian_attractor_t *attractor, uint8_t majorana_raw) {
+    uint32_t word = majorana_raw >> 5;
+    uint32_t bit = 1u << (majorana_raw & 31);
+
+    if (attractor->cache_valid[word] & bit) {
+        attractor->cache_hits++;
+        return attractor->surprise_cache[majorana_raw];
+    }
+
+    attractor->cache_misses++;
+    int32_t phase = int_to_fixed(majorana_raw & 0x7F);
+    int32_t collapse = int_to_fixed(majorana_raw >> 7);
+    int32_t d_squared = calculate_mahalanobis_sq(attractor, phase, collapse);
+
+    attractor->surprise_cache[majorana_raw] = d_squared;
+    attractor->cache_valid[word] |= bit;
+    return d_squared;
+}
+
+// 4. Atractor N-dimensional
+// La EMA de update_belief() equivale a Σ' = (1 - α)(Σ + α·d·dᵀ) con d = x - mu_old.
+// Sobre el factor L eso es una actualización de rango 1 con v = sqrt(α)·d
+// (rotaciones de Givens columna a columna) seguida de un escalado por sqrt(1 - α).
+#define SQRT_ALPHA           14653  // sqrt(ALPHA) en Q16.16
+#define SQRT_ONE_MINUS_ALPHA 63877  // sqrt(1 - ALPHA) en Q16.16
+#define ND_MIN_SIGMA         0x100  // Suelo de L[k][k] (~0.004): evita la singularidad
+#define ND_Z_LIMIT           (1LL << 38)
+
+// |r| = sqrt(L[k][k]² + v[k]²) y las entradas rotadas pueden pasar de
+// INT32_MAX con entradas cerca del rango completo: se saturan en lugar de
+// envolver (una diagonal negativa rompería el factor)
+static inline int32_t nd_sat(int64_t a) {
+    if (a > INT32_MAX) return INT32_MAX;
+    if (a < -INT32_MAX) return -INT32_MAX;
+    return (int32_t)a;
+}
+
+void init_bayesian_attractor_nd(bayesian_attractor_nd_t *attractor, uint32_t dim) {
+    if (dim == 0) dim = 1;
+    if (dim > BAYES_ND_MAX_DIM) dim = BAYES_ND_MAX_DIM;
+    attractor->dim = dim;
+
+    for (uint32_t i = 0; i < BAYES_ND_MAX_DIM; i++) {
+        attractor->mu[i] = 0;
+        for (uint32_t j = 0; j < BAYES_ND_MAX_DIM; j++) {
+            attractor->chol[i][j] = (i == j) ? 0x00010000 : 0;
+        }
+        attractor->inv_diag[i] = 0x00010000;
+    }
+}
+
+void update_belief_nd(bayesian_attractor_nd_t *attractor, const int32_t *x) {
+    uint32_t n = attractor->dim;
+    int32_t v[BAYES_ND_MAX_DIM];
+
+    // --- Paso A: Media (EMA) y vector de actualización ---
+    for (uint32_t i = 0; i < n; i++) {
+        int32_t diff = x[i] - attractor->mu[i];
+        attractor->mu[i] += FIX_MUL(ALPHA, diff);
+        v[i] = FIX_MUL(SQRT_ALPHA, diff);
+    }
+
+    // --- Paso B: L·Lᵀ + v·vᵀ mediante rotaciones de Givens ---
+    // Cada rotación (c, s) en Q2.30 anula v[k] contra la diagonal L[k][k].
+    for (uint32_t k = 0; k < n; k++) {
+        int64_t lkk = attractor->chol[k][k];
+        int64_t vk = v[k];
+        if (vk == 0) continue;
+
+        int64_t r = isqrt_u64((uint64_t)(lkk * lkk) + (uint64_t)(vk * vk));
+        int64_t c = (lkk << 30) / r;
+        int64_t s = (vk << 30) / r;
+
+        // c y s salen de r sin saturar: la rotación sigue siendo ortogonal
+        attractor->chol[k][k] = nd_sat(r);
+        for (uint32_t i = k + 1; i < n; i++) {
+            int64_t lik = attractor->chol[i][k];
+            int64_t vi = v[i];
+            attractor->chol[i][k] = nd_sat((c * lik + s * vi) >> 30);
+            v[i] = nd_sat((c * vi - s * lik) >> 30);
+        }
+    }
+
+    // --- Paso C: Olvido (1 - α) y recíprocos de la diagonal ---
+    for (uint32_t i = 0; i < n; i++) {
+        for (uint32_t j = 0; j <= i; j++) {
+            attractor->chol[i][j] = FIX_MUL(SQRT_ONE_MINUS_ALPHA, attractor->chol[i][j]);
+        }
+        if (attractor->chol[i][i] < ND_MIN_SIGMA) attractor->chol[i][i] = ND_MIN_SIGMA;
+        attractor->inv_diag[i] = (int32_t)((1LL << 32) / attractor->chol[i][i]);
+    }
+}
+
+int32_t calculate_mahalanobis_sq_nd(const bayesian_attractor_nd_t *attractor, const int32_t *x) {
+    uint32_t n = attractor->dim;
+    int32_t z[BAYES_ND_MAX_DIM];
+    uint64_t d_squared = 0;
+
+    // L·z = (x - mu)  =>  D^2 = zᵀz
+    for (uint32_t i = 0; i < n; i++) {
+        int64_t acc = (int64_t)x[i] - attractor->mu[i];
+        for (uint32_t j = 0; j < i; j++) {
+            acc -= ((int64_t)attractor->chol[i][j] * z[j]) >> 16;
+        }
+        if (acc > ND_Z_LIMIT) acc = ND_Z_LIMIT;
+        if (acc < -ND_Z_LIMIT) acc = -ND_Z_LIMIT;
+
+        int64_t zi = (acc * attractor->inv_diag[i]) >> 16;
+        if (zi > INT32_MAX) zi = INT32_MAX;
+        if (zi < -INT32_MAX) zi = -INT32_MAX;
+        z[i] = (int32_t)zi;
+
+        d_squared += ((uint64_t)(zi * zi)) >> 16;
+    }
+
+    return d_squared > INT32_MAX ? INT32_MAX : (int32_t)d_squared;
+}
+
+// 5. Banco de atractores (mezcla online)
+#define BANK_ONE 0x00010000
+
+// Copia los parámetros de scoring del componente k al espejo SoA
+// (Σ^-1 solo vive allí: el componente guarda mu y Σ)
+static void bank_refresh(attractor_bank_t *bank, uint32_t k, int32_t inv_cov[2][2]) {
+    const bank_component_t *c = &bank->comp[k];
+    bank->soa[BANK_MU_PHASE][k] = c->mu[0];
+    bank->soa[BANK_MU_ENTROPY][k] = c->mu[1];
+    bank->soa[BANK_INV00][k] = inv_cov[0][0];
+    bank->soa[BANK_INV01][k] = inv_cov[0][1];
+    bank->soa[BANK_INV10][k] = inv_cov[1][0];
+    bank->soa[BANK_INV11][k] = inv_cov[1][1];
+
+    // Normalización gaussiana 1/sqrt(det Σ), con el mismo suelo que update_belief()
+    int32_t det = FIX_MUL(c->cov[0][0], c->cov[1][1]) - FIX_MUL(c->cov[0][1], c->cov[1][0]);
+    if (det < 10) det = 10;
+    bank->inv_sqrt_det[k] = FIX_DIV(BANK_ONE, fixed_sqrt(det));
+}
+
+// Componente k centrado en (phase, entropy) con Σ = I
+static void bank_reset_component(attractor_bank_t *bank, uint32_t k, int32_t phase, int32_t entropy) {
+    int32_t identity[2][2] = {{BANK_ONE, 0}, {0, BANK_ONE}};
+    bank_component_t *c = &bank->comp[k];
+    c->mu[0] = phase;
+    c->mu[1] = entropy;
+    c->cov[0][0] = BANK_ONE;
+    c->cov[0][1] = 0;
+    c->cov[1][0] = 0;
+    c->cov[1][1] = BANK_ONE;
+    bank_refresh(bank, k, identity);
+}
+
+// Nuevo componente centrado en la muestra; cede ALPHA de peso al resto
+static void bank_spawn(attractor_bank_t *bank, int32_t phase, int32_t entropy) {
+    uint32_t k = bank->active++;
+    for (uint32_t j = 0; j < k; j++) {
+        bank->weight[j] = FIX_MUL(BANK_ONE - ALPHA, bank->weight[j]);
+    }
+    bank->weight[k] = ALPHA;
+    bank_reset_component(bank, k, phase, entropy);
+}
+
+void attractor_bank_init(attractor_bank_t *bank, uint32_t capacity) {
+    if (capacity == 0) capacity = 1;
+    if (capacity > ATTRACTOR_BANK_MAX) capacity = ATTRACTOR_BANK_MAX;
+    bank->capacity = capacity;
+    bank->active = 1;
+
+    for (uint32_t k = 0; k < ATTRACTOR_BANK_MAX; k++) {
+        for (uint32_t r = 0; r < BANK_SOA_ROWS; r++) bank->soa[r][k] = 0;
+        bank->weight[k] = 0;
+        bank->inv_sqrt_det[k] = 0;
+        bank->d2[k] = 0;
+        bank->resp[k] = 0;
+    }
+
+    // El componente 0 es el atractor clásico (origen, Σ = I)
+    bank->weight[0] = BANK_ONE;
+    bank_reset_component(bank, 0, 0, 0);
+}
+
+void attractor_bank_score_range(attractor_bank_t *bank, int32_t phase, int32_t entropy,
+                                uint32_t k_begin, uint32_t k_end) {
+    if (k_end > bank->active) k_end = bank->active;
+    if (k_begin >= k_end) return;
+    fixed_vec_quad_form2_lanes(&bank->d2[k_begin], phase, entropy, &bank->soa[0][k_begin],
+                               ATTRACTOR_BANK_MAX, k_end - k_begin);
+}
+
+int32_t attractor_bank_finish_score(attractor_bank_t *bank) {
+    uint32_t n = bank->active;
+    uint32_t best = 0;
+    for (uint32_t k = 1; k < n; k++) {
+        if (bank->d2[k] < bank->d2[best]) best = k;
+    }
+    int32_t d2_min = bank->d2[best];
+
+    // r_k ∝ π_k · exp(-(D²_k - D²_min)/2) / sqrt(det Σ_k): restar el mínimo evita el underflow
+    int64_t sum = 0;
+    for (uint32_t k = 0; k < n; k++) {
+        int64_t half = ((int64_t)bank->d2[k] - d2_min) >> 1;
+        int32_t e = fixed_exp_neg(half > INT32_MAX ? INT32_MAX : (int32_t)half);
+        int32_t r = FIX_MUL(FIX_MUL(bank->weight[k], bank->inv_sqrt_det[k]), e);
+        bank->resp[k] = r;
+        sum += r;
+    }
+
+    if (sum <= 0 || sum > INT32_MAX) {
+        // Pesos degenerados: todo para el componente más cercano
+        for (uint32_t k = 0; k < n; k++) bank->resp[k] = (k == best) ? BANK_ONE : 0;
+    } else {
+        for (uint32_t k = 0; k < n; k++) bank->resp[k] = FIX_DIV(bank->resp[k], (int32_t)sum);
+    }
+    return d2_min;
+}
+
+int32_t attractor_bank_score(attractor_bank_t *bank, int32_t phase, int32_t entropy) {
+    attractor_bank_score_range(bank, phase, entropy, 0, bank->active);
+    return attractor_bank_finish_score(bank);
+}
+
+void attractor_bank_update(attractor_bank_t *bank, int32_t phase, int32_t entropy) {
+    int32_t d2_min = attractor_bank_score(bank, phase, entropy);
+
+    // Régimen nuevo: ningún componente lo explica y queda capacidad
+    if (d2_min > ATTRACTOR_BANK_SPAWN_D2 && bank->active < bank->capacity) {
+        bank_spawn(bank, phase, entropy);
+        return;
+    }
+
+    // Paso M online: π_k sigue a r_k y cada componente aprende con α·r_k
+    for (uint32_t k = 0; k < bank->active; k++) {
+        bank->weight[k] += FIX_MUL(ALPHA, bank->resp[k] - bank->weight[k]);
+
+        int32_t alpha_k = FIX_MUL(ALPHA, bank->resp[k]);
+        if (alpha_k == 0) continue; // Responsabilidad despreciable
+        int32_t inv_cov[2][2];
+        ema_update_moments(bank->comp[k].mu, bank->comp[k].cov, inv_cov, phase, entropy, alpha_k);
+        bank_refresh(bank, k, inv_cov);
+    }
+}
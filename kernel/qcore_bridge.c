@@ -1,13 +1,17 @@
 #include "../include/qcore_port.h"
 #include "../include/qcore_uart.h"
 #include "../include/qcore_viz.h"
+#include "../include/qcore_arch.h"
+#include "../include/qcore_trap.h"
+#include "../include/qcore_math.h"
+#include "../include/qcore_entropy.h"
 
 // Global flag for hardware presence
 int g_simulation_mode = 0;
 
 // Define the mock buffer if in test env
 #ifdef QCORE_TEST_ENV
-    uint8_t mock_mmio_buffer[1024] __attribute__((aligned(32)));;
+    uint8_t mock_mmio_buffer[QPORT_MMIO_SIZE] __attribute__((aligned(32)));
 #endif
 
 // Helper to relax CPU while waiting
@@ -24,6 +28,99 @@ static inline void cpu_relax(void) {
 // Global System Phase Zero (calibrated at boot)
 static uint32_t system_phase_zero = 0;
 
+// --- Espera adaptativa del colapso: spin y después wfi ---
+// Se hace spin durante una ventana igual al coste de ida y vuelta del
+// sueño (dormirse + despertar): política 2-competitiva, nunca se gasta más
+// del doble de lo óptimo. Si el colapso no llega, la hart cede el tiempo al
+// idle hook y duerme en wfi hasta la IRQ del QPU.
+// El timer del CLINT acota cada sueño por si se perdiera la interrupción.
+#define BRIDGE_SPIN_DEFAULT_TICKS 1024
+#define BRIDGE_SPIN_MIN_TICKS     64
+#define BRIDGE_SPIN_MAX_TICKS     65536
+#define BRIDGE_WAKE_TIMEOUT_TICKS 1000000
+
+static uint64_t spin_window_ticks = BRIDGE_SPIN_DEFAULT_TICKS;
+static volatile uint64_t collapse_irq_tick = 0;
+static volatile uint32_t collapse_irq_seen = 0;
+static bridge_idle_hook_t bridge_idle_hook = 0;
+static bridge_sim_source_t bridge_sim_source = 0;
+
+void bridge_set_idle_hook(bridge_idle_hook_t hook) {
+    bridge_idle_hook = hook;
+}
+
+void bridge_set_sim_source(bridge_sim_source_t source) {
+    bridge_sim_source = source;
+}
+
+// Colapso simulado: bit 7 de majorana_byte_t para la trayectoria phase
+static inline uint8_t sim_collapse(uint8_t phase) {
+    uint8_t bit = bridge_sim_source ? (uint8_t)(bridge_sim_source((uint8_t)(phase & 0x7F)) & 1)
+                                    : (uint8_t)entropy_bit();
+    return (uint8_t)(bit << 7);
+}
+
+// DATA_READY es de nivel: la fuente queda silenciada hasta la próxima espera
+void bridge_collapse_isr(uint32_t irq) {
+    plic_disable_irq(irq);
+    collapse_irq_tick = get_hardware_tick();
+    collapse_irq_seen = 1;
+}
+
+uint64_t bridge_spin_window(void) {
+    return spin_window_ticks;
+}
+
+static inline int collapse_ready(void) {
+    return (QPORT->STATUS_REG & STATUS_DATA_READY) != 0;
+}
+
+static void bridge_wait_collapse(void) {
+    // 1. Spin: los colapsos rápidos no pagan el sueño
+    uint64_t start = get_hardware_tick();
+    while (!collapse_ready()) {
+        if (get_hardware_tick() - start >= spin_window_ticks) break;
+        cpu_relax();
+    }
+    if (collapse_ready()) return;
+
+    // 2. Bloqueo: el tiempo de espera se cede a otro trabajo
+    // (primero, rellenar el pool de entropía con ruido del latch)
+    entropy_idle_refill();
+    if (bridge_idle_hook) bridge_idle_hook();
+
+    // Con MIE apagado entre la comprobación y el wfi no se pierde la IRQ:
+    // wfi despierta igualmente y la ventana de MIE ejecuta el ISR.
+    uint64_t block_start = get_hardware_tick();
+    uint64_t sleep_cost = 0;
+    int slept = 0;
+    unsigned long flags = trap_irq_disable();
+    collapse_irq_seen = 0;
+    while (!collapse_ready()) {
+        plic_enable_irq(QPORT_COLLAPSE_IRQ);
+        clint_arm_timer(BRIDGE_WAKE_TIMEOUT_TICKS);
+        if (!slept) {
+            sleep_cost = get_hardware_tick() - block_start;  // Coste de dormirse
+            slept = 1;
+        }
+        trap_wfi();
+        trap_irq_window();
+    }
+    plic_disable_irq(QPORT_COLLAPSE_IRQ);
+    clint_disarm_timer();
+    trap_irq_restore(flags);
+
+    // 3. Calibración: la ventana sigue (EMA 1/4) al coste de ida y vuelta,
+    // dormirse más despertar (IRQ -> reanudación); la espera en sí no cuenta
+    if (collapse_irq_seen && slept) {
+        uint64_t wake = get_hardware_tick() - collapse_irq_tick;
+        uint64_t window = (3 * spin_window_ticks + sleep_cost + wake) / 4;
+        if (window < BRIDGE_SPIN_MIN_TICKS) window = BRIDGE_SPIN_MIN_TICKS;
+        if (window > BRIDGE_SPIN_MAX_TICKS) window = BRIDGE_SPIN_MAX_TICKS;
+        spin_window_ticks = window;
+    }
+}
+
 // --- Phase 2: Handshake Protocol ---
 void qport_handshake(void) {
     uart_puts("--------------------------------------------\n\r");
@@ -59,7 +156,7 @@ void qport_handshake(void) {
     }
 
     // 2. Thermal Purge: Send Calibrate Command
-    QPORT->CONTROL_REG = CMD_CALIBRATE;
+    qport_command(CMD_CALIBRATE);
     uart_puts("Locked. Cooling Superconductors...\n\r");
     
     int timeout = 10000000;
@@ -75,6 +172,11 @@ void qport_handshake(void) {
 
     // 3. Phase Lock
     system_phase_zero = QPORT->PHASE_LOCK;
+
+    // 4. Ruta de interrupción del colapso (PLIC -> bridge_collapse_isr);
+    // la ventana de spin se recalibra desde el valor por defecto
+    spin_window_ticks = BRIDGE_SPIN_DEFAULT_TICKS;
+    trap_register_irq(QPORT_COLLAPSE_IRQ, bridge_collapse_isr);
     uart_puts(ANSI_COLOR_GREEN "[ QUANTUM BRIDGE ONLINE ]\n\r" ANSI_COLOR_RESET);
 }
 
@@ -86,7 +188,7 @@ void bridge_tick_sync(majorana_byte_t *cycle) {
         // y simulamos un pequeño delay de procesamiento.
         for (volatile int i = 0; i < 10000; i++);
         
-        uint8_t mock_state = (uint8_t)((pseudo_random() % 2) << 7);
+        uint8_t mock_state = sim_collapse(cycle->raw);
         cycle->raw = (uint8_t)((cycle->raw & 0x7F) | mock_state);
         return;
     }
@@ -97,16 +199,12 @@ void bridge_tick_sync(majorana_byte_t *cycle) {
     QPORT->DATA_LATCH = (uint32_t)(cycle->raw & 0x7F);
     
     // Command QPU to preparing state
-    QPORT->CONTROL_REG = CMD_PREPARE_STATE;
+    qport_command(CMD_PREPARE_STATE);
 
     // 2. Estasis (Energy Fragmenting)
     // Wait for the collapse event (Data Ready)
     // The CPU must be silent (NOPs/WFI) to avoid EM noise
-    while (!(QPORT->STATUS_REG & STATUS_DATA_READY)) {
-        // En un sistema real usaríamos 'wfi' para bajo consumo
-        // Aquí usaremos busy-wait estricto según la especificación
-        cpu_relax();
-    }
+    bridge_wait_collapse();
     
     // 3. Collapse (Post-Pulse)
     // Read the collapsed reality from the latch
@@ -117,3 +215,132 @@ void bridge_tick_sync(majorana_byte_t *cycle) {
     // We assume hardware provides the FULL byte back.
     cycle->raw = (uint8_t)(collapsed_data & 0xFF);
 }
+
+// --- Phase 4: Asynchronous Pipeline ---
+// Anillo FIFO: [head, head + done) colapsados, [head + done] en el QPU si
+// issued, el resto pendiente. Los colapsos llegan en orden de propuesta.
+static struct {
+    uint8_t raw[BRIDGE_QUEUE_DEPTH];
+    uint32_t head;
+    uint32_t count;
+    uint32_t done;
+    uint32_t issued;
+} bridge_queue;
+
+#define BRIDGE_SLOT(i) ((bridge_queue.head + (i)) % BRIDGE_QUEUE_DEPTH)
+
+// Lanza la siguiente propuesta pendiente si el QPU está libre
+static void bridge_issue_next(void) {
+    if (bridge_queue.issued || bridge_queue.done == bridge_queue.count) return;
+
+    if (!g_simulation_mode) {
+        // Mismo protocolo que bridge_tick_sync: el QPU baja DATA_READY al aceptar el comando
+        QPORT->DATA_LATCH = (uint32_t)(bridge_queue.raw[BRIDGE_SLOT(bridge_queue.done)] & 0x7F);
+        qport_command(CMD_PREPARE_STATE);
+    }
+    bridge_queue.issued = 1;
+}
+
+int bridge_submit(uint8_t phase) {
+    if (bridge_queue.count == BRIDGE_QUEUE_DEPTH) return -1;
+
+    bridge_queue.raw[BRIDGE_SLOT(bridge_queue.count)] = (uint8_t)(phase & 0x7F);
+    bridge_queue.count++;
+    bridge_poll();
+    return 0;
+}
+
+int bridge_poll(void) {
+    if (bridge_queue.issued) {
+        uint32_t slot = BRIDGE_SLOT(bridge_queue.done);
+        if (g_simulation_mode) {
+            uint8_t mock_state = sim_collapse(bridge_queue.raw[slot]);
+            bridge_queue.raw[slot] = (uint8_t)(bridge_queue.raw[slot] | mock_state);
+        } else {
+            if (!(QPORT->STATUS_REG & STATUS_DATA_READY)) return (int)bridge_queue.done;
+            bridge_queue.raw[slot] = (uint8_t)(QPORT->DATA_LATCH & 0xFF);
+        }
+        bridge_queue.done++;
+        bridge_queue.issued = 0;
+    }
+
+    bridge_issue_next();
+    return (int)bridge_queue.done;
+}
+
+int bridge_complete(majorana_byte_t *cycle) {
+    if (bridge_queue.count == 0) return -1;
+
+    while (bridge_poll() == 0) {
+        bridge_wait_collapse();
+    }
+
+    cycle->raw = bridge_queue.raw[bridge_queue.head];
+    bridge_queue.head = (bridge_queue.head + 1) % BRIDGE_QUEUE_DEPTH;
+    bridge_queue.count--;
+    bridge_queue.done--;
+    return 0;
+}
+
+uint32_t bridge_inflight(void) {
+    return bridge_queue.count;
+}
+
+// --- Phase 5: Batched Transactions ---
+static void bridge_batch_burst(majorana_byte_t *cycles, uint32_t k) {
+    if (g_simulation_mode) {
+        for (volatile int i = 0; i < 10000; i++);
+        for (uint32_t i = 0; i < k; i++) {
+            uint8_t mock_state = sim_collapse(cycles[i].raw);
+            cycles[i].raw = (uint8_t)((cycles[i].raw & 0x7F) | mock_state);
+        }
+        return;
+    }
+
+    // 1. Ventana de fases (bits 0-6 de cada byte)
+    for (uint32_t w = 0; w < (k + 3) / 4; w++) {
+        uint32_t word = 0;
+        for (uint32_t b = 0; b < 4 && 4 * w + b < k; b++) {
+            word |= (uint32_t)(cycles[4 * w + b].raw & 0x7F) << (8 * b);
+        }
+        QPORT->BATCH_WINDOW[w] = word;
+    }
+    QPORT->BATCH_COUNT = k;
+    qport_command(CMD_PREPARE_BATCH);
+
+    // 2. Una sola espera para los K colapsos
+    bridge_wait_collapse();
+
+    // 3. Lectura en ráfaga
+    for (uint32_t w = 0; w < (k + 3) / 4; w++) {
+        uint32_t word = QPORT->BATCH_WINDOW[w];
+        for (uint32_t b = 0; b < 4 && 4 * w + b < k; b++) {
+            cycles[4 * w + b].raw = (uint8_t)(word >> (8 * b));
+        }
+    }
+}
+
+void bridge_tick_sync_batch(majorana_byte_t *cycles, size_t n) {
+    if (!g_simulation_mode && !(QPORT->STATUS_REG & STATUS_BATCH_CAPABLE)) {
+        // QPU sin modo ráfaga: un handshake por ciclo
+        for (size_t i = 0; i < n; i++) bridge_tick_sync(&cycles[i]);
+        return;
+    }
+
+    while (n > 0) {
+        uint32_t k = (n < QPORT_BATCH_MAX) ? (uint32_t)n : QPORT_BATCH_MAX;
+        bridge_batch_burst(cycles, k);
+        cycles += k;
+        n -= k;
+    }
+}
+
+void bridge_batch_unpack(const majorana_byte_t *cycles, int32_t *phase, int32_t *collapse,
+                         uint8_t *majorana_state, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        uint8_t m = cycles[i].topology.majorana_state;
+        phase[i] = int_to_fixed(cycles[i].topology.phase_trajectory);
+        collapse[i] = int_to_fixed(m);
+        majorana_state[i] = m;
+    }
+}
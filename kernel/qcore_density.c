@@ -0,0 +1,240 @@
+#include "../include/qcore_density.h"
+#include "../include/qcore_lindblad.h"
+
+#define Q30_ONE ((int64_t)1 << 30)
+
+// Complejo exacto para construir el generador: los productos de operadores
+// Q16.16 se acumulan sin redondeo (Q32 tras dos factores).
+typedef struct {
+    int64_t re;
+    int64_t im;
+} c64_t;
+
+typedef c64_t cmat_t[DENSITY_MAX_DIM][DENSITY_MAX_DIM];
+
+static inline int64_t rshift_round(int64_t v, uint32_t s) {
+    return (v + ((int64_t)1 << (s - 1))) >> s;
+}
+
+static void cmat_load(uint32_t d, cmat_t out, const cfixed_t *m) {
+    for (uint32_t i = 0; i < d; i++) {
+        for (uint32_t j = 0; j < d; j++) {
+            out[i][j].re = m[i * d + j].re;
+            out[i][j].im = m[i * d + j].im;
+        }
+    }
+}
+
+static void cmat_mul(uint32_t d, cmat_t out, cmat_t a, cmat_t b) {
+    for (uint32_t i = 0; i < d; i++) {
+        for (uint32_t j = 0; j < d; j++) {
+            int64_t re = 0, im = 0;
+            for (uint32_t k = 0; k < d; k++) {
+                re += a[i][k].re * b[k][j].re - a[i][k].im * b[k][j].im;
+                im += a[i][k].re * b[k][j].im + a[i][k].im * b[k][j].re;
+            }
+            out[i][j].re = re;
+            out[i][j].im = im;
+        }
+    }
+}
+
+static void cmat_adjoint(uint32_t d, cmat_t out, cmat_t a) {
+    for (uint32_t i = 0; i < d; i++) {
+        for (uint32_t j = 0; j < d; j++) {
+            out[i][j].re = a[j][i].re;
+            out[i][j].im = -a[j][i].im;
+        }
+    }
+}
+
+// Matriz hermítica B_j del parámetro j (entradas 0, ±1, ±i)
+static void basis_matrix(uint32_t d, uint32_t j, cmat_t b) {
+    for (uint32_t r = 0; r < d; r++) {
+        for (uint32_t c = 0; c < d; c++) {
+            b[r][c].re = 0;
+            b[r][c].im = 0;
+        }
+    }
+    if (j < d) {
+        b[j][j].re = 1;
+        return;
+    }
+    uint32_t k = d;
+    for (uint32_t r = 0; r < d; r++) {
+        for (uint32_t c = r + 1; c < d; c++, k += 2) {
+            if (j == k) {
+                b[r][c].re = 1;
+                b[c][r].re = 1;
+                return;
+            }
+            if (j == k + 1) {
+                b[r][c].im = 1;
+                b[c][r].im = -1;
+                return;
+            }
+        }
+    }
+}
+
+// Parámetros compactos de una matriz hermítica
+static void extract_params(uint32_t d, cmat_t m, int64_t *x) {
+    for (uint32_t k = 0; k < d; k++) x[k] = m[k][k].re;
+    uint32_t k = d;
+    for (uint32_t r = 0; r < d; r++) {
+        for (uint32_t c = r + 1; c < d; c++, k += 2) {
+            x[k] = m[r][c].re;
+            x[k + 1] = m[r][c].im;
+        }
+    }
+}
+
+int density_prop_build(density_prop_t *prop, uint32_t dim, const cfixed_t *h,
+                       const cfixed_t *jumps, const fixed_t *rates, uint32_t n_jumps,
+                       fixed_t dt) {
+    if (dim < 1 || dim > DENSITY_MAX_DIM) return -1;
+    uint32_t np = dim * dim;
+
+    cmat_t hm, lm, ldag, ldl, b, t1, t2, t3, dm;
+    cmat_load(dim, hm, h);
+
+    // A = G·dt en Q2.30, columna a columna: G·e_j = params(D(B_j))
+    int64_t a[DENSITY_MAX_PARAMS][DENSITY_MAX_PARAMS];
+    for (uint32_t j = 0; j < np; j++) {
+        basis_matrix(dim, j, b);
+
+        // -i[H, B]: Q16 -> Q32
+        cmat_mul(dim, t1, hm, b);
+        cmat_mul(dim, t2, b, hm);
+        for (uint32_t r = 0; r < dim; r++) {
+            for (uint32_t c = 0; c < dim; c++) {
+                int64_t cre = t1[r][c].re - t2[r][c].re;
+                int64_t cim = t1[r][c].im - t2[r][c].im;
+                dm[r][c].re = cim * 65536;
+                dm[r][c].im = -cre * 65536;
+            }
+        }
+
+        // Γ_k (L B L† - 1/2 {L†L, B}), todo en Q32
+        for (uint32_t k = 0; k < n_jumps; k++) {
+            cmat_load(dim, lm, jumps + (size_t)k * dim * dim);
+            cmat_adjoint(dim, ldag, lm);
+            cmat_mul(dim, ldl, ldag, lm);
+
+            cmat_mul(dim, t1, lm, b);
+            cmat_mul(dim, t3, t1, ldag);
+            cmat_mul(dim, t1, ldl, b);
+            cmat_mul(dim, t2, b, ldl);
+            for (uint32_t r = 0; r < dim; r++) {
+                for (uint32_t c = 0; c < dim; c++) {
+                    int64_t tre = t3[r][c].re - ((t1[r][c].re + t2[r][c].re) >> 1);
+                    int64_t tim = t3[r][c].im - ((t1[r][c].im + t2[r][c].im) >> 1);
+                    dm[r][c].re += rshift_round(tre * rates[k], 16);
+                    dm[r][c].im += rshift_round(tim * rates[k], 16);
+                }
+            }
+        }
+
+        int64_t col[DENSITY_MAX_PARAMS];
+        extract_params(dim, dm, col);
+        for (uint32_t i = 0; i < np; i++) {
+            a[i][j] = rshift_round(col[i] * dt, 18); // Q32 · Q16 -> Q30
+        }
+    }
+
+    // RK4 en el régimen estable: ||A||∞ <= 1/2 también acota P por e^(1/2) < 2
+    for (uint32_t i = 0; i < np; i++) {
+        int64_t row = 0;
+        for (uint32_t j = 0; j < np; j++) row += (a[i][j] < 0) ? -a[i][j] : a[i][j];
+        if (row > Q30_ONE / 2) return -1;
+    }
+
+    // Horner: P = I + A(I + A/2 (I + A/3 (I + A/4)))
+    int64_t m[DENSITY_MAX_PARAMS][DENSITY_MAX_PARAMS];
+    int64_t t[DENSITY_MAX_PARAMS][DENSITY_MAX_PARAMS];
+    for (uint32_t i = 0; i < np; i++) {
+        for (uint32_t j = 0; j < np; j++) {
+            m[i][j] = a[i][j] / 4 + ((i == j) ? Q30_ONE : 0);
+        }
+    }
+    for (int64_t div = 3; div >= 1; div--) {
+        for (uint32_t i = 0; i < np; i++) {
+            for (uint32_t j = 0; j < np; j++) {
+                int64_t acc = 0;
+                for (uint32_t k = 0; k < np; k++) acc += rshift_round(a[i][k] * m[k][j], 30);
+                t[i][j] = acc / div;
+            }
+        }
+        for (uint32_t i = 0; i < np; i++) {
+            for (uint32_t j = 0; j < np; j++) {
+                m[i][j] = t[i][j] + ((i == j) ? Q30_ONE : 0);
+            }
+        }
+    }
+
+    prop->dim = dim;
+    prop->n_params = np;
+    for (uint32_t i = 0; i < DENSITY_MAX_PARAMS; i++) {
+        for (uint32_t j = 0; j < DENSITY_MAX_PARAMS; j++) {
+            prop->p[i][j] = (i < np && j < np) ? (int32_t)m[i][j] : 0;
+        }
+    }
+    return 0;
+}
+
+int density_prop_qubit(density_prop_t *prop, fixed_t omega, fixed_t gamma_phi, fixed_t dt) {
+    const fixed_t one = int_to_fixed(1);
+    cfixed_t h[4] = { { omega / 2, 0 }, { 0, 0 }, { 0, 0 }, { -(omega / 2), 0 } };
+    cfixed_t jumps[8] = {
+        { 0, 0 }, { one, 0 }, { 0, 0 }, { 0, 0 },      // L_π = σ⁻ = |0><1|
+        { one, 0 }, { 0, 0 }, { 0, 0 }, { -one, 0 },    // L_φ = σ_z
+    };
+    fixed_t rates[2] = { mult_q16(PHI_SQUARED_FIXED, gamma_phi), gamma_phi / 2 };
+    return density_prop_build(prop, 2, h, jumps, rates, 2, dt);
+}
+
+void density_step_q16(const density_prop_t *prop, fixed_t *x, size_t stride,
+                      size_t n_channels, uint32_t steps) {
+    const uint32_t d = prop->dim;
+    const uint32_t np = prop->n_params;
+
+    for (size_t c0 = 0; c0 < n_channels; c0 += DENSITY_LANES) {
+        size_t w = n_channels - c0;
+        if (w > DENSITY_LANES) w = DENSITY_LANES;
+
+        int32_t v[DENSITY_MAX_PARAMS][DENSITY_LANES];
+        for (uint32_t k = 0; k < np; k++) {
+            for (size_t l = 0; l < DENSITY_LANES; l++) {
+                v[k][l] = (l < w) ? x[k * stride + c0 + l] : 0;
+            }
+        }
+
+        for (uint32_t s = 0; s < steps; s++) {
+            int32_t nv[DENSITY_MAX_PARAMS][DENSITY_LANES];
+            for (uint32_t i = 0; i < np; i++) {
+                int64_t acc[DENSITY_LANES] = { 0 };
+                for (uint32_t j = 0; j < np; j++) {
+                    const int64_t p = prop->p[i][j];
+                    for (size_t l = 0; l < DENSITY_LANES; l++) acc[l] += p * v[j][l];
+                }
+                for (size_t l = 0; l < DENSITY_LANES; l++) {
+                    nv[i][l] = (int32_t)rshift_round(acc[l], 30);
+                }
+            }
+            // Lindblad conserva la traza: el redondeo no debe derivarla
+            for (size_t l = 0; l < DENSITY_LANES; l++) {
+                int32_t tr = 0, rest = 0;
+                for (uint32_t k = 0; k < d; k++) tr += v[k][l];
+                for (uint32_t k = 0; k + 1 < d; k++) rest += nv[k][l];
+                nv[d - 1][l] = tr - rest;
+            }
+            for (uint32_t k = 0; k < np; k++) {
+                for (size_t l = 0; l < DENSITY_LANES; l++) v[k][l] = nv[k][l];
+            }
+        }
+
+        for (uint32_t k = 0; k < np; k++) {
+            for (size_t l = 0; l < w; l++) x[k * stride + c0 + l] = v[k][l];
+        }
+    }
+}
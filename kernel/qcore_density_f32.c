@@ -0,0 +1,91 @@
+#include "../include/qcore_density.h"
+#include "../include/qcore_arch.h"
+
+#if defined(ARCH_X86_64)
+    #include <immintrin.h>
+    #define DENSITY_HAVE_AVX2
+#endif
+
+/**
+ * Modo float del integrador de Lindblad (solo host, libqcore.so).
+ * Mismo propagador Q2.30 que density_step_q16, convertido a float una vez
+ * por llamada. Un grupo de 8 canales ocupa un registro AVX por parámetro:
+ * x_i ← Σ_j P_ij · x_j son np² FMA con P_ij difundido a los 8 carriles.
+ */
+
+static int density_use_avx2 = -1;
+
+static void density_probe(void) {
+#ifdef DENSITY_HAVE_AVX2
+    if (density_use_avx2 < 0) density_use_avx2 = arch_probe_vector() && __builtin_cpu_supports("fma");
+#else
+    density_use_avx2 = 0;
+#endif
+}
+
+int density_f32_set_simd(int enable) {
+    density_use_avx2 = -1;
+    density_probe();
+    if (!enable) density_use_avx2 = 0;
+    return density_use_avx2;
+}
+
+// Canales [c0, c1) en escalar (cola de AVX2 o sin SIMD)
+static void step_f32_c(const float p[DENSITY_MAX_PARAMS][DENSITY_MAX_PARAMS], uint32_t np,
+                       float *x, size_t stride, size_t c0, size_t c1, uint32_t steps) {
+    for (size_t c = c0; c < c1; c++) {
+        float v[DENSITY_MAX_PARAMS], nv[DENSITY_MAX_PARAMS];
+        for (uint32_t k = 0; k < np; k++) v[k] = x[k * stride + c];
+        for (uint32_t s = 0; s < steps; s++) {
+            for (uint32_t i = 0; i < np; i++) {
+                float acc = 0.0f;
+                for (uint32_t j = 0; j < np; j++) acc += p[i][j] * v[j];
+                nv[i] = acc;
+            }
+            for (uint32_t k = 0; k < np; k++) v[k] = nv[k];
+        }
+        for (uint32_t k = 0; k < np; k++) x[k * stride + c] = v[k];
+    }
+}
+
+#ifdef DENSITY_HAVE_AVX2
+// Grupos completos de 8 canales; retorna el primer canal sin procesar
+__attribute__((target("avx2,fma")))
+static size_t step_f32_avx2(const float p[DENSITY_MAX_PARAMS][DENSITY_MAX_PARAMS], uint32_t np,
+                            float *x, size_t stride, size_t n, uint32_t steps) {
+    size_t c0 = 0;
+    for (; c0 + 8 <= n; c0 += 8) {
+        __m256 v[DENSITY_MAX_PARAMS], nv[DENSITY_MAX_PARAMS];
+        for (uint32_t k = 0; k < np; k++) v[k] = _mm256_loadu_ps(x + k * stride + c0);
+        for (uint32_t s = 0; s < steps; s++) {
+            for (uint32_t i = 0; i < np; i++) {
+                __m256 acc = _mm256_mul_ps(_mm256_set1_ps(p[i][0]), v[0]);
+                for (uint32_t j = 1; j < np; j++) {
+                    acc = _mm256_fmadd_ps(_mm256_set1_ps(p[i][j]), v[j], acc);
+                }
+                nv[i] = acc;
+            }
+            for (uint32_t k = 0; k < np; k++) v[k] = nv[k];
+        }
+        for (uint32_t k = 0; k < np; k++) _mm256_storeu_ps(x + k * stride + c0, v[k]);
+    }
+    return c0;
+}
+#endif
+
+void density_step_f32(const density_prop_t *prop, float *x, size_t stride,
+                      size_t n_channels, uint32_t steps) {
+    density_probe();
+
+    const uint32_t np = prop->n_params;
+    float p[DENSITY_MAX_PARAMS][DENSITY_MAX_PARAMS];
+    for (uint32_t i = 0; i < np; i++) {
+        for (uint32_t j = 0; j < np; j++) p[i][j] = (float)prop->p[i][j] * (1.0f / 1073741824.0f);
+    }
+
+    size_t done = 0;
+#ifdef DENSITY_HAVE_AVX2
+    if (density_use_avx2) done = step_f32_avx2(p, np, x, stride, n_channels, steps);
+#endif
+    step_f32_c(p, np, x, stride, done, n_channels, steps);
+}
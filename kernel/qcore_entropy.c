@@ -0,0 +1,128 @@
+#include "../include/qcore_entropy.h"
+#include "../include/qcore_port.h"
+#include "../include/qcore_arch.h"
+
+#define ENTROPY_GOLDEN_64 0x9E3779B97F4A7C15ULL // φ·2^64
+
+_Static_assert((ENTROPY_RING_WORDS & (ENTROPY_RING_WORDS - 1)) == 0, "ENTROPY_RING_WORDS debe ser potencia de 2");
+
+static struct {
+    int seeded;
+    uint64_t key;
+    uint64_t ctr;                        // Palabras servidas con la llave actual o anteriores
+    uint64_t sim_state;                  // Flujo splitmix64 del modo simulación
+    uint64_t reseeds;
+    uint64_t ring[ENTROPY_RING_WORDS];
+    uint32_t ring_head;                  // Cosechadas (total)
+    uint32_t ring_tail;                  // Absorbidas (total)
+    uint64_t bits;                       // Bits pendientes de entropy_bit
+    uint32_t n_bits;
+    uint32_t hi;                         // Mitad alta pendiente de entropy_next32
+    uint32_t has_hi;
+} pool;
+
+static inline uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void entropy_seed(uint64_t seed) {
+    pool.seeded = 1;
+    pool.key = mix64(seed);
+    pool.ctr = 0;
+    pool.sim_state = seed;
+    pool.reseeds = 0;
+    pool.ring_head = 0;
+    pool.ring_tail = 0;
+    pool.n_bits = 0;
+    pool.has_hi = 0;
+}
+
+static inline void entropy_ensure_seeded(void) {
+    if (!pool.seeded) entropy_seed(ENTROPY_DEFAULT_SEED);
+}
+
+size_t entropy_harvest(size_t max_words) {
+    entropy_ensure_seeded();
+    size_t room = ENTROPY_RING_WORDS - (pool.ring_head - pool.ring_tail);
+    size_t n = (max_words < room) ? max_words : room;
+
+    for (size_t k = 0; k < n; k++) {
+        uint64_t w;
+        if (g_simulation_mode) {
+            w = mix64(pool.sim_state += ENTROPY_GOLDEN_64);
+        } else {
+            uint64_t hi = QPORT->DATA_LATCH;
+            uint64_t lo = QPORT->DATA_LATCH;
+            w = ((hi << 32) | lo) ^ get_hardware_tick();
+        }
+        pool.ring[pool.ring_head++ & (ENTROPY_RING_WORDS - 1)] = w;
+    }
+    return n;
+}
+
+void entropy_idle_refill(void) {
+    entropy_harvest(ENTROPY_IDLE_BATCH);
+}
+
+size_t entropy_available(void) {
+    return pool.ring_head - pool.ring_tail;
+}
+
+uint64_t entropy_reseeds(void) {
+    return pool.reseeds;
+}
+
+// La llave absorbe todo lo cosechado (solo memoria: nunca MMIO)
+static void entropy_reseed(void) {
+    if (pool.ring_head == pool.ring_tail && g_simulation_mode) entropy_harvest(ENTROPY_RESEED_WORDS);
+    if (pool.ring_head == pool.ring_tail) return;
+    while (pool.ring_tail != pool.ring_head) {
+        pool.key = mix64(pool.key ^ pool.ring[pool.ring_tail++ & (ENTROPY_RING_WORDS - 1)]);
+    }
+    pool.reseeds++;
+}
+
+uint64_t entropy_next64(void) {
+    entropy_ensure_seeded();
+    if (pool.ctr && pool.ctr % ENTROPY_RESEED_INTERVAL == 0) entropy_reseed();
+    return mix64(pool.key + pool.ctr++ * ENTROPY_GOLDEN_64);
+}
+
+uint32_t entropy_next32(void) {
+    if (pool.has_hi) {
+        pool.has_hi = 0;
+        return pool.hi;
+    }
+    uint64_t w = entropy_next64();
+    pool.hi = (uint32_t)(w >> 32);
+    pool.has_hi = 1;
+    return (uint32_t)w;
+}
+
+uint32_t entropy_bit(void) {
+    if (pool.n_bits == 0) {
+        pool.bits = entropy_next64();
+        pool.n_bits = 64;
+    }
+    uint32_t b = (uint32_t)(pool.bits & 1);
+    pool.bits >>= 1;
+    pool.n_bits--;
+    return b;
+}
+
+void entropy_fill(uint32_t *out, size_t n) {
+    size_t k = 0;
+    if (n && pool.has_hi) out[k++] = entropy_next32();
+    for (; k + 2 <= n; k += 2) {
+        uint64_t w = entropy_next64();
+        out[k] = (uint32_t)w;
+        out[k + 1] = (uint32_t)(w >> 32);
+    }
+    if (k < n) out[k] = entropy_next32();
+}
+
+void entropy_fill64(uint64_t *out, size_t n) {
+    for (size_t k = 0; k < n; k++) out[k] = entropy_next64();
+}
@@ -0,0 +1,651 @@
+#include "../include/qcore_fixed_vec.h"
+#include "../include/qcore_arch.h"
+#include "../include/qcore_lindblad.h"
+
+#if defined(ARCH_X86_64)
+    #include <immintrin.h>
+    #define FIXED_VEC_HAVE_AVX2
+#endif
+
+// Los kernels RVV (qcore_fixed_vec_rvv.S) solo se enlazan en la imagen RISC-V
+#if defined(ARCH_RISCV) && !defined(QCORE_TEST_ENV)
+    #define FIXED_VEC_HAVE_RVV
+#endif
+
+// Bloque de ángulos binarios precalculados para fixed_vec_golden (en pila)
+#define GOLDEN_CHUNK 64
+
+// Tabla de operaciones por backend
+typedef struct {
+    void (*mul)(fixed_t *out, const fixed_t *a, const fixed_t *b, size_t n);
+    void (*add_sat)(fixed_t *out, const fixed_t *a, const fixed_t *b, size_t n);
+    // |a| * recip >> shift con el signo de a, invertido si dneg = 0xFFFFFFFF
+    void (*div_recip)(fixed_t *out, const fixed_t *a, size_t n, uint32_t recip, uint32_t shift, uint32_t dneg);
+    void (*cos)(fixed_t *out, const fixed_t *angle, size_t n);
+    // out[i] = cos(bam[i]), negado si (parity + i) es impar
+    void (*cos_bam_alt)(fixed_t *out, const uint32_t *bam, size_t n, uint32_t parity);
+    // q = {cx, cy, m00, m01, m10, m11}; retorna cuántos out[i] > threshold
+    size_t (*quad_form2)(fixed_t *out, const fixed_t *x, const fixed_t *y, const fixed_t *q, size_t n, fixed_t threshold);
+    // Un punto (x, y) contra n juegos de parámetros: filas {cx, cy, m00, m01, m10, m11} separadas por stride
+    void (*quad_form2_lanes)(fixed_t *out, fixed_t x, fixed_t y, const fixed_t *p, size_t stride, size_t n);
+    // Σ s[i] y activos con s = amp negado donde data == target
+    size_t (*grover_oracle_sum)(const fixed_t *amp, const int32_t *data, size_t n, int32_t target, int64_t *sum);
+    // amp = s != 0 ? two_mean - s : 0; luego oracle_sum del resultado
+    size_t (*grover_step)(fixed_t *amp, const int32_t *data, size_t n, int32_t target, fixed_t two_mean, int64_t *sum);
+    // Visibilidad del Lindblad Filter; retorna cuántos canales caen bajo el umbral Fermiónico
+    size_t (*lindblad_visibility)(fixed_t *vis, const fixed_t *surprise, const uint8_t *majorana, size_t n);
+    void (*xor_key)(uint32_t *buf, size_t n, uint32_t key);
+} fixed_vec_ops_t;
+
+// ============================================================================
+// BACKEND C PORTABLE (también resuelve las colas de los backends SIMD)
+// ============================================================================
+
+static void vec_mul_c(fixed_t *out, const fixed_t *a, const fixed_t *b, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = (fixed_t)(((int64_t)a[i] * b[i]) >> 16);
+    }
+}
+
+static void vec_add_sat_c(fixed_t *out, const fixed_t *a, const fixed_t *b, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        int64_t s = (int64_t)a[i] + b[i];
+        if (s > INT32_MAX) s = INT32_MAX;
+        if (s < INT32_MIN) s = INT32_MIN;
+        out[i] = (fixed_t)s;
+    }
+}
+
+static void vec_div_recip_c(fixed_t *out, const fixed_t *a, size_t n, uint32_t recip, uint32_t shift, uint32_t dneg) {
+    for (size_t i = 0; i < n; i++) {
+        uint32_t sa = (uint32_t)(a[i] >> 31);
+        uint32_t mag = ((uint32_t)a[i] ^ sa) - sa;
+        uint32_t q = (uint32_t)(((uint64_t)mag * recip) >> shift);
+        uint32_t s = sa ^ dneg;
+        out[i] = (fixed_t)((q ^ s) - s);
+    }
+}
+
+static void vec_cos_c(fixed_t *out, const fixed_t *angle, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        uint32_t bam = (uint32_t)(((int64_t)angle[i] * FIXED_RAD_TO_BAM_Q16 + 0x8000) >> 16);
+        out[i] = qcore_q30_to_fixed(qcore_sin_bam_q30(bam + 0x40000000u));
+    }
+}
+
+static void vec_cos_bam_alt_c(fixed_t *out, const uint32_t *bam, size_t n, uint32_t parity) {
+    for (size_t i = 0; i < n; i++) {
+        fixed_t r = qcore_q30_to_fixed(qcore_sin_bam_q30(bam[i] + 0x40000000u));
+        out[i] = ((parity + (uint32_t)i) & 1u) ? -r : r;
+    }
+}
+
+// Misma secuencia que calculate_mahalanobis_sq: productos truncados a 32 bits
+// y sumas modulares, para que todos los backends sean bit a bit idénticos
+static inline fixed_t quad_form2_elem(fixed_t x, fixed_t y, fixed_t cx, fixed_t cy,
+                                      fixed_t m00, fixed_t m01, fixed_t m10, fixed_t m11) {
+    int32_t d0 = (int32_t)((uint32_t)x - (uint32_t)cx);
+    int32_t d1 = (int32_t)((uint32_t)y - (uint32_t)cy);
+    uint32_t t1 = (uint32_t)(((int64_t)d0 * m00) >> 16) + (uint32_t)(((int64_t)d1 * m10) >> 16);
+    uint32_t t2 = (uint32_t)(((int64_t)d0 * m01) >> 16) + (uint32_t)(((int64_t)d1 * m11) >> 16);
+    return (fixed_t)((uint32_t)(((int64_t)(int32_t)t1 * d0) >> 16) + (uint32_t)(((int64_t)(int32_t)t2 * d1) >> 16));
+}
+
+static size_t vec_quad_form2_c(fixed_t *out, const fixed_t *x, const fixed_t *y, const fixed_t *q, size_t n, fixed_t threshold) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        out[i] = quad_form2_elem(x[i], y[i], q[0], q[1], q[2], q[3], q[4], q[5]);
+        count += (out[i] > threshold);
+    }
+    return count;
+}
+
+static void vec_quad_form2_lanes_c(fixed_t *out, fixed_t x, fixed_t y, const fixed_t *p, size_t stride, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = quad_form2_elem(x, y, p[i], p[stride + i], p[2 * stride + i],
+                                 p[3 * stride + i], p[4 * stride + i], p[5 * stride + i]);
+    }
+}
+
+// Sin ramas: la máscara del oráculo (0 / -1) niega por complemento a dos
+static size_t vec_grover_oracle_sum_c(const fixed_t *amp, const int32_t *data, size_t n, int32_t target, int64_t *sum) {
+    int64_t acc = 0;
+    size_t active = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t m = 0u - (uint32_t)(data[i] == target);
+        uint32_t s = ((uint32_t)amp[i] ^ m) - m;
+        acc += (int32_t)s;
+        active += (s != 0);
+    }
+    *sum = acc;
+    return active;
+}
+
+static size_t vec_grover_step_c(fixed_t *amp, const int32_t *data, size_t n, int32_t target, fixed_t two_mean, int64_t *sum) {
+    int64_t acc = 0;
+    size_t active = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t m = 0u - (uint32_t)(data[i] == target);
+        uint32_t s = ((uint32_t)amp[i] ^ m) - m;
+        uint32_t r = ((uint32_t)two_mean - s) & (0u - (uint32_t)(s != 0));
+        amp[i] = (fixed_t)r;
+        acc += (int32_t)((r ^ m) - m);
+        active += (r != 0);
+    }
+    *sum = acc;
+    return active;
+}
+
+// Saturación, |s|·recíproco con el signo de s, ajuste por majorana y clamp a [0, 1]
+static size_t vec_lindblad_visibility_c(fixed_t *vis, const fixed_t *surprise, const uint8_t *majorana, size_t n) {
+    size_t below = 0;
+    for (size_t i = 0; i < n; i++) {
+        fixed_t s = surprise[i];
+        if (s > LINDBLAD_MAX_SURPRISE) s = LINDBLAD_MAX_SURPRISE;
+        if (s < -LINDBLAD_MAX_SURPRISE) s = -LINDBLAD_MAX_SURPRISE;
+        uint32_t sa = (uint32_t)(s >> 31);
+        uint32_t mag = ((uint32_t)s ^ sa) - sa;
+        uint32_t q = (uint32_t)(((uint64_t)mag * LINDBLAD_SURPRISE_RECIP) >> LINDBLAD_SURPRISE_SHIFT);
+        fixed_t v = 0x00010000 - (fixed_t)((q ^ sa) - sa);
+        v += (majorana[i] == 1) ? -LINDBLAD_COLLAPSE_PENALTY : LINDBLAD_COHERENCE_BONUS;
+        if (v < 0) v = 0;
+        if (v > 0x00010000) v = 0x00010000;
+        vis[i] = v;
+        below += (v < FERMIONIC_THRESHOLD);
+    }
+    return below;
+}
+
+// Palabras de 64 bits una vez alineado el puntero
+typedef uint64_t __attribute__((may_alias)) u64_alias_t;
+
+static void vec_xor_key_c(uint32_t *buf, size_t n, uint32_t key) {
+    size_t i = 0;
+    for (; i < n && ((uintptr_t)(buf + i) & 7u); i++) buf[i] ^= key;
+    const uint64_t key64 = ((uint64_t)key << 32) | key;
+    u64_alias_t *w = (u64_alias_t *)(buf + i);
+    size_t pairs = (n - i) / 2;
+    for (size_t j = 0; j < pairs; j++) w[j] ^= key64;
+    for (i += pairs * 2; i < n; i++) buf[i] ^= key;
+}
+
+static const fixed_vec_ops_t ops_c = {
+    vec_mul_c, vec_add_sat_c, vec_div_recip_c, vec_cos_c, vec_cos_bam_alt_c, vec_quad_form2_c,
+    vec_quad_form2_lanes_c, vec_grover_oracle_sum_c, vec_grover_step_c, vec_lindblad_visibility_c,
+    vec_xor_key_c
+};
+
+// ============================================================================
+// BACKEND AVX2 (x86-64, libqcore.so)
+// ============================================================================
+// Se compila con target("avx2") por función: el resto de la librería sigue
+// siendo x86-64 base y solo se entra aquí si CPUID confirma AVX2.
+#ifdef FIXED_VEC_HAVE_AVX2
+
+#define AVX2_FN static inline __attribute__((target("avx2")))
+
+// Producto 32x32->64 por carriles pares e impares; retorna los bits [s, s+32)
+AVX2_FN __m256i avx2_mul_shift_epi32(__m256i a, __m256i b, int s) {
+    __m128i cnt = _mm_cvtsi32_si128(s);
+    __m256i even = _mm256_srl_epi64(_mm256_mul_epi32(a, b), cnt);
+    __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    odd = _mm256_slli_epi64(_mm256_srl_epi64(odd, cnt), 32);
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+AVX2_FN __m256i avx2_mulu_shift_epi32(__m256i a, __m256i b, __m128i cnt) {
+    __m256i even = _mm256_srl_epi64(_mm256_mul_epu32(a, b), cnt);
+    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    odd = _mm256_slli_epi64(_mm256_srl_epi64(odd, cnt), 32);
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+// Versión vectorial de qcore_sin_bam_q30 + redondeo a Q16.16 (8 carriles)
+AVX2_FN __m256i avx2_sin_bam(__m256i bam) {
+    const __m256i quarter = _mm256_set1_epi32(0x40000000);
+    __m256i mirror = _mm256_srai_epi32(_mm256_slli_epi32(bam, 1), 31);
+    __m256i q = _mm256_and_si256(bam, _mm256_set1_epi32(0x3FFFFFFF));
+    q = _mm256_blendv_epi8(q, _mm256_sub_epi32(quarter, q), mirror);
+
+    __m256i idx = _mm256_srli_epi32(q, QCORE_SINTAB_FRAC_BITS);
+    __m256i y0 = _mm256_i32gather_epi32((const int *)qcore_sintab_q30, idx, 4);
+    __m256i y1 = _mm256_i32gather_epi32((const int *)qcore_sintab_q30 + 1, idx, 4);
+    __m256i frac = _mm256_and_si256(q, _mm256_set1_epi32((1 << QCORE_SINTAB_FRAC_BITS) - 1));
+
+    __m256i interp = avx2_mulu_shift_epi32(_mm256_sub_epi32(y1, y0), frac,
+                                           _mm_cvtsi32_si128(QCORE_SINTAB_FRAC_BITS));
+    __m256i v = _mm256_add_epi32(y0, interp);
+
+    __m256i neg = _mm256_srai_epi32(bam, 31);
+    v = _mm256_sub_epi32(_mm256_xor_si256(v, neg), neg);
+    return _mm256_srai_epi32(_mm256_add_epi32(v, _mm256_set1_epi32(1 << 13)), 14);
+}
+
+static __attribute__((target("avx2")))
+void vec_mul_avx2(fixed_t *out, const fixed_t *a, const fixed_t *b, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(b + i));
+        _mm256_storeu_si256((__m256i *)(out + i), avx2_mul_shift_epi32(va, vb, 16));
+    }
+    vec_mul_c(out + i, a + i, b + i, n - i);
+}
+
+static __attribute__((target("avx2")))
+void vec_add_sat_avx2(fixed_t *out, const fixed_t *a, const fixed_t *b, size_t n) {
+    const __m256i max = _mm256_set1_epi32(0x7FFFFFFF);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(b + i));
+        __m256i s = _mm256_add_epi32(va, vb);
+        // Desborde: operandos del mismo signo y suma de signo distinto
+        __m256i ovf = _mm256_andnot_si256(_mm256_xor_si256(va, vb), _mm256_xor_si256(va, s));
+        __m256i sat = _mm256_xor_si256(_mm256_srai_epi32(va, 31), max);
+        ovf = _mm256_srai_epi32(ovf, 31);
+        _mm256_storeu_si256((__m256i *)(out + i), _mm256_blendv_epi8(s, sat, ovf));
+    }
+    vec_add_sat_c(out + i, a + i, b + i, n - i);
+}
+
+static __attribute__((target("avx2")))
+void vec_div_recip_avx2(fixed_t *out, const fixed_t *a, size_t n, uint32_t recip, uint32_t shift, uint32_t dneg) {
+    const __m256i vr = _mm256_set1_epi32((int32_t)recip); // recip en carriles pares e impares
+    const __m256i vd = _mm256_set1_epi32((int32_t)dneg);
+    const __m128i cnt = _mm_cvtsi32_si128((int)shift);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i mag = _mm256_abs_epi32(va); // INT32_MIN -> 2^31 sin signo
+        __m256i q = avx2_mulu_shift_epi32(mag, vr, cnt);
+        __m256i s = _mm256_xor_si256(_mm256_srai_epi32(va, 31), vd);
+        _mm256_storeu_si256((__m256i *)(out + i), _mm256_sub_epi32(_mm256_xor_si256(q, s), s));
+    }
+    vec_div_recip_c(out + i, a + i, n - i, recip, shift, dneg);
+}
+
+static __attribute__((target("avx2")))
+void vec_cos_avx2(fixed_t *out, const fixed_t *angle, size_t n) {
+    const __m256i k = _mm256_set1_epi64x(FIXED_RAD_TO_BAM_Q16);
+    const __m256i half = _mm256_set1_epi64x(0x8000);
+    const __m256i quarter = _mm256_set1_epi32(0x40000000);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(angle + i));
+        // Reducción de rango: bits [16, 48) de angle * 2^32/(2π) redondeado
+        __m256i even = _mm256_srli_epi64(_mm256_add_epi64(_mm256_mul_epi32(va, k), half), 16);
+        __m256i odd = _mm256_add_epi64(_mm256_mul_epi32(_mm256_srli_epi64(va, 32), k), half);
+        odd = _mm256_slli_epi64(_mm256_srli_epi64(odd, 16), 32);
+        __m256i bam = _mm256_blend_epi32(even, odd, 0xAA);
+        _mm256_storeu_si256((__m256i *)(out + i), avx2_sin_bam(_mm256_add_epi32(bam, quarter)));
+    }
+    vec_cos_c(out + i, angle + i, n - i);
+}
+
+static __attribute__((target("avx2")))
+void vec_cos_bam_alt_avx2(fixed_t *out, const uint32_t *bam, size_t n, uint32_t parity) {
+    const __m256i quarter = _mm256_set1_epi32(0x40000000);
+    // 8 carriles es par: el patrón de signos es el mismo en cada bloque
+    const __m256i flip = parity ? _mm256_setr_epi32(-1, 0, -1, 0, -1, 0, -1, 0)
+                                : _mm256_setr_epi32(0, -1, 0, -1, 0, -1, 0, -1);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(bam + i));
+        __m256i r = avx2_sin_bam(_mm256_add_epi32(vb, quarter));
+        r = _mm256_sub_epi32(_mm256_xor_si256(r, flip), flip);
+        _mm256_storeu_si256((__m256i *)(out + i), r);
+    }
+    vec_cos_bam_alt_c(out + i, bam + i, n - i, parity);
+}
+
+// d = (x, y) - c; retorna dᵀ·M·d por carril
+AVX2_FN __m256i avx2_quad_form2(__m256i d0, __m256i d1, __m256i m00, __m256i m01, __m256i m10, __m256i m11) {
+    __m256i t1 = _mm256_add_epi32(avx2_mul_shift_epi32(d0, m00, 16), avx2_mul_shift_epi32(d1, m10, 16));
+    __m256i t2 = _mm256_add_epi32(avx2_mul_shift_epi32(d0, m01, 16), avx2_mul_shift_epi32(d1, m11, 16));
+    return _mm256_add_epi32(avx2_mul_shift_epi32(t1, d0, 16), avx2_mul_shift_epi32(t2, d1, 16));
+}
+
+static __attribute__((target("avx2")))
+size_t vec_quad_form2_avx2(fixed_t *out, const fixed_t *x, const fixed_t *y, const fixed_t *q, size_t n, fixed_t threshold) {
+    const __m256i cx = _mm256_set1_epi32(q[0]);
+    const __m256i cy = _mm256_set1_epi32(q[1]);
+    const __m256i m00 = _mm256_set1_epi32(q[2]);
+    const __m256i m01 = _mm256_set1_epi32(q[3]);
+    const __m256i m10 = _mm256_set1_epi32(q[4]);
+    const __m256i m11 = _mm256_set1_epi32(q[5]);
+    const __m256i thr = _mm256_set1_epi32(threshold);
+    __m256i hits = _mm256_setzero_si256(); // -1 por carril que supera el umbral
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i d0 = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i *)(x + i)), cx);
+        __m256i d1 = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i *)(y + i)), cy);
+        __m256i r = avx2_quad_form2(d0, d1, m00, m01, m10, m11);
+        _mm256_storeu_si256((__m256i *)(out + i), r);
+        hits = _mm256_sub_epi32(hits, _mm256_cmpgt_epi32(r, thr));
+    }
+
+    uint32_t lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, hits);
+    size_t count = 0;
+    for (int k = 0; k < 8; k++) count += lanes[k];
+    return count + vec_quad_form2_c(out + i, x + i, y + i, q, n - i, threshold);
+}
+
+static __attribute__((target("avx2")))
+void vec_quad_form2_lanes_avx2(fixed_t *out, fixed_t x, fixed_t y, const fixed_t *p, size_t stride, size_t n) {
+    const __m256i vx = _mm256_set1_epi32(x);
+    const __m256i vy = _mm256_set1_epi32(y);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const fixed_t *c = p + i;
+        __m256i d0 = _mm256_sub_epi32(vx, _mm256_loadu_si256((const __m256i *)c));
+        __m256i d1 = _mm256_sub_epi32(vy, _mm256_loadu_si256((const __m256i *)(c + stride)));
+        __m256i r = avx2_quad_form2(d0, d1,
+                                    _mm256_loadu_si256((const __m256i *)(c + 2 * stride)),
+                                    _mm256_loadu_si256((const __m256i *)(c + 3 * stride)),
+                                    _mm256_loadu_si256((const __m256i *)(c + 4 * stride)),
+                                    _mm256_loadu_si256((const __m256i *)(c + 5 * stride)));
+        _mm256_storeu_si256((__m256i *)(out + i), r);
+    }
+    vec_quad_form2_lanes_c(out + i, x, y, p + i, stride, n - i);
+}
+
+// Suma horizontal de 8 carriles (módulo 2^32)
+AVX2_FN uint32_t avx2_hsum_epi32(__m256i v) {
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+    return (uint32_t)_mm_cvtsi128_si32(s);
+}
+
+// acc (4 x int64) += los 8 carriles de v extendidos con signo
+AVX2_FN __m256i avx2_acc_epi32_epi64(__m256i acc, __m256i v) {
+    acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+    return _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+}
+
+AVX2_FN int64_t avx2_hsum_epi64(__m256i v) {
+    __m128i s = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    s = _mm_add_epi64(s, _mm_unpackhi_epi64(s, s));
+    return (int64_t)_mm_cvtsi128_si64(s);
+}
+
+static __attribute__((target("avx2")))
+size_t vec_grover_oracle_sum_avx2(const fixed_t *amp, const int32_t *data, size_t n, int32_t target, int64_t *sum) {
+    const __m256i vt = _mm256_set1_epi32(target);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero;
+    __m256i zeros = zero; // -1 por carril con s == 0
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i m = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(data + i)), vt);
+        __m256i s = _mm256_sub_epi32(_mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(amp + i)), m), m);
+        acc = avx2_acc_epi32_epi64(acc, s);
+        zeros = _mm256_sub_epi32(zeros, _mm256_cmpeq_epi32(s, zero));
+    }
+
+    int64_t tail_sum;
+    size_t active = i - avx2_hsum_epi32(zeros);
+    active += vec_grover_oracle_sum_c(amp + i, data + i, n - i, target, &tail_sum);
+    *sum = avx2_hsum_epi64(acc) + tail_sum;
+    return active;
+}
+
+static __attribute__((target("avx2")))
+size_t vec_grover_step_avx2(fixed_t *amp, const int32_t *data, size_t n, int32_t target, fixed_t two_mean, int64_t *sum) {
+    const __m256i vt = _mm256_set1_epi32(target);
+    const __m256i vm = _mm256_set1_epi32(two_mean);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero;
+    __m256i zeros = zero;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i m = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(data + i)), vt);
+        __m256i s = _mm256_sub_epi32(_mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(amp + i)), m), m);
+        __m256i r = _mm256_andnot_si256(_mm256_cmpeq_epi32(s, zero), _mm256_sub_epi32(vm, s));
+        _mm256_storeu_si256((__m256i *)(amp + i), r);
+        acc = avx2_acc_epi32_epi64(acc, _mm256_sub_epi32(_mm256_xor_si256(r, m), m));
+        zeros = _mm256_sub_epi32(zeros, _mm256_cmpeq_epi32(r, zero));
+    }
+
+    int64_t tail_sum;
+    size_t active = i - avx2_hsum_epi32(zeros);
+    active += vec_grover_step_c(amp + i, data + i, n - i, target, two_mean, &tail_sum);
+    *sum = avx2_hsum_epi64(acc) + tail_sum;
+    return active;
+}
+
+static __attribute__((target("avx2")))
+size_t vec_lindblad_visibility_avx2(fixed_t *vis, const fixed_t *surprise, const uint8_t *majorana, size_t n) {
+    const __m256i max = _mm256_set1_epi32(LINDBLAD_MAX_SURPRISE);
+    const __m256i min = _mm256_set1_epi32(-LINDBLAD_MAX_SURPRISE);
+    const __m256i recip = _mm256_set1_epi32((int32_t)LINDBLAD_SURPRISE_RECIP);
+    const __m128i cnt = _mm_cvtsi32_si128(LINDBLAD_SURPRISE_SHIFT);
+    const __m256i one = _mm256_set1_epi32(0x00010000);
+    const __m256i penalty = _mm256_set1_epi32(-LINDBLAD_COLLAPSE_PENALTY);
+    const __m256i bonus = _mm256_set1_epi32(LINDBLAD_COHERENCE_BONUS);
+    const __m256i threshold = _mm256_set1_epi32(FERMIONIC_THRESHOLD);
+    const __m256i collapse = _mm256_set1_epi32(1);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i below = zero;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i s = _mm256_loadu_si256((const __m256i *)(surprise + i));
+        s = _mm256_max_epi32(_mm256_min_epi32(s, max), min);
+        __m256i sa = _mm256_srai_epi32(s, 31);
+        __m256i q = avx2_mulu_shift_epi32(_mm256_sub_epi32(_mm256_xor_si256(s, sa), sa), recip, cnt);
+        __m256i v = _mm256_sub_epi32(one, _mm256_sub_epi32(_mm256_xor_si256(q, sa), sa));
+
+        __m256i m = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(majorana + i)));
+        v = _mm256_add_epi32(v, _mm256_blendv_epi8(bonus, penalty, _mm256_cmpeq_epi32(m, collapse)));
+        v = _mm256_min_epi32(_mm256_max_epi32(v, zero), one);
+        _mm256_storeu_si256((__m256i *)(vis + i), v);
+        below = _mm256_sub_epi32(below, _mm256_cmpgt_epi32(threshold, v));
+    }
+    return avx2_hsum_epi32(below) + vec_lindblad_visibility_c(vis + i, surprise + i, majorana + i, n - i);
+}
+
+// Una línea de caché (16 palabras) por iteración
+static __attribute__((target("avx2")))
+void vec_xor_key_avx2(uint32_t *buf, size_t n, uint32_t key) {
+    const __m256i k = _mm256_set1_epi32((int32_t)key);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(buf + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(buf + i + 8));
+        _mm256_storeu_si256((__m256i *)(buf + i), _mm256_xor_si256(a, k));
+        _mm256_storeu_si256((__m256i *)(buf + i + 8), _mm256_xor_si256(b, k));
+    }
+    vec_xor_key_c(buf + i, n - i, key);
+}
+
+static const fixed_vec_ops_t ops_avx2 = {
+    vec_mul_avx2, vec_add_sat_avx2, vec_div_recip_avx2, vec_cos_avx2, vec_cos_bam_alt_avx2,
+    vec_quad_form2_avx2, vec_quad_form2_lanes_avx2, vec_grover_oracle_sum_avx2, vec_grover_step_avx2,
+    vec_lindblad_visibility_avx2, vec_xor_key_avx2
+};
+
+#endif // FIXED_VEC_HAVE_AVX2
+
+// ============================================================================
+// BACKEND RVV (RISC-V Vector 1.0, kernel/qcore_fixed_vec_rvv.S)
+// ============================================================================
+#ifdef FIXED_VEC_HAVE_RVV
+
+_Static_assert(QCORE_SINTAB_FRAC_BITS == 22, "Actualizar SINTAB_FRAC_BITS en qcore_fixed_vec_rvv.S");
+_Static_assert(LINDBLAD_MAX_SURPRISE == 393216 && LINDBLAD_SURPRISE_SHIFT == 34 &&
+               LINDBLAD_COLLAPSE_PENALTY == 0x1999 && LINDBLAD_COHERENCE_BONUS == 0xCCC &&
+               FERMIONIC_THRESHOLD == 0x4CCC, "Actualizar las constantes LINDBLAD_* en qcore_fixed_vec_rvv.S");
+
+extern void fixed_vec_mul_rvv(fixed_t *out, const fixed_t *a, const fixed_t *b, size_t n);
+extern void fixed_vec_add_sat_rvv(fixed_t *out, const fixed_t *a, const fixed_t *b, size_t n);
+extern void fixed_vec_div_recip_rvv(fixed_t *out, const fixed_t *a, size_t n, uint32_t recip, uint32_t shift, uint32_t dneg);
+extern void fixed_vec_cos_rvv(fixed_t *out, const fixed_t *angle, size_t n);
+extern void fixed_vec_cos_bam_alt_rvv(fixed_t *out, const uint32_t *bam, size_t n, uint32_t parity);
+extern size_t fixed_vec_quad_form2_rvv(fixed_t *out, const fixed_t *x, const fixed_t *y, const fixed_t *q, size_t n, fixed_t threshold);
+extern void fixed_vec_quad_form2_lanes_rvv(fixed_t *out, fixed_t x, fixed_t y, const fixed_t *p, size_t stride, size_t n);
+extern size_t fixed_vec_grover_oracle_sum_rvv(const fixed_t *amp, const int32_t *data, size_t n, int32_t target, int64_t *sum);
+extern size_t fixed_vec_grover_step_rvv(fixed_t *amp, const int32_t *data, size_t n, int32_t target, fixed_t two_mean, int64_t *sum);
+extern size_t fixed_vec_lindblad_visibility_rvv(fixed_t *vis, const fixed_t *surprise, const uint8_t *majorana, size_t n);
+extern void fixed_vec_xor_key_rvv(uint32_t *buf, size_t n, uint32_t key);
+
+static const fixed_vec_ops_t ops_rvv = {
+    fixed_vec_mul_rvv, fixed_vec_add_sat_rvv, fixed_vec_div_recip_rvv,
+    fixed_vec_cos_rvv, fixed_vec_cos_bam_alt_rvv, fixed_vec_quad_form2_rvv,
+    fixed_vec_quad_form2_lanes_rvv, fixed_vec_grover_oracle_sum_rvv, fixed_vec_grover_step_rvv,
+    fixed_vec_lindblad_visibility_rvv, fixed_vec_xor_key_rvv
+};
+
+#endif // FIXED_VEC_HAVE_RVV
+
+// ============================================================================
+// DESPACHO EN RUNTIME
+// ============================================================================
+
+static const fixed_vec_ops_t *active_ops = 0;
+static fixed_vec_backend_t active_backend = FIXED_VEC_BACKEND_C;
+
+static int backend_supported(fixed_vec_backend_t backend) {
+    switch (backend) {
+        case FIXED_VEC_BACKEND_C:
+            return 1;
+#ifdef FIXED_VEC_HAVE_AVX2
+        case FIXED_VEC_BACKEND_AVX2:
+            return arch_probe_vector();
+#endif
+#ifdef FIXED_VEC_HAVE_RVV
+        case FIXED_VEC_BACKEND_RVV:
+            return arch_probe_vector();
+#endif
+        default:
+            return 0;
+    }
+}
+
+int fixed_vec_set_backend(fixed_vec_backend_t backend) {
+    if (!backend_supported(backend)) return 0;
+
+    switch (backend) {
+#ifdef FIXED_VEC_HAVE_AVX2
+        case FIXED_VEC_BACKEND_AVX2: active_ops = &ops_avx2; break;
+#endif
+#ifdef FIXED_VEC_HAVE_RVV
+        case FIXED_VEC_BACKEND_RVV:  active_ops = &ops_rvv; break;
+#endif
+        default:                     active_ops = &ops_c; break;
+    }
+    active_backend = backend;
+    return 1;
+}
+
+// Primera llamada: el mejor backend que el hardware soporte
+static const fixed_vec_ops_t *vec_ops(void) {
+    if (!active_ops) {
+        if (!fixed_vec_set_backend(FIXED_VEC_BACKEND_AVX2) &&
+            !fixed_vec_set_backend(FIXED_VEC_BACKEND_RVV)) {
+            fixed_vec_set_backend(FIXED_VEC_BACKEND_C);
+        }
+    }
+    return active_ops;
+}
+
+fixed_vec_backend_t fixed_vec_get_backend(void) {
+    vec_ops();
+    return active_backend;
+}
+
+// ============================================================================
+// API PÚBLICA
+// ============================================================================
+
+void fixed_vec_mul(fixed_t *out, const fixed_t *a, const fixed_t *b, size_t n) {
+    vec_ops()->mul(out, a, b, n);
+}
+
+void fixed_vec_add_sat(fixed_t *out, const fixed_t *a, const fixed_t *b, size_t n) {
+    vec_ops()->add_sat(out, a, b, n);
+}
+
+// floor(log2(x)) para x > 0 sin __builtin_clz (evita depender de libgcc)
+static uint32_t ilog2_u32(uint32_t x) {
+    uint32_t l = 0;
+    if (x >> 16) { x >>= 16; l += 16; }
+    if (x >> 8)  { x >>= 8;  l += 8; }
+    if (x >> 4)  { x >>= 4;  l += 4; }
+    if (x >> 2)  { x >>= 2;  l += 2; }
+    if (x >> 1)  { l += 1; }
+    return l;
+}
+
+void fixed_vec_div_scalar(fixed_t *out, const fixed_t *a, fixed_t d, size_t n) {
+    if (d == 0) {
+        for (size_t i = 0; i < n; i++) out[i] = 0x7FFFFFFF; // Igual que div_q16
+        return;
+    }
+
+    // a·2^16/|d| = a·recip >> shift, con recip = ceil(2^(31+L)/|d|) en (2^30, 2^31]
+    // y shift = L + 15 (L = floor(log2|d|)). El producto |a|·recip < 2^62.
+    uint32_t dneg = (uint32_t)(d >> 31);
+    uint32_t mag = ((uint32_t)d ^ dneg) - dneg;
+    uint32_t l = ilog2_u32(mag);
+    uint64_t recip = ((1ULL << (31 + l)) + mag - 1) / mag;
+
+    vec_ops()->div_recip(out, a, n, (uint32_t)recip, l + 15, dneg);
+}
+
+void fixed_vec_cos(fixed_t *out, const fixed_t *angle, size_t n) {
+    vec_ops()->cos(out, angle, n);
+}
+
+size_t fixed_vec_quad_form2(fixed_t *out, const fixed_t *x, const fixed_t *y,
+                            const fixed_t c[2], const fixed_t m[2][2], fixed_t threshold, size_t n) {
+    const fixed_t q[6] = { c[0], c[1], m[0][0], m[0][1], m[1][0], m[1][1] };
+    return vec_ops()->quad_form2(out, x, y, q, n, threshold);
+}
+
+void fixed_vec_quad_form2_lanes(fixed_t *out, fixed_t x, fixed_t y,
+                                const fixed_t *params, size_t stride, size_t n) {
+    vec_ops()->quad_form2_lanes(out, x, y, params, stride, n);
+}
+
+size_t fixed_vec_grover_oracle_sum(const fixed_t *amp, const int32_t *data, size_t n,
+                                   int32_t target, int64_t *sum) {
+    return vec_ops()->grover_oracle_sum(amp, data, n, target, sum);
+}
+
+size_t fixed_vec_grover_step(fixed_t *amp, const int32_t *data, size_t n,
+                             int32_t target, fixed_t two_mean, int64_t *sum) {
+    return vec_ops()->grover_step(amp, data, n, target, two_mean, sum);
+}
+
+size_t fixed_vec_lindblad_visibility(fixed_t *vis, const fixed_t *surprise,
+                                     const uint8_t *majorana, size_t n) {
+    return vec_ops()->lindblad_visibility(vis, surprise, majorana, n);
+}
+
+void fixed_vec_xor_key(uint32_t *buf, size_t n, uint32_t key) {
+    vec_ops()->xor_key(buf, n, key);
+}
+
+void fixed_vec_golden(fixed_t *out, int32_t n0, size_t count) {
+    const fixed_vec_ops_t *ops = vec_ops();
+    uint32_t bam[GOLDEN_CHUNK];
+
+    // Ángulo binario de cos(πφn) acumulado en 64 bits: una suma por elemento
+    uint64_t acc = (uint64_t)(int64_t)n0 * GOLDEN_HALF_TURN_BAM64;
+    uint32_t parity = (uint32_t)n0 & 1u;
+
+    while (count > 0) {
+        size_t m = (count < GOLDEN_CHUNK) ? count : GOLDEN_CHUNK;
+        for (size_t i = 0; i < m; i++) {
+            bam[i] = (uint32_t)(acc >> 32);
+            acc += GOLDEN_HALF_TURN_BAM64;
+        }
+        ops->cos_bam_alt(out, bam, m, parity);
+
+        parity ^= (uint32_t)(m & 1u);
+        out += m;
+        count -= m;
+    }
+}
@@ -0,0 +1,89 @@
+#include "../include/qcore_forensic.h"
+#include "../include/qcore_security.h"
+#include "../include/qcore_arch.h"
+
+_Static_assert(sizeof(forensic_record_t) == 24, "Formato fijo: actualizar tools/forensic_decode.py");
+_Static_assert(sizeof(forensic_log_t) == 16 + 24 * FORENSIC_LOG_RECORDS, "Formato fijo de la cabecera");
+_Static_assert((FORENSIC_LOG_RECORDS & (FORENSIC_LOG_RECORDS - 1)) == 0, "FORENSIC_LOG_RECORDS debe ser potencia de 2");
+
+forensic_log_t* forensic_log_region(void) {
+#ifdef QCORE_TEST_ENV
+    // En test environment, usamos un buffer estático para evitar segfault
+    static forensic_log_t forensic_log_buffer;
+    return &forensic_log_buffer;
+#else
+    // En hardware real, escribimos a la dirección física
+    return (forensic_log_t*)FORENSIC_MEM_ADDR;
+#endif
+}
+
+void forensic_log_reset(void) {
+    forensic_log_t *log = forensic_log_region();
+    __atomic_store_n(&log->magic, 0, __ATOMIC_RELAXED);
+    for (uint32_t k = 0; k < FORENSIC_LOG_RECORDS; k++) {
+        forensic_record_t *r = &log->rec[k];
+        r->seq = 0;
+        r->tick = 0;
+        r->surprise = 0;
+        r->cycle = 0;
+        r->majorana = 0;
+        r->state = 0;
+        r->reserved = 0;
+    }
+    log->head = 0;
+    log->record_size = sizeof(forensic_record_t);
+    log->capacity = FORENSIC_LOG_RECORDS;
+    __atomic_store_n(&log->magic, FORENSIC_LOG_MAGIC, __ATOMIC_RELEASE);
+}
+
+void forensic_log_init(void) {
+    forensic_log_t *log = forensic_log_region();
+    if (__atomic_load_n(&log->magic, __ATOMIC_ACQUIRE) != FORENSIC_LOG_MAGIC ||
+        log->record_size != sizeof(forensic_record_t) || log->capacity != FORENSIC_LOG_RECORDS) {
+        forensic_log_reset();
+    }
+}
+
+uint64_t forensic_log_append(fixed_t surprise, majorana_byte_t q_state, uint8_t state, uint32_t cycle) {
+    forensic_log_t *log = forensic_log_region();
+    if (__atomic_load_n(&log->magic, __ATOMIC_ACQUIRE) != FORENSIC_LOG_MAGIC) forensic_log_init();
+
+    uint64_t n = __atomic_fetch_add(&log->head, 1, __ATOMIC_RELAXED);
+    forensic_record_t *r = &log->rec[n & (FORENSIC_LOG_RECORDS - 1)];
+    const uint32_t stamp = (uint32_t)(n + 1);
+
+    // Tomar el registro antes de tocar los campos. Como mucho dos vueltas:
+    // el CAS solo falla si otro escritor tomó o publicó el registro.
+    uint32_t old = __atomic_load_n(&r->seq, __ATOMIC_RELAXED);
+    do {
+        // En manos de otro escritor, o con un sello igual o más reciente
+        if (old == FORENSIC_SEQ_WRITING || (int32_t)(old - stamp) >= 0) return n;
+    } while (!__atomic_compare_exchange_n(&r->seq, &old, FORENSIC_SEQ_WRITING, 0,
+                                          __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&r->tick, get_hardware_tick(), __ATOMIC_RELAXED);
+    __atomic_store_n(&r->surprise, surprise, __ATOMIC_RELAXED);
+    __atomic_store_n(&r->cycle, cycle, __ATOMIC_RELAXED);
+    __atomic_store_n(&r->majorana, q_state.raw, __ATOMIC_RELAXED);
+    __atomic_store_n(&r->state, state, __ATOMIC_RELAXED);
+    __atomic_store_n(&r->seq, stamp, __ATOMIC_RELEASE);
+    return n;
+}
+
+int forensic_log_read(uint64_t n, forensic_record_t *out) {
+    forensic_log_t *log = forensic_log_region();
+    const forensic_record_t *r = &log->rec[n & (FORENSIC_LOG_RECORDS - 1)];
+    const uint32_t want = (uint32_t)(n + 1);
+
+    if (__atomic_load_n(&r->seq, __ATOMIC_ACQUIRE) != want) return -1;
+    out->tick = __atomic_load_n(&r->tick, __ATOMIC_RELAXED);
+    out->surprise = __atomic_load_n(&r->surprise, __ATOMIC_RELAXED);
+    out->cycle = __atomic_load_n(&r->cycle, __ATOMIC_RELAXED);
+    out->majorana = __atomic_load_n(&r->majorana, __ATOMIC_RELAXED);
+    out->state = __atomic_load_n(&r->state, __ATOMIC_RELAXED);
+    out->reserved = 0;
+    out->seq = want;
+    // El sello no cambió mientras se copiaban los campos
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return (__atomic_load_n(&r->seq, __ATOMIC_RELAXED) == want) ? 0 : -1;
+}
@@ -1,13 +1,9 @@
 #include "../include/qcore_lindblad.h"
 #include "../include/qcore_math.h"
+#include "../include/qcore_fixed_vec.h"
 
-// Aliases para compatibilidad
-#define fixed_mul mult_q16
-#define fixed_div div_q16
-
-// Umbral para transición Bosónico → Fermiónico
-// Si visibility_score < 0.3, consideramos el estado como Fermiónico
-#define FERMIONIC_THRESHOLD 0x00004CCC  // 0.3 en Q16.16
+// Visibilidades calculadas de golpe por lindblad_update_batch (en pila)
+#define LINDBLAD_BATCH_CHUNK 32
 
 void lindblad_init(LindblادState* state) {
     state->bf_axis = int_to_fixed(1);  // Inicialmente Bosónico (+1)
@@ -20,6 +16,8 @@ void lindblad_init(LindblادState* state) {
     
     // Γ_π = φ² * Γ_φ ≈ 2.618
     state->gamma_pi = PHI_SQUARED_FIXED;
+
+    golden_seq_init(&state->golden, 0);
 }
 
 void lindblad_update(LindblادState* state, fixed_t surprise, uint8_t majorana_state) {
@@ -29,78 +27,43 @@ void lindblad_update(LindblادState* state, fixed_t surprise, uint8_t majorana_
     // PASO 1: Calcular bf_axis usando el Operador Áureo O_n
     // ========================================================================
     // O_n = cos(π n) * cos(π φ n)
-    // 
-    // Simplificación: Usamos el cycle_count como 'n'
-    // cos(π n) alterna entre +1 y -1 cada ciclo (paridad)
-    // cos(π φ n) oscila con período áureo
-    
-    fixed_t cos_pi_n = (state->cycle_count % 2 == 0) ? int_to_fixed(1) : int_to_fixed(-1);
-    
-    // Para cos(π φ n), aproximamos usando una tabla de lookup o Taylor
-    // Simplificación: Usamos una oscilación modulada por φ
-    // cos(π φ n) ≈ cos(π * 1.618 * n) 
-    // Período ≈ 2/φ ≈ 1.236 ciclos
-    
-    // Aproximación simple: Oscilación cada ~5 ciclos (período áureo escalado)
-    uint32_t phi_phase = (state->cycle_count * 1618) / 1000;  // Escala por φ
-    // Convertir a radianes: (phi_phase % 360) * PI / 180
-    fixed_t angle_deg = int_to_fixed(phi_phase % 360);
-    fixed_t angle_rad = fixed_mul(angle_deg, PI_FIXED) / 180;
-    fixed_t cos_pi_phi_n = fixed_cos(angle_rad);
-    
-    // O_n = cos(π n) * cos(π φ n)
-    state->bf_axis = fixed_mul(cos_pi_n, cos_pi_phi_n);
+    //
+    // Usamos el cycle_count como 'n'. El iterador avanza O_n por rotación
+    // en cada ciclo, así que ya no hace falta la aproximación en grados.
+    state->bf_axis = golden_seq_next(&state->golden);
     
     
     // ========================================================================
-    // PASO 2: Modular visibility_score por la sorpresa
+    // PASO 2: Modular visibility_score por la sorpresa y el majorana_state
     // ========================================================================
     // Lógica:
     // - Sorpresa alta → Decoherencia → Visibilidad baja (Fermiónico)
     // - Sorpresa baja → Coherencia → Visibilidad alta (Bosónico)
-    
-    // Normalizamos la sorpresa a [0, 1]
-    // Asumimos MAX_ENTROPY_TOLERANCE = 393216 (6.0 en Q16.16)
-    #define MAX_SURPRISE 393216
-    
-    fixed_t normalized_surprise = surprise;
-    if (normalized_surprise > MAX_SURPRISE) {
-        normalized_surprise = MAX_SURPRISE;
-    }
-    
-    // visibility = 1 - (surprise / MAX_SURPRISE)
-    fixed_t surprise_factor = fixed_div(normalized_surprise, MAX_SURPRISE);
-    state->visibility_score = int_to_fixed(1) - surprise_factor;
-    
-    // Asegurar que visibility_score esté en [0, 1]
-    if (state->visibility_score < 0) {
-        state->visibility_score = 0;
-    }
-    
-    
-    // ========================================================================
-    // PASO 3: Aplicar influencia del majorana_state
-    // ========================================================================
-    // Si el QPU colapsó a 1 (Partícula), aumentamos la polaridad (Fermiónico)
-    // Si colapsó a 0 (Onda), aumentamos la coherencia (Bosónico)
-    
-    if (majorana_state == 1) {
-        // Colapso → Reducir visibilidad (Partícula es localizada)
-        fixed_t penalty = int_to_fixed(1) / 10;  // -10% de visibilidad
-        state->visibility_score -= penalty;
-    } else {
-        // Coherencia → Aumentar visibilidad (Onda es extendida)
-        fixed_t bonus = int_to_fixed(1) / 20;  // +5% de visibilidad
-        state->visibility_score += bonus;
-    }
-    
-    // Clamp final
-    if (state->visibility_score < 0) {
-        state->visibility_score = 0;
+    // - Colapso a 1 (Partícula, localizada) → -10% de visibilidad
+    // - Colapso a 0 (Onda, extendida)       → +5% de visibilidad
+    //
+    // visibility = clamp(1 - surprise / MAX_SURPRISE ± ajuste, 0, 1), con la
+    // división por MAX_SURPRISE como producto por su recíproco. Es el mismo
+    // kernel que usa el banco de filtros con un solo canal.
+    fixed_vec_lindblad_visibility(&state->visibility_score, &surprise, &majorana_state, 1);
+}
+
+uint32_t lindblad_update_batch(LindblادState* state, const fixed_t* surprise,
+                               const uint8_t* majorana_state, size_t n) {
+    // La visibilidad de cada ciclo no depende de la anterior: la ráfaga se
+    // evalúa en bloques vectoriales y el estado final es el del último ciclo
+    uint32_t laundered = 0;
+    fixed_t vis[LINDBLAD_BATCH_CHUNK];
+    for (size_t i = 0; i < n; i += LINDBLAD_BATCH_CHUNK) {
+        size_t m = (n - i < LINDBLAD_BATCH_CHUNK) ? n - i : LINDBLAD_BATCH_CHUNK;
+        laundered += (uint32_t)fixed_vec_lindblad_visibility(vis, surprise + i, majorana_state + i, m);
+        state->visibility_score = vis[m - 1];
     }
-    if (state->visibility_score > int_to_fixed(1)) {
-        state->visibility_score = int_to_fixed(1);
+    for (size_t i = 0; i < n; i++) {
+        state->cycle_count++;
+        state->bf_axis = golden_seq_next(&state->golden);
     }
+    return laundered;
 }
 
 fixed_t lindblad_get_visibility(const LindblادState* state) {
@@ -112,3 +75,35 @@ int lindblad_should_launder(const LindblادState* state) {
     // la información debe ser "lavada" (protegida/invisible)
     return (state->visibility_score < FERMIONIC_THRESHOLD) ? 1 : 0;
 }
+
+// ============================================================================
+// BANCO DE FILTROS
+// ============================================================================
+
+void lindblad_bank_init(lindblad_bank_t *bank, fixed_t *visibility, uint32_t n_channels) {
+    bank->n_channels = n_channels;
+    bank->cycle_count = 0;
+    bank->phase = 0;
+    bank->bf_axis = int_to_fixed(1);
+    bank->gamma_phi = int_to_fixed(1);
+    bank->gamma_pi = PHI_SQUARED_FIXED;
+    bank->visibility = visibility;
+    for (uint32_t c = 0; c < n_channels; c++) visibility[c] = int_to_fixed(1);
+}
+
+uint32_t lindblad_bank_update(lindblad_bank_t *bank, const fixed_t *surprise,
+                              const uint8_t *majorana_state) {
+    // O_n = cos(πn)·cos(πφn): la paridad alterna el signo y el acumulador
+    // avanza frac(φ/2) de giro por ciclo (igual que calculate_golden_operator)
+    bank->cycle_count++;
+    bank->phase += GOLDEN_HALF_TURN_BAM64;
+    fixed_t geometry = fixed_cos_bam((uint32_t)(bank->phase >> 32));
+    bank->bf_axis = (bank->cycle_count & 1) ? -geometry : geometry;
+
+    return (uint32_t)fixed_vec_lindblad_visibility(bank->visibility, surprise, majorana_state,
+                                                   bank->n_channels);
+}
+
+int lindblad_bank_should_launder(const lindblad_bank_t *bank, uint32_t channel) {
+    return (bank->visibility[channel] < FERMIONIC_THRESHOLD) ? 1 : 0;
+}
@@ -1,6 +1,6 @@
 #include "../include/qcore_math.h"
 
-// Taylor series constants in Q16.16
+// Constantes en Q16.16
 #define ONE_FIXED 0x00010000
 #define HALF_FIXED 0x00008000 // 0.5
 
@@ -21,36 +21,91 @@ fixed_t div_q16(fixed_t a, fixed_t b) {
     return (fixed_t)(((int64_t)a << 16) / b);
 }
 
-// Simple range reduction to [-PI, PI]
+// Raíz cuadrada entera de 64 bits (método bit a bit, sin divisiones)
+uint32_t isqrt_u64(uint64_t v) {
+    uint64_t res = 0;
+    uint64_t bit = 1ULL << 62;
+    while (bit > v) bit >>= 2;
+    while (bit) {
+        if (v >= res + bit) {
+            v -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)res;
+}
+
+fixed_t fixed_sqrt(fixed_t x) {
+    if (x <= 0) return 0;
+    return (fixed_t)isqrt_u64((uint64_t)x << 16);
+}
+
+// e^-x para x >= 0: 2^-k · e^-y con x·log2(e) = k + y/ln2, y en [0, ln2).
+// e^-y por Horner con 5 términos de Taylor (error < 2e-4).
+#define LOG2E_Q16 94548  // log2(e) en Q16.16
+#define LN2_Q16   45426  // ln(2) en Q16.16
+
+fixed_t fixed_exp_neg(fixed_t x) {
+    if (x <= 0) return 0x00010000;
+
+    int64_t t = ((int64_t)x * LOG2E_Q16) >> 16;
+    int64_t k = t >> 16;
+    if (k >= 17) return 0; // Por debajo de 1 LSB
+
+    int64_t y = ((t & 0xFFFF) * LN2_Q16) >> 16;
+    int64_t p = 0x10000 - y / 5;
+    p = 0x10000 - ((y * p) >> 16) / 4;
+    p = 0x10000 - ((y * p) >> 16) / 3;
+    p = 0x10000 - ((y * p) >> 16) / 2;
+    p = 0x10000 - ((y * p) >> 16);
+    return (fixed_t)(p >> k);
+}
+
+// 2π en Q16.16 (para volver de BAM a radianes)
+#define TWO_PI_FIXED 411775
+
+// Reducción de rango en tiempo constante: multiplicar por 1/2π y dejar que
+// el desbordamiento de 32 bits haga la máscara. Un giro completo = 2^32.
+uint32_t fixed_to_bam(fixed_t angle) {
+    return (uint32_t)(((int64_t)angle * FIXED_RAD_TO_BAM_Q16 + 0x8000) >> 16);
+}
+
+// Range reduction to [-PI, PI) (constant time, vía BAM)
 fixed_t mod_2pi(fixed_t angle) {
-    fixed_t two_pi = mult_q16(PI_FIXED, int_to_fixed(2));
-    while (angle > PI_FIXED) angle -= two_pi;
-    while (angle < -PI_FIXED) angle += two_pi;
-    return angle;
+    int32_t turns = (int32_t)fixed_to_bam(angle);
+    return (fixed_t)(((int64_t)turns * TWO_PI_FIXED) >> 32);
+}
+
+fixed_t fixed_sin_bam(uint32_t bam) {
+    return qcore_q30_to_fixed(qcore_sin_bam_q30(bam));
+}
+
+fixed_t fixed_cos_bam(uint32_t bam) {
+    return fixed_sin_bam(bam + 0x40000000u); // cos(x) = sin(x + π/2)
 }
 
-// Simple Cosine approximation (Maclaurin series)
+// Coseno/Seno Q16.16 (tabla de cuarto de onda)
+// Cota de error: la interpolación aporta < 0.32 LSB y el redondeo final
+// 0.5 LSB, de modo que |err| <= 1 LSB (1.5e-5) frente al coseno real del
+// ángulo recibido. Para |angle| cercano a 2^15 rad, el redondeo de 1/2π
+// añade hasta 1 LSB más (|err| <= 2 LSB). La serie 1 - x²/2 + x⁴/24 que
+// había antes se desviaba ~0.12 en ±π.
 fixed_t fixed_cos(fixed_t angle) {
-    angle = mod_2pi(angle);
-    
-    // x^2
-    fixed_t x2 = mult_q16(angle, angle);
-    // x^2 / 2
-    fixed_t term2 = mult_q16(x2, HALF_FIXED);
-    
-    // For better accuracy with large angles in [-PI, PI], we might need x^4/24 term
-    // But for "Conceptual" code, just adding range reduction helps significantly.
-    // However, 1 - x^2/2 is only good for small x.
-    // Let's add x^4 / 24.
-    // 24 in fixed is 24 << 16 = 0x00180000
-    // 1/24 in fixed approx 0x00000AAA (0.04166)
-    
-    #define INV_24_FIXED 0x00000AAA
-    
-    fixed_t x4 = mult_q16(x2, x2);
-    fixed_t term4 = mult_q16(x4, INV_24_FIXED);
-    
-    return ONE_FIXED - term2 + term4;
+    return fixed_cos_bam(fixed_to_bam(angle));
+}
+
+fixed_t fixed_sin(fixed_t angle) {
+    return fixed_sin_bam(fixed_to_bam(angle));
+}
+
+// Ángulo binario de cos(πφn): πφn / 2π = n·φ/2 giros. Se calcula como
+// producto BAM de 64 bits, sin pasar por radianes, así que no hay desborde
+// ni deriva con n grande.
+static inline uint32_t golden_bam(int32_t n) {
+    return (uint32_t)(((uint64_t)(int64_t)n * GOLDEN_HALF_TURN_BAM64) >> 32);
 }
 
 // Operador Áureo: Ón = cos(πn) * cos(πφn)
@@ -59,16 +114,63 @@ fixed_t calculate_golden_operator(int32_t n) {
     fixed_t parity = (n % 2 == 0) ? ONE_FIXED : -ONE_FIXED;
     
     // Geometría global cuasiperiódica (cos(πφn))
-    fixed_t n_fixed = int_to_fixed(n);
-    fixed_t phi_n = mult_q16(PHI, n_fixed);
-    fixed_t phase = mult_q16(PI_FIXED, phi_n);
-    
-    // Range reduction is now handled inside fixed_cos
-    fixed_t geometry = fixed_cos(phase); 
+    fixed_t geometry = fixed_cos_bam(golden_bam(n));
     
     return mult_q16(parity, geometry);
 }
 
+// ============================================================================
+// ITERADOR INCREMENTAL DEL OPERADOR ÁUREO
+// ============================================================================
+// cos(πφ(n+1)) sale de rotar (cos(πφn), sin(πφn)) un ángulo fijo πφ:
+//   c' = c·cos(πφ) - s·sin(πφ)
+//   s' = s·cos(πφ) + c·sin(πφ)
+// Cuatro multiplicaciones por paso, sin coseno. El estado vive en Q2.30 y
+// cada GOLDEN_SEQ_RENORM_PERIOD pasos se re-siembra desde el ángulo exacto
+// para que el redondeo no acumule deriva de fase ni de magnitud.
+
+#define GOLDEN_ROT_COS_Q30  389097075   // cos(πφ) ≈  0.36236
+#define GOLDEN_ROT_SIN_Q30 -1000762195  // sin(πφ) ≈ -0.93204
+
+static void golden_seq_reseed(golden_seq_t *seq) {
+    uint32_t bam = golden_bam(seq->n);
+    seq->cos_q30 = qcore_sin_bam_q30(bam + 0x40000000u);
+    seq->sin_q30 = qcore_sin_bam_q30(bam);
+    seq->since_renorm = 0;
+}
+
+void golden_seq_init(golden_seq_t *seq, int32_t n0) {
+    seq->n = n0;
+    golden_seq_reseed(seq);
+}
+
+fixed_t golden_seq_value(const golden_seq_t *seq) {
+    fixed_t geometry = qcore_q30_to_fixed(seq->cos_q30);
+    return (seq->n & 1) ? -geometry : geometry;
+}
+
+fixed_t golden_seq_next(golden_seq_t *seq) {
+    seq->n = (int32_t)((uint32_t)seq->n + 1u);
+
+    if (++seq->since_renorm >= GOLDEN_SEQ_RENORM_PERIOD) {
+        golden_seq_reseed(seq);
+    } else {
+        int64_t c = seq->cos_q30;
+        int64_t s = seq->sin_q30;
+        seq->cos_q30 = (int32_t)((c * GOLDEN_ROT_COS_Q30 - s * GOLDEN_ROT_SIN_Q30 + (1 << 29)) >> 30);
+        seq->sin_q30 = (int32_t)((s * GOLDEN_ROT_COS_Q30 + c * GOLDEN_ROT_SIN_Q30 + (1 << 29)) >> 30);
+    }
+
+    return golden_seq_value(seq);
+}
+
+fixed_t golden_seq_seek(golden_seq_t *seq, int32_t n) {
+    if (n == seq->n) return golden_seq_value(seq);
+    if (n == (int32_t)((uint32_t)seq->n + 1u)) return golden_seq_next(seq);
+    golden_seq_init(seq, n);
+    return golden_seq_value(seq);
+}
+
 // Rule 3.1: Explicit Lagrangian Computation
 LagrangianState compute_lagrangian(fixed_t u, fixed_t v) {
     LagrangianState state;
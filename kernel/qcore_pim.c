@@ -9,3 +9,20 @@ LaminarCell pim_tensor_y[TENSOR_BASE_N];
 
 __attribute__((section(".smop_laminar_mem"), aligned(4096)))
 LaminarCell pim_tensor_z[TENSOR_BASE_N];
+
+#if defined(ARCH_RISCV) && !defined(QCORE_TEST_ENV)
+
+typedef void (*pim_update_fn)(LaminarCell* core, uint32_t count, float golden_prior);
+
+static pim_update_fn pim_update_impl = smopsys_bayesian_update_scalar;
+
+// mstatus.FS (y VS si hay 'V') ya los activa _start (kernel/entry.S)
+void pim_init(void) {
+    pim_update_impl = arch_probe_vector() ? smopsys_bayesian_update_rvv : smopsys_bayesian_update_scalar;
+}
+
+void smopsys_bayesian_update(LaminarCell* core, uint32_t count, float golden_prior) {
+    pim_update_impl(core, count, golden_prior);
+}
+
+#endif
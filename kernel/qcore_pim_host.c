@@ -0,0 +1,161 @@
+#include "../include/qcore_pim.h"
+#include <pthread.h>
+#include <unistd.h>
+
+#if defined(ARCH_X86_64)
+    #include <immintrin.h>
+    #define PIM_HAVE_AVX2
+#endif
+
+/**
+ * Actualización PIM en el host (solo libqcore.so).
+ * Misma semántica que smopsys_bayesian_update_scalar (qcore_pim_asm.S):
+ *   weight ← ((golden_prior · weight) · probability) / 1.618033f
+ * redondeando a float en cada paso. La variante AVX2 divide con vdivps para
+ * ser idéntica bit a bit a la C: con el recíproco (como la RVV) sería hasta
+ * 1 ULP distinta, y ni una corrección FMA la hace exacta para este divisor.
+ */
+
+static int pim_use_avx2 = -1;
+
+static void pim_probe(void) {
+#ifdef PIM_HAVE_AVX2
+    if (pim_use_avx2 < 0) pim_use_avx2 = arch_probe_vector();
+#else
+    pim_use_avx2 = 0;
+#endif
+}
+
+void pim_init(void) {
+    pim_probe();
+}
+
+int pim_set_simd(int enable) {
+    pim_use_avx2 = -1;
+    pim_probe();
+    if (!enable) pim_use_avx2 = 0;
+    return pim_use_avx2;
+}
+
+void smopsys_bayesian_update_c(LaminarCell* core, uint32_t count, float golden_prior) {
+    const float threshold = PIM_ENTROPY_THRESHOLD;
+    for (uint32_t i = 0; i < count; i++) {
+        float posterior = golden_prior * core[i].weight;
+        posterior = posterior * core[i].probability;
+        core[i].weight = posterior / threshold;
+    }
+}
+
+#ifdef PIM_HAVE_AVX2
+// Grupos de 8 celdas; retorna la primera celda sin procesar
+__attribute__((target("avx2")))
+static uint32_t pim_update_avx2_body(LaminarCell* core, uint32_t count, float golden_prior) {
+    const __m256 prior = _mm256_set1_ps(golden_prior);
+    const __m256 threshold = _mm256_set1_ps(PIM_ENTROPY_THRESHOLD);
+    const __m256i lane0 = _mm256_setr_epi32(-1, 0, 0, 0, -1, 0, 0, 0); // weight de cada celda
+
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        float *base = &core[i].weight;
+        // Dos celdas por registro: [w p m m | w p m m]
+        __m256 a = _mm256_loadu_ps(base);
+        __m256 b = _mm256_loadu_ps(base + 8);
+        __m256 c = _mm256_loadu_ps(base + 16);
+        __m256 d = _mm256_loadu_ps(base + 24);
+
+        // Desentrelazado: W = [w0 w2 w4 w6 | w1 w3 w5 w7], P igual
+        __m256 ab = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 cd = _mm256_shuffle_ps(c, d, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 w = _mm256_shuffle_ps(ab, cd, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 p = _mm256_shuffle_ps(ab, cd, _MM_SHUFFLE(3, 1, 3, 1));
+
+        __m256 r = _mm256_mul_ps(prior, w);
+        r = _mm256_mul_ps(r, p);
+        r = _mm256_div_ps(r, threshold);
+
+        // Solo se escribe weight: probability y metadata quedan intactos
+        _mm256_maskstore_ps(base, lane0, _mm256_permute_ps(r, 0x00));
+        _mm256_maskstore_ps(base + 8, lane0, _mm256_permute_ps(r, 0x55));
+        _mm256_maskstore_ps(base + 16, lane0, _mm256_permute_ps(r, 0xAA));
+        _mm256_maskstore_ps(base + 24, lane0, _mm256_permute_ps(r, 0xFF));
+    }
+    return i;
+}
+#endif
+
+void smopsys_bayesian_update_avx2(LaminarCell* core, uint32_t count, float golden_prior) {
+    pim_probe();
+    uint32_t done = 0;
+#ifdef PIM_HAVE_AVX2
+    if (pim_use_avx2) done = pim_update_avx2_body(core, count, golden_prior);
+#endif
+    smopsys_bayesian_update_c(core + done, count - done, golden_prior);
+}
+
+void smopsys_bayesian_update(LaminarCell* core, uint32_t count, float golden_prior) {
+    smopsys_bayesian_update_avx2(core, count, golden_prior);
+}
+
+// ============================================================================
+// REPARTO ENTRE HILOS
+// ============================================================================
+
+typedef struct {
+    LaminarCell *const *tensors;
+    uint32_t count;
+    float golden_prior;
+    uint64_t c0, c1;    // Rango en el espacio aplanado tensor · count + celda
+} pim_job_t;
+
+static void *pim_worker(void *arg) {
+    pim_job_t *job = (pim_job_t *)arg;
+    uint64_t c = job->c0;
+    while (c < job->c1) {
+        uint64_t t = c / job->count;
+        uint64_t cell = c % job->count;
+        uint64_t end = (t + 1) * job->count;
+        if (end > job->c1) end = job->c1;
+        smopsys_bayesian_update(job->tensors[t] + cell, (uint32_t)(end - c), job->golden_prior);
+        c = end;
+    }
+    return 0;
+}
+
+uint32_t pim_update_tensors(LaminarCell *const *tensors, uint32_t n_tensors, uint32_t count,
+                            float golden_prior, uint32_t n_threads) {
+    pim_probe();
+    const uint64_t total = (uint64_t)n_tensors * count;
+
+    if (n_threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        n_threads = (online > 0) ? (uint32_t)online : 1;
+    }
+    uint64_t by_size = total / PIM_PARALLEL_MIN_CELLS;
+    uint32_t nt = (n_threads > PIM_MAX_THREADS) ? PIM_MAX_THREADS : n_threads;
+    if (nt > by_size) nt = (uint32_t)by_size;
+    if (nt == 0) nt = 1;
+
+    pthread_t threads[PIM_MAX_THREADS];
+    pim_job_t jobs[PIM_MAX_THREADS];
+    int spawned[PIM_MAX_THREADS];
+
+    // Rangos contiguos alineados a 8 celdas (grupos AVX2 completos)
+    for (uint32_t w = 0; w < nt; w++) {
+        jobs[w].tensors = tensors;
+        jobs[w].count = count;
+        jobs[w].golden_prior = golden_prior;
+        jobs[w].c0 = (w == 0) ? 0 : (total * w / nt) & ~(uint64_t)7;
+        jobs[w].c1 = (w + 1 == nt) ? total : (total * (w + 1) / nt) & ~(uint64_t)7;
+        spawned[w] = 0;
+    }
+    // Si no se puede crear un hilo, su rango se ejecuta en el llamador
+    for (uint32_t w = 1; w < nt; w++) {
+        spawned[w] = (pthread_create(&threads[w], 0, pim_worker, &jobs[w]) == 0);
+    }
+    pim_worker(&jobs[0]);
+    for (uint32_t w = 1; w < nt; w++) {
+        if (spawned[w]) pthread_join(threads[w], 0);
+        else pim_worker(&jobs[w]);
+    }
+    return nt;
+}
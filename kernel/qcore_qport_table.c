@@ -0,0 +1,174 @@
+#include "../include/qcore_port.h"
+#include "../include/qcore_uart.h"
+#include "../include/qcore_viz.h"
+#include "../include/qcore_arch.h"
+#include "../include/qcore_trap.h"
+
+/**
+ * Tabla de puertos MMQI (Phase 6)
+ * Cada placa es un quantum_port_t independiente con un solo latch: como
+ * mucho un colapso en vuelo por placa. El throughput agregado crece con el
+ * número de placas porque sus latencias se solapan.
+ */
+
+#define QPORT_CALIBRATE_TIMEOUT   10000000
+#define QPORT_WAKE_TIMEOUT_TICKS  1000000
+
+typedef struct {
+    quantum_port_t *regs;
+    uint32_t index;          // Ventana MMIO (QPORT_AT(index))
+    uint32_t phase_zero;     // PHASE_LOCK tras CMD_CALIBRATE
+    uint8_t raw[QPORT_BOARD_DEPTH];
+    uint32_t tag[QPORT_BOARD_DEPTH];
+    uint32_t head;
+    uint32_t count;
+    uint32_t issued;         // raw[head] está en el QPU
+} qport_board_t;
+
+static qport_board_t boards[QPORT_MAX_BOARDS];
+static uint32_t board_count = 0;
+static uint32_t rr_cursor = 0;
+static uint32_t next_tag = 0;
+static qport_dispatch_t dispatch_policy = QPORT_DISPATCH_ROUND_ROBIN;
+
+#define BOARD_SLOT(b, i) (((b)->head + (i)) % QPORT_BOARD_DEPTH)
+
+// Igual que bridge_collapse_isr: DATA_READY es de nivel, se silencia la fuente.
+// La placa 0 comparte línea con el bridge y conserva bridge_collapse_isr,
+// que además marca la llegada para calibrar la ventana de spin.
+static void qport_table_isr(uint32_t irq) {
+    plic_disable_irq(irq);
+}
+
+uint32_t qport_table_discover(void) {
+    board_count = 0;
+    rr_cursor = 0;
+
+    // 1. Sondeo por firma y purga térmica en paralelo
+    for (uint32_t i = 0; i < QPORT_MAX_BOARDS; i++) {
+        quantum_port_t *port = QPORT_AT(i);
+        if (port->MAGIC_SIG != QPORT_MAGIC_SIG) continue;
+        qport_command_at(port, CMD_CALIBRATE);
+        boards[board_count] = (qport_board_t){ .regs = port, .index = i };
+        board_count++;
+    }
+
+    // 2. Cada placa fija su propia fase cero; las que no enfrían se descartan
+    uint32_t online = 0;
+    for (uint32_t b = 0; b < board_count; b++) {
+        quantum_port_t *port = boards[b].regs;
+        int timeout = QPORT_CALIBRATE_TIMEOUT;
+        while (!(port->STATUS_REG & STATUS_TEMP_OK) && --timeout > 0) {
+            cpu_relax_yield();
+        }
+        if (timeout == 0) {
+            uart_puts(ANSI_COLOR_RED "[ QPU BOARD THERMAL OVERLOAD ]\n\r" ANSI_COLOR_RESET);
+            continue;
+        }
+        boards[b].phase_zero = port->PHASE_LOCK;
+        trap_register_irq(QPORT_COLLAPSE_IRQ + boards[b].index,
+                          boards[b].index == 0 ? bridge_collapse_isr : qport_table_isr);
+        boards[online++] = boards[b];
+    }
+    board_count = online;
+    return board_count;
+}
+
+uint32_t qport_table_boards(void) {
+    return board_count;
+}
+
+void qport_table_set_policy(qport_dispatch_t policy) {
+    dispatch_policy = policy;
+}
+
+uint32_t qport_table_phase_zero(uint32_t board) {
+    for (uint32_t b = 0; b < board_count; b++) {
+        if (boards[b].index == board) return boards[b].phase_zero;
+    }
+    return 0;
+}
+
+// Lanza la propuesta de cabeza si la placa está libre
+static void board_issue(qport_board_t *b) {
+    if (b->issued || b->count == 0) return;
+    b->regs->DATA_LATCH = (uint32_t)(b->raw[b->head] & 0x7F);
+    qport_command_at(b->regs, CMD_PREPARE_STATE);
+    b->issued = 1;
+}
+
+static qport_board_t *pick_board(void) {
+    qport_board_t *best = 0;
+    for (uint32_t k = 0; k < board_count; k++) {
+        qport_board_t *b = &boards[(rr_cursor + k) % board_count];
+        if (b->count == QPORT_BOARD_DEPTH) continue;
+        if (dispatch_policy == QPORT_DISPATCH_ROUND_ROBIN) return b;
+        // Empates: gana la primera desde el cursor, así la carga rota
+        if (!best || b->count < best->count) best = b;
+    }
+    return best;
+}
+
+int qport_table_submit(uint8_t phase, uint32_t *tag) {
+    qport_board_t *b = pick_board();
+    if (!b) return -1;
+
+    uint32_t slot = BOARD_SLOT(b, b->count);
+    b->raw[slot] = (uint8_t)(phase & 0x7F);
+    b->tag[slot] = next_tag;
+    b->count++;
+    if (tag) *tag = next_tag;
+    next_tag++;
+    rr_cursor = (uint32_t)(b - boards + 1) % board_count;
+
+    board_issue(b);
+    return 0;
+}
+
+size_t qport_table_gather(qport_result_t *out, size_t max) {
+    size_t n = 0;
+    for (uint32_t k = 0; k < board_count && n < max; k++) {
+        qport_board_t *b = &boards[k];
+        if (!b->issued || !(b->regs->STATUS_REG & STATUS_DATA_READY)) continue;
+
+        out[n].tag = b->tag[b->head];
+        out[n].board = b->index;
+        out[n].cycle.raw = (uint8_t)(b->regs->DATA_LATCH & 0xFF);
+        n++;
+
+        b->head = (b->head + 1) % QPORT_BOARD_DEPTH;
+        b->count--;
+        b->issued = 0;
+        board_issue(b); // La placa vuelve a trabajar antes de devolver el resultado
+    }
+    return n;
+}
+
+int qport_table_complete(qport_result_t *out) {
+    if (qport_table_inflight() == 0) return -1;
+    if (qport_table_gather(out, 1)) return 0;
+
+    // Mismo esquema que bridge_wait_collapse: MIE apagado entre la
+    // comprobación y el wfi; despierta la IRQ de cualquier placa ocupada.
+    unsigned long flags = trap_irq_disable();
+    while (qport_table_gather(out, 1) == 0) {
+        for (uint32_t k = 0; k < board_count; k++) {
+            if (boards[k].issued) plic_enable_irq(QPORT_COLLAPSE_IRQ + boards[k].index);
+        }
+        clint_arm_timer(QPORT_WAKE_TIMEOUT_TICKS);
+        trap_wfi();
+        trap_irq_window();
+    }
+    for (uint32_t k = 0; k < board_count; k++) {
+        plic_disable_irq(QPORT_COLLAPSE_IRQ + boards[k].index);
+    }
+    clint_disarm_timer();
+    trap_irq_restore(flags);
+    return 0;
+}
+
+uint32_t qport_table_inflight(void) {
+    uint32_t total = 0;
+    for (uint32_t k = 0; k < board_count; k++) total += boards[k].count;
+    return total;
+}
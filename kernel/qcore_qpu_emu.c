@@ -0,0 +1,245 @@
+#include "../include/qcore_qpu_emu.h"
+#include "../include/qcore_port.h"
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+/**
+ * Emulador de QPU para el entorno de test del host.
+ * El registro CONTROL_REG hace de buzón: el hilo lo intercambia por 0 al
+ * aceptar un comando. STATUS_REG se modifica con operaciones atómicas porque
+ * qport_command() también baja DATA_READY desde el lado de la CPU. running y
+ * las estadísticas se comparten con el hilo del test: también atómicos.
+ */
+
+// Por debajo de este umbral la latencia se espera en spin (nanosleep es demasiado grueso)
+#define QPU_EMU_SPIN_NS 50000
+
+// Un hilo por placa, cada uno detrás de su ventana QPORT_AT(board)
+typedef struct {
+    pthread_t thread;
+    int running;        // Solo con __atomic: lo baja qpu_emu_stop_board
+    quantum_port_t *port;
+    qpu_emu_config_t cfg;
+    qpu_emu_stats_t stats;
+    uint32_t rng;
+} qpu_emu_board_t;
+
+static qpu_emu_board_t emu_boards[QPORT_MAX_BOARDS];
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void wait_ns(uint64_t ns) {
+    uint64_t deadline = now_ns() + ns;
+    if (ns > QPU_EMU_SPIN_NS) {
+        uint64_t coarse = ns - QPU_EMU_SPIN_NS;
+        struct timespec ts = { (time_t)(coarse / 1000000000ULL), (long)(coarse % 1000000000ULL) };
+        nanosleep(&ts, 0);
+    }
+    while (now_ns() < deadline) {
+        sched_yield();
+    }
+}
+
+// xorshift32: determinista por semilla para reproducir cargas
+static uint32_t emu_random(qpu_emu_board_t *emu) {
+    emu->rng ^= emu->rng << 13;
+    emu->rng ^= emu->rng >> 17;
+    emu->rng ^= emu->rng << 5;
+    return emu->rng;
+}
+
+static uint64_t sample_latency_ns(qpu_emu_board_t *emu) {
+    uint64_t mean = emu->cfg.mean_ns;
+    uint64_t spread = emu->cfg.spread_ns;
+
+    switch (emu->cfg.latency_dist) {
+        case QPU_EMU_LATENCY_UNIFORM: {
+            uint64_t lo = (spread < mean) ? mean - spread : 0;
+            uint64_t width = mean + spread - lo;
+            return lo + (width ? (uint64_t)emu_random(emu) % (width + 1) : 0);
+        }
+        case QPU_EMU_LATENCY_EXPONENTIAL: {
+            if (mean <= spread) return spread;
+            // Inversa de la CDF con u en (0, 1]
+            double u = ((double)emu_random(emu) + 1.0) / 4294967296.0;
+            return spread + (uint64_t)(-log(u) * (double)(mean - spread));
+        }
+        default:
+            return mean;
+    }
+}
+
+// La línea de colapso de la placa sigue a DATA_READY (fuente de nivel)
+static void stat_add(uint64_t *counter, uint64_t n) {
+    __atomic_fetch_add(counter, n, __ATOMIC_SEQ_CST);
+}
+
+static void status_set(quantum_port_t *port, uint32_t bits) {
+    __atomic_fetch_or(&port->STATUS_REG, bits, __ATOMIC_SEQ_CST);
+    if (bits & STATUS_DATA_READY) trap_host_set_irq_line(qport_collapse_irq(port), 1);
+}
+
+static void status_clear(quantum_port_t *port, uint32_t bits) {
+    if (bits & STATUS_DATA_READY) trap_host_set_irq_line(qport_collapse_irq(port), 0);
+    __atomic_fetch_and(&port->STATUS_REG, ~bits, __ATOMIC_SEQ_CST);
+}
+
+static void emu_collapse(qpu_emu_board_t *emu, int prepare) {
+    quantum_port_t *port = emu->port;
+    status_clear(port, STATUS_DATA_READY);
+
+    uint64_t latency = sample_latency_ns(emu);
+    wait_ns(latency);
+    stat_add(&emu->stats.busy_ns, latency);
+
+    uint32_t latch = port->DATA_LATCH & 0x7F;
+    if (prepare) {
+        // El bit de Majorana colapsa con P(1) = collapse_bias
+        if ((emu_random(emu) & 0xFFFF) < emu->cfg.collapse_bias) latch |= 0x80;
+        stat_add(&emu->stats.collapses, 1);
+    } else {
+        // CMD_MEASURE relee el último estado colapsado
+        latch |= port->DATA_LATCH & 0x80;
+        stat_add(&emu->stats.measures, 1);
+    }
+    if (latch & 0x80) stat_add(&emu->stats.ones, 1);
+
+    // Orden: dato, contador de fase y por último la bandera
+    __atomic_store_n(&port->DATA_LATCH, latch, __ATOMIC_SEQ_CST);
+    __atomic_fetch_add(&port->PHASE_LOCK, 1, __ATOMIC_SEQ_CST);
+    status_set(port, STATUS_DATA_READY);
+}
+
+// CMD_PREPARE_BATCH: BATCH_COUNT colapsos seguidos sobre la ventana
+static void emu_collapse_batch(qpu_emu_board_t *emu) {
+    quantum_port_t *port = emu->port;
+    status_clear(port, STATUS_DATA_READY);
+
+    uint32_t k = port->BATCH_COUNT;
+    if (k > QPORT_BATCH_MAX) k = QPORT_BATCH_MAX;
+
+    uint64_t latency = 0;
+    for (uint32_t i = 0; i < k; i++) latency += sample_latency_ns(emu);
+    wait_ns(latency);
+    stat_add(&emu->stats.busy_ns, latency);
+
+    for (uint32_t w = 0; w < (k + 3) / 4; w++) {
+        uint32_t word = port->BATCH_WINDOW[w];
+        for (uint32_t b = 0; b < 4 && 4 * w + b < k; b++) {
+            uint32_t byte = (word >> (8 * b)) & 0x7F;
+            if ((emu_random(emu) & 0xFFFF) < emu->cfg.collapse_bias) {
+                byte |= 0x80;
+                stat_add(&emu->stats.ones, 1);
+            }
+            word = (word & ~(0xFFu << (8 * b))) | (byte << (8 * b));
+        }
+        __atomic_store_n(&port->BATCH_WINDOW[w], word, __ATOMIC_SEQ_CST);
+    }
+    stat_add(&emu->stats.collapses, k);
+    stat_add(&emu->stats.batches, 1);
+
+    __atomic_fetch_add(&port->PHASE_LOCK, k, __ATOMIC_SEQ_CST);
+    status_set(port, STATUS_DATA_READY);
+}
+
+static void *emu_main(void *arg) {
+    qpu_emu_board_t *emu = arg;
+    quantum_port_t *port = emu->port;
+    while (__atomic_load_n(&emu->running, __ATOMIC_SEQ_CST)) {
+        uint32_t cmd = __atomic_exchange_n(&port->CONTROL_REG, 0, __ATOMIC_SEQ_CST);
+        if (cmd == 0) {
+            sched_yield(); // Sin comando: no robar la CPU al kernel emulado
+            continue;
+        }
+        stat_add(&emu->stats.commands, 1);
+
+        if (cmd & CMD_RESET) {
+            status_clear(port, STATUS_TEMP_OK | STATUS_DATA_READY | STATUS_DECOHERENCE_WARN);
+            port->DATA_LATCH = 0;
+        }
+        if (cmd & CMD_CALIBRATE) {
+            wait_ns(emu->cfg.calibrate_ns);
+            status_set(port, STATUS_TEMP_OK);
+        }
+        if (cmd & CMD_PREPARE_BATCH) {
+            emu_collapse_batch(emu);
+        } else if (cmd & CMD_PREPARE_STATE) {
+            emu_collapse(emu, 1);
+        } else if (cmd & CMD_MEASURE) {
+            emu_collapse(emu, 0);
+        }
+    }
+    return 0;
+}
+
+static void port_clear(quantum_port_t *port) {
+    trap_host_set_irq_line(qport_collapse_irq(port), 0);
+    port->MAGIC_SIG = 0;
+    port->CONTROL_REG = 0;
+    port->STATUS_REG = 0;
+    port->DATA_LATCH = 0;
+    port->PHASE_LOCK = 0;
+    port->BATCH_COUNT = 0;
+}
+
+int qpu_emu_start_board(uint32_t board, const qpu_emu_config_t *config) {
+    if (board >= QPORT_MAX_BOARDS) return -1;
+    qpu_emu_board_t *emu = &emu_boards[board];
+    if (__atomic_load_n(&emu->running, __ATOMIC_SEQ_CST)) return -1;
+
+    quantum_port_t *port = QPORT_AT(board);
+    emu->port = port;
+    emu->cfg = *config;
+    emu->rng = config->seed ? config->seed : 0x51425247u;
+    emu->stats = (qpu_emu_stats_t){0};
+
+    port_clear(port);
+    port->STATUS_REG = STATUS_READY | (config->no_batch ? 0 : STATUS_BATCH_CAPABLE);
+    port->MAGIC_SIG = QPORT_MAGIC_SIG;
+
+    __atomic_store_n(&emu->running, 1, __ATOMIC_SEQ_CST);
+    if (pthread_create(&emu->thread, 0, emu_main, emu) != 0) {
+        __atomic_store_n(&emu->running, 0, __ATOMIC_SEQ_CST);
+        port_clear(port);
+        return -1;
+    }
+    return 0;
+}
+
+void qpu_emu_stop_board(uint32_t board) {
+    if (board >= QPORT_MAX_BOARDS) return;
+    qpu_emu_board_t *emu = &emu_boards[board];
+    if (!__atomic_load_n(&emu->running, __ATOMIC_SEQ_CST)) return;
+    __atomic_store_n(&emu->running, 0, __ATOMIC_SEQ_CST);
+    pthread_join(emu->thread, 0);
+    port_clear(emu->port);
+}
+
+void qpu_emu_get_stats_board(uint32_t board, qpu_emu_stats_t *stats) {
+    if (board >= QPORT_MAX_BOARDS) return;
+    const qpu_emu_stats_t *src = &emu_boards[board].stats;
+    stats->commands = __atomic_load_n(&src->commands, __ATOMIC_SEQ_CST);
+    stats->collapses = __atomic_load_n(&src->collapses, __ATOMIC_SEQ_CST);
+    stats->measures = __atomic_load_n(&src->measures, __ATOMIC_SEQ_CST);
+    stats->batches = __atomic_load_n(&src->batches, __ATOMIC_SEQ_CST);
+    stats->ones = __atomic_load_n(&src->ones, __ATOMIC_SEQ_CST);
+    stats->busy_ns = __atomic_load_n(&src->busy_ns, __ATOMIC_SEQ_CST);
+}
+
+int qpu_emu_start(const qpu_emu_config_t *config) {
+    return qpu_emu_start_board(0, config);
+}
+
+void qpu_emu_stop(void) {
+    for (uint32_t b = 0; b < QPORT_MAX_BOARDS; b++) qpu_emu_stop_board(b);
+}
+
+void qpu_emu_get_stats(qpu_emu_stats_t *stats) {
+    qpu_emu_get_stats_board(0, stats);
+}
@@ -1,138 +1,477 @@
 #include "../include/qcore_quantum.h"
+#include "../include/qcore_fixed_vec.h"
 
-static QuantumRegister q_reg;
+#define SIGNAL_AMPLITUDE 0x00002000 // 0.125: superposición tipo Hadamard
+#define LEAK_AMPLITUDE   0x00000200 // Fuga de vacío (~1/16 de la señal)
+
+#define QUARTER_PI_Q16 51472        // π/4 en Q16.16
+#define QREG_ALIGN 64               // Arrays alineados a línea de caché
+
+// Registro de la API clásica, creado en la primera llamada
+static uint8_t default_arena[QUANTUM_REGISTER_BYTES(QUANTUM_MEMORY_SIZE)] __attribute__((aligned(QREG_ALIGN)));
+static QuantumRegister *default_reg = 0;
 
 // Helper: fast inverse square root or normalization mock
 
+// floor(log2(x)) para x > 0 sin __builtin_clz (evita depender de libgcc)
+static uint32_t ilog2_u32(uint32_t x) {
+    uint32_t l = 0;
+    if (x >> 16) { x >>= 16; l += 16; }
+    if (x >> 8)  { x >>= 8;  l += 8; }
+    if (x >> 4)  { x >>= 4;  l += 4; }
+    if (x >> 2)  { x >>= 2;  l += 2; }
+    if (x >> 1)  { l += 1; }
+    return l;
+}
 
-void init_quantum_register(void) {
-    for (int i = 0; i < QUANTUM_MEMORY_SIZE; i++) {
-        q_reg.states[i].amplitude_real = 0;
-        q_reg.states[i].amplitude_imag = 0;
-        q_reg.states[i].data = 0;
+static uint32_t amplitude_class(fixed_t amp) {
+    uint32_t s = (uint32_t)(amp >> 31);
+    return ilog2_u32(((uint32_t)amp ^ s) - s);
+}
+
+// --- Estadísticos incrementales ---
+
+static void stats_add(QuantumRegister *reg, uint32_t slot) {
+    fixed_t amp = reg->amplitude_real[slot];
+    reg->active++;
+    reg->amp_sum += amp;
+    if (reg->data[slot] == 0) {
+        reg->zero_active++;
+        reg->zero_sum += amp;
+    }
+}
+
+static void stats_remove(QuantumRegister *reg, uint32_t slot) {
+    fixed_t amp = reg->amplitude_real[slot];
+    reg->active--;
+    reg->amp_sum -= amp;
+    if (reg->data[slot] == 0) {
+        reg->zero_active--;
+        reg->zero_sum -= amp;
+    }
+}
+
+// --- Índice dato -> slot (hash de Fibonacci, sondeo lineal) ---
+
+static uint32_t index_hash(const QuantumRegister *reg, int32_t data) {
+    uint32_t h = (uint32_t)data * 0x9E3779B9u;
+    return (h ^ (h >> 16)) & reg->index_mask;
+}
+
+static uint32_t index_find(const QuantumRegister *reg, int32_t data) {
+    for (uint32_t h = index_hash(reg, data);; h = (h + 1) & reg->index_mask) {
+        uint32_t e = reg->index[h];
+        if (e == 0) return QUANTUM_SLOT_NONE;
+        if (reg->data[e - 1] == data) return e - 1;
+    }
+}
+
+static void index_insert(QuantumRegister *reg, int32_t data, uint32_t slot) {
+    uint32_t h = index_hash(reg, data);
+    while (reg->index[h] != 0) h = (h + 1) & reg->index_mask;
+    reg->index[h] = slot + 1;
+}
+
+// Borrado con desplazamiento hacia atrás: sin lápidas, las búsquedas no se degradan
+static void index_remove(QuantumRegister *reg, int32_t data, uint32_t slot) {
+    uint32_t mask = reg->index_mask;
+    uint32_t h = index_hash(reg, data);
+    while (reg->index[h] != slot + 1) {
+        if (reg->index[h] == 0) return; // Fuga de vacío: nunca se indexó
+        h = (h + 1) & mask;
+    }
+
+    uint32_t hole = h;
+    for (uint32_t j = (hole + 1) & mask; reg->index[j] != 0; j = (j + 1) & mask) {
+        uint32_t home = index_hash(reg, reg->data[reg->index[j] - 1]);
+        // La entrada j puede ocupar el hueco si su cubeta natural no está en (hole, j]
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            reg->index[hole] = reg->index[j];
+            hole = j;
+        }
+    }
+    reg->index[hole] = 0;
+}
+
+// --- Pila de slots libres ---
+
+static void free_push(QuantumRegister *reg, uint32_t slot) {
+    reg->free_pos[slot] = reg->free_count;
+    reg->free_stack[reg->free_count++] = slot;
+}
+
+static void free_take(QuantumRegister *reg, uint32_t slot) {
+    uint32_t pos = reg->free_pos[slot];
+    uint32_t last = reg->free_stack[--reg->free_count];
+    reg->free_stack[pos] = last;
+    reg->free_pos[last] = pos;
+    reg->free_pos[slot] = QUANTUM_SLOT_NONE;
+}
+
+// --- Listas circulares por clase de amplitud (se enlaza por la cola: FIFO) ---
+
+static void class_link(QuantumRegister *reg, uint32_t slot) {
+    uint32_t c = amplitude_class(reg->amplitude_real[slot]);
+    uint32_t head = reg->class_head[c];
+
+    reg->slot_class[slot] = (uint8_t)c;
+    if (head == QUANTUM_SLOT_NONE) {
+        reg->class_next[slot] = slot;
+        reg->class_prev[slot] = slot;
+        reg->class_head[c] = slot;
+        reg->class_bitmap |= 1u << c;
+    } else {
+        uint32_t tail = reg->class_prev[head];
+        reg->class_next[tail] = slot;
+        reg->class_prev[slot] = tail;
+        reg->class_next[slot] = head;
+        reg->class_prev[head] = slot;
+    }
+}
+
+static void class_unlink(QuantumRegister *reg, uint32_t slot) {
+    uint32_t c = reg->slot_class[slot];
+    uint32_t next = reg->class_next[slot];
+
+    if (next == slot) {
+        reg->class_head[c] = QUANTUM_SLOT_NONE;
+        reg->class_bitmap &= ~(1u << c);
+        return;
+    }
+    uint32_t prev = reg->class_prev[slot];
+    reg->class_next[prev] = next;
+    reg->class_prev[next] = prev;
+    if (reg->class_head[c] == slot) reg->class_head[c] = next;
+}
+
+// Registro lleno: expulsa el estado más antiguo de la clase de menor |amplitud|
+static uint32_t evict_weakest(QuantumRegister *reg) {
+    uint32_t c = ilog2_u32(reg->class_bitmap & (0u - reg->class_bitmap));
+    uint32_t slot = reg->class_head[c];
+
+    class_unlink(reg, slot);
+    stats_remove(reg, slot);
+    index_remove(reg, reg->data[slot], slot);
+    return slot;
+}
+
+// Reconstruye lista libre, clases y estadísticos tras cambios de amplitud
+// en bloque (Grover). Los estados que quedaron a amplitud 0 salen del índice. O(N).
+static void quantum_reindex(QuantumRegister *reg) {
+    uint32_t n = reg->capacity;
+    uint32_t active = 0, zero_active = 0;
+    int64_t amp_sum = 0, zero_sum = 0;
+
+    for (uint32_t c = 0; c < QUANTUM_AMP_CLASSES; c++) reg->class_head[c] = QUANTUM_SLOT_NONE;
+    reg->class_bitmap = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        fixed_t amp = reg->amplitude_real[i];
+        if (amp == 0) {
+            if (reg->free_pos[i] == QUANTUM_SLOT_NONE) index_remove(reg, reg->data[i], i);
+            continue;
+        }
+        active++;
+        amp_sum += amp;
+        if (reg->data[i] == 0) {
+            zero_active++;
+            zero_sum += amp;
+        }
+    }
+    reg->active = active;
+    reg->amp_sum = amp_sum;
+    reg->zero_active = zero_active;
+    reg->zero_sum = zero_sum;
+
+    // Igual que clear: los slots bajos quedan en la cima de la pila
+    reg->free_count = 0;
+    for (uint32_t i = n; i-- > 0;) {
+        if (reg->amplitude_real[i] == 0) free_push(reg, i);
+        else reg->free_pos[i] = QUANTUM_SLOT_NONE;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        if (reg->amplitude_real[i] != 0) class_link(reg, i);
+    }
+    reg->dirty = 0;
+}
+
+// --- Registros en arena ---
+
+static size_t qreg_align(size_t x) {
+    return (x + QREG_ALIGN - 1) & ~(size_t)(QREG_ALIGN - 1);
+}
+
+static size_t index_buckets(uint32_t capacity) {
+    size_t s = 1;
+    while (s < 2 * (size_t)capacity) s <<= 1;
+    return s;
+}
+
+size_t quantum_register_footprint(uint32_t capacity) {
+    size_t words = qreg_align((size_t)capacity * sizeof(uint32_t));
+    return QREG_ALIGN - 1                                   // Alineación de la arena
+         + qreg_align(sizeof(QuantumRegister))
+         + 7 * words                                        // amp re/im, data, free x2, clases x2
+         + qreg_align(capacity)                             // slot_class
+         + qreg_align(index_buckets(capacity) * sizeof(uint32_t));
+}
+
+// Reparte la arena en bloques alineados
+static void *qreg_carve(uint8_t **cursor, size_t bytes) {
+    void *p = *cursor;
+    *cursor += qreg_align(bytes);
+    return p;
+}
+
+QuantumRegister *quantum_register_create(void *arena, size_t arena_size, uint32_t capacity) {
+    if (!arena || capacity == 0 || capacity > (1u << 30)) return 0;
+    if (arena_size < quantum_register_footprint(capacity)) return 0;
+
+    uint8_t *cursor = (uint8_t *)qreg_align((uintptr_t)arena);
+    QuantumRegister *reg = (QuantumRegister *)qreg_carve(&cursor, sizeof(QuantumRegister));
+    size_t words = (size_t)capacity * sizeof(uint32_t);
+
+    reg->capacity = capacity;
+    reg->index_mask = (uint32_t)(index_buckets(capacity) - 1);
+    reg->amplitude_real = (fixed_t *)qreg_carve(&cursor, words);
+    reg->amplitude_imag = (fixed_t *)qreg_carve(&cursor, words);
+    reg->data = (int32_t *)qreg_carve(&cursor, words);
+    reg->free_stack = (uint32_t *)qreg_carve(&cursor, words);
+    reg->free_pos = (uint32_t *)qreg_carve(&cursor, words);
+    reg->class_next = (uint32_t *)qreg_carve(&cursor, words);
+    reg->class_prev = (uint32_t *)qreg_carve(&cursor, words);
+    reg->slot_class = (uint8_t *)qreg_carve(&cursor, capacity);
+    reg->index = (uint32_t *)qreg_carve(&cursor, ((size_t)reg->index_mask + 1) * sizeof(uint32_t));
+
+    quantum_register_clear(reg);
+    return reg;
+}
+
+void quantum_register_clear(QuantumRegister *reg) {
+    for (uint32_t i = 0; i < reg->capacity; i++) {
+        reg->amplitude_real[i] = 0;
+        reg->amplitude_imag[i] = 0;
+        reg->data[i] = 0;
     }
-    q_reg.global_phase = 0;
-    q_reg.coherence_residue = 0;
+    for (uint32_t i = 0; i <= reg->index_mask; i++) reg->index[i] = 0;
+    reg->global_phase = 0;
+    reg->coherence_residue = 0;
+
+    reg->free_count = 0;
+    for (uint32_t i = reg->capacity; i-- > 0;) free_push(reg, i);
+    for (uint32_t c = 0; c < QUANTUM_AMP_CLASSES; c++) reg->class_head[c] = QUANTUM_SLOT_NONE;
+    reg->class_bitmap = 0;
+
+    reg->active = 0;
+    reg->amp_sum = 0;
+    reg->zero_active = 0;
+    reg->zero_sum = 0;
+    reg->last_iterations = 0;
+    reg->dirty = 0;
 }
 
 // "Writes" data by adding it to the superposition
 // Instead of overwriting, we add a basis state or enhance amplitude of existing one
-void write_superposition(int32_t data) {
-    // Simple mock: Find an empty slot or the same slot
-    int target_idx = -1;
-    
+void quantum_register_write(QuantumRegister *reg, int32_t data) {
+    if (reg->dirty) quantum_reindex(reg);
+
     // Check if data already exists to reinforce it (constructive interference)
-    for (int i = 0; i < QUANTUM_MEMORY_SIZE; i++) {
-        if (q_reg.states[i].data == data && q_reg.states[i].amplitude_real != 0) {
-            target_idx = i;
-            break;
-        }
-    }
-    
-    // If not found, find empty slot
-    if (target_idx == -1) {
-        for (int i = 0; i < QUANTUM_MEMORY_SIZE; i++) {
-            if (q_reg.states[i].amplitude_real == 0) {
-                target_idx = i;
-                break;
-            }
+    uint32_t target_idx = index_find(reg, data);
+
+    if (target_idx != QUANTUM_SLOT_NONE) {
+        class_unlink(reg, target_idx);
+        stats_remove(reg, target_idx);
+    } else {
+        // If not found, take an empty slot; if memory is full, the weakest
+        // state decoheres first (superposition collapse mock)
+        if (reg->free_count != 0) {
+            target_idx = reg->free_stack[reg->free_count - 1];
+            free_take(reg, target_idx);
+        } else {
+            target_idx = evict_weakest(reg);
         }
+        reg->data[target_idx] = data;
+        index_insert(reg, data, target_idx);
     }
-    
-    // If memory full, classic replacement (superposition collapse mock)
-    // Or we could use a circular buffer approach. For now, simple overwrite 0.
-    if (target_idx == -1) target_idx = 0;
 
-    q_reg.states[target_idx].data = data;
     // Set to Hadamard-like superposition state (equal probability initialization)
-    // 1/sqrt(N) roughly 0.125 in Q16.16 for size 64? Just using a standardized visible constant.
-    q_reg.states[target_idx].amplitude_real = 0x00002000; // 0.125
-    q_reg.states[target_idx].amplitude_imag = 0;
+    reg->amplitude_real[target_idx] = SIGNAL_AMPLITUDE;
+    reg->amplitude_imag[target_idx] = 0;
+    class_link(reg, target_idx);
+    stats_add(reg, target_idx);
 
     // Inject "Vacuum Noise" / Leakage to adjacent state (Rule 2.1)
     // This creates the necessary entropy/residue for the wetware
-    int noise_idx = (target_idx + 1) % QUANTUM_MEMORY_SIZE;
-    if (q_reg.states[noise_idx].amplitude_real == 0) {
-        q_reg.states[noise_idx].data = 0; // "Empty" state
-        q_reg.states[noise_idx].amplitude_real = 0x00000200; // Small leak (~1/16th of signal)
+    uint32_t noise_idx = (target_idx + 1 == reg->capacity) ? 0 : target_idx + 1;
+    if (reg->amplitude_real[noise_idx] == 0) {
+        free_take(reg, noise_idx);
+        reg->data[noise_idx] = 0; // "Empty" state
+        reg->amplitude_real[noise_idx] = LEAK_AMPLITUDE;
+        class_link(reg, noise_idx);
+        stats_add(reg, noise_idx);
     }
 }
 
-void apply_grover_oracle(int32_t target) {
+int32_t quantum_register_slot_of(QuantumRegister *reg, int32_t data) {
+    if (reg->dirty) quantum_reindex(reg);
+    uint32_t slot = index_find(reg, data);
+    return (slot == QUANTUM_SLOT_NONE) ? -1 : (int32_t)slot;
+}
+
+uint32_t quantum_grover_iterations(uint32_t n_active, uint32_t m_marked) {
+    if (m_marked == 0 || 2 * (uint64_t)m_marked >= n_active) return 0;
+    uint32_t root = isqrt_u64(((uint64_t)n_active << 32) / m_marked); // √(N/M) en Q16.16
+    return (uint32_t)(((uint64_t)root * QUARTER_PI_Q16) >> 32);
+}
+
+static void oracle_pass(QuantumRegister *reg, int32_t target) {
+    int64_t flipped = 0;
     // Flip phase of the target state
-    for (int i = 0; i < QUANTUM_MEMORY_SIZE; i++) {
+    for (uint32_t i = 0; i < reg->capacity; i++) {
         // Simple equality check for "Oracle"
-        // In simulation, we can peek at the data. 
-        if (q_reg.states[i].data == target) {
-            q_reg.states[i].amplitude_real = -q_reg.states[i].amplitude_real;
-            q_reg.states[i].amplitude_imag = -q_reg.states[i].amplitude_imag;
+        // In simulation, we can peek at the data.
+        if (reg->data[i] == target) {
+            flipped += reg->amplitude_real[i];
+            reg->amplitude_real[i] = -reg->amplitude_real[i];
+            reg->amplitude_imag[i] = -reg->amplitude_imag[i];
         }
     }
+    reg->amp_sum -= 2 * flipped;
+    if (target == 0) reg->zero_sum = -reg->zero_sum;
+    reg->dirty = 1;
 }
 
-void apply_diffusion_operator(void) {
-    // Inversion about the mean
-    fixed_t sum = 0;
-    int count = 0;
-    
-    for (int i = 0; i < QUANTUM_MEMORY_SIZE; i++) {
-        // Only count active states
-        if (q_reg.states[i].amplitude_real != 0) {
-            sum += q_reg.states[i].amplitude_real;
-            count++;
-        }
-    }
-    
-    if (count == 0) return;
-    
-    fixed_t mean = sum / count;
-    
-    for (int i = 0; i < QUANTUM_MEMORY_SIZE; i++) {
-        if (q_reg.states[i].amplitude_real != 0) {
-            // 2*mean - amplitude
-            q_reg.states[i].amplitude_real = (2 * mean) - q_reg.states[i].amplitude_real;
+static void diffusion_pass(QuantumRegister *reg) {
+    // Inversion about the mean: la media sale de los estadísticos, una sola pasada
+    if (reg->active == 0) return;
+
+    fixed_t mean = (fixed_t)(reg->amp_sum / (int64_t)reg->active);
+    uint32_t two_mean = 2u * (uint32_t)mean;
+    uint32_t active = 0, zero_active = 0;
+    int64_t amp_sum = 0, zero_sum = 0;
+
+    for (uint32_t i = 0; i < reg->capacity; i++) {
+        if (reg->amplitude_real[i] == 0) continue; // Only active states
+        // 2*mean - amplitude
+        uint32_t amp = two_mean - (uint32_t)reg->amplitude_real[i];
+        reg->amplitude_real[i] = (fixed_t)amp;
+        if (amp == 0) continue;
+        active++;
+        amp_sum += (fixed_t)amp;
+        if (reg->data[i] == 0) {
+            zero_active++;
+            zero_sum += (fixed_t)amp;
         }
     }
+    reg->active = active;
+    reg->amp_sum = amp_sum;
+    reg->zero_active = zero_active;
+    reg->zero_sum = zero_sum;
+    reg->dirty = 1;
 }
 
 // Simulates Grover search to find closest match or exact match
-int32_t read_quantum_register(int32_t search_target) {
-    // 1. superposition is already active
-    
-    // 2. Apply Grover iterations (simulating sqrt(N) steps)
-    // For N=64, approx 6-8 iterations
-    for (int step = 0; step < 6; step++) {
-        apply_grover_oracle(search_target);
-        apply_diffusion_operator();
-    }
-    
+int32_t quantum_register_read(QuantumRegister *reg, int32_t search_target) {
+    // 1. superposition is already active: M marcados y su Σ amplitud en O(1)
+    //    (el dato 0 comparte clave con las fugas de vacío)
+    uint32_t marked = 0;
+    int64_t marked_sum = 0;
+    if (search_target == 0) {
+        marked = reg->zero_active;
+        marked_sum = reg->zero_sum;
+    } else {
+        uint32_t slot = index_find(reg, search_target);
+        if (slot != QUANTUM_SLOT_NONE && reg->amplitude_real[slot] != 0) {
+            marked = 1;
+            marked_sum = reg->amplitude_real[slot];
+        }
+    }
+
+    // 2. Apply Grover iterations: ⌊π/4·√(N/M)⌋ sobre los estados vivos
+    // Oráculo + difusión fusionados: cada iteración es una sola pasada
+    // vectorial que además deja Σ y activos para la media de la siguiente.
+    // Idéntico a apply_grover_oracle() + apply_diffusion_operator().
+    uint32_t iterations = quantum_grover_iterations(reg->active, marked);
+    int64_t sum = reg->amp_sum - 2 * marked_sum;
+    size_t count = reg->active;
+    for (uint32_t step = 0; step < iterations && count != 0; step++) {
+        fixed_t mean = (fixed_t)(sum / (int64_t)count);
+        count = fixed_vec_grover_step(reg->amplitude_real, reg->data, reg->capacity,
+                                      search_target, (fixed_t)(2u * (uint32_t)mean), &sum);
+    }
+    reg->last_iterations = iterations;
+
+    // La difusión no toca la parte imaginaria: el oráculo solo la niega,
+    // así que basta con la paridad del número de iteraciones
+    if (iterations & 1) {
+        for (uint32_t i = 0; i < reg->capacity; i++) {
+            if (reg->data[i] == search_target) reg->amplitude_imag[i] = -reg->amplitude_imag[i];
+        }
+    }
+
     // 3. Measure (Collapse) - find state with highest amplitude
     int32_t max_amplitude = -1;
     int32_t best_match_data = 0;
-    
+
     // Also calculate coherence residue (sum of off-diagonal/unused probabilities entropy)
     fixed_t total_prob = 0;
-    
-    for (int i = 0; i < QUANTUM_MEMORY_SIZE; i++) {
-        fixed_t amp = q_reg.states[i].amplitude_real;
+
+    for (uint32_t i = 0; i < reg->capacity; i++) {
+        fixed_t amp = reg->amplitude_real[i];
         // abs value approximation
         if (amp < 0) amp = -amp;
-        
+
         total_prob += amp;
-        
+
         if (amp > max_amplitude) {
             max_amplitude = amp;
-            best_match_data = q_reg.states[i].data;
+            best_match_data = reg->data[i];
         }
     }
-    
+
     // Residue is essentially the "waste" energy or non-collapsed probability
     // Used to feed the wetware. Simple metric: Total Prob - Max Prob.
-    q_reg.coherence_residue = total_prob - max_amplitude;
-    
+    reg->coherence_residue = total_prob - max_amplitude;
+
+    // Grover moved every amplitude: refresh eviction classes, free slots and sums
+    quantum_reindex(reg);
+
     return best_match_data;
 }
 
+// --- API clásica sobre el registro por defecto ---
+
+static QuantumRegister *default_register(void) {
+    if (!default_reg) {
+        default_reg = quantum_register_create(default_arena, sizeof(default_arena), QUANTUM_MEMORY_SIZE);
+    }
+    return default_reg;
+}
+
+void init_quantum_register(void) {
+    quantum_register_clear(default_register());
+}
+
+void write_superposition(int32_t data) {
+    quantum_register_write(default_register(), data);
+}
+
+int32_t read_quantum_register(int32_t search_target) {
+    return quantum_register_read(default_register(), search_target);
+}
+
 fixed_t get_quantum_residue(void) {
-    return q_reg.coherence_residue;
+    return default_register()->coherence_residue;
+}
+
+void apply_grover_oracle(int32_t target) {
+    oracle_pass(default_register(), target);
+}
+
+void apply_diffusion_operator(void) {
+    diffusion_pass(default_register());
+}
+
+int32_t quantum_slot_of(int32_t data) {
+    return quantum_register_slot_of(default_register(), data);
 }
@@ -5,6 +5,9 @@
 static SystemMode current_mode = MODE_FERMIONIC;
 static fixed_t current_pump_rate = 0;
 
+// Generador incremental de O_n para el planificador (un paso por tick)
+static golden_seq_t sched_seq = GOLDEN_SEQ_ORIGIN;
+
 void set_system_mode(SystemMode mode) {
     current_mode = mode;
     // Hardware register write would go here
@@ -17,7 +20,8 @@ void pump_energy(fixed_t rate) {
 
 // Planificador Quirúrgico y Gestión de Sectores
 void metriplectic_scheduler(int32_t tick) {
-    fixed_t o_n = calculate_golden_operator(tick);
+    // Ticks consecutivos avanzan por rotación; un salto re-siembra en O(1)
+    fixed_t o_n = golden_seq_seek(&sched_seq, tick);
 
     if (o_n >= 0) {
         // ACTIVAR SECTOR BOSÓNICO: Fase conservativa
@@ -36,13 +40,14 @@ uint8_t metriplectic_scheduler_get_next_phase(void) {
     // Usamos el ciclo interno para proponer una fase
     // En un sistema real, esto vendría de un análisis del operador dorado en el tiempo
     static int32_t internal_tick = 0;
+    static golden_seq_t phase_seq = GOLDEN_SEQ_ORIGIN;
     internal_tick++;
     
     // Mapeamos el tick a 7 bits (0-127)
     // Si O_n es positivo, tendemos a fases pares (estables)
     // Si O_n es negativo, tendemos a fases impares (disipativas)
     uint8_t base_phase = (uint8_t)(internal_tick % 128);
-    fixed_t o_n = calculate_golden_operator(internal_tick);
+    fixed_t o_n = golden_seq_next(&phase_seq); // O_{internal_tick}
     
     if (o_n >= 0) {
         return base_phase & 0xFE; // Forzar par (Clear bit 0)
@@ -1,61 +1,187 @@
 #include "../include/qcore_security.h"
 #include "../include/qcore_port.h"
 #include "../include/qcore_math.h"
+#include "../include/qcore_fixed_vec.h"
+#include "../include/qcore_trap.h"
+#include "../include/qcore_wipe.h"
+#include "../include/qcore_forensic.h"
+#include "../include/qcore_entropy.h"
 
 static security_state_t current_state = LAMINAR_ACTIVE;
+static uint32_t heartbeat_cycle = 0;  // Heartbeats desde el arranque (registro forense)
+
+// Estado de hibernación por página del buffer protegido. Una página tiene
+// cifrado el prefijo [0, page_len) con page_key (0 = en claro: la llave de
+// fase nunca vale 0 porque sus 16 bits bajos son 0x5A5A).
+static uint32_t page_key[SECURITY_MAX_PAGES];
+static uint32_t page_len[SECURITY_MAX_PAGES];
+
+static uint32_t* sec_buffer = 0;
+static size_t sec_size = 0;           // Palabras
+static size_t sec_page_words = SECURITY_PAGE_WORDS;
+static size_t sec_pages = 0;
+static size_t encrypted_pages = 0;    // Páginas con page_len > 0
+static size_t encrypted_words = 0;
+
+static uint32_t epoch_key = 0;        // Llave de la hibernación en curso
+static size_t enc_page = 0;           // Siguiente página de la pasada de evaporación
+static size_t dec_page = 0;           // Siguiente página de la condensación en segundo plano
+static size_t crypt_budget_words = 0; // 0 = sin límite por ciclo
+
+static uint32_t phase_key_word(majorana_byte_t q_state) {
+    uint32_t phase_key = (uint32_t)q_state.raw << 24 | (uint32_t)q_state.topology.phase_trajectory << 16;
+    return phase_key ^ 0x5A5A5A5A;
+}
 
 /**
  * 1. ENCRIPTADO DE FASE (Capa 0)
  * Aplica una rotación de fase reversible basada en el Operador Dorado.
  */
 void apply_phase_encryption(uint32_t* buffer, size_t size, majorana_byte_t q_state) {
-    uint32_t phase_key = (uint32_t)q_state.raw << 24 | (uint32_t)q_state.topology.phase_trajectory << 16;
-    
-    for (size_t i = 0; i < size; i++) {
-        // Cifrado simétrico de bajo impacto térmico
-        buffer[i] ^= (phase_key ^ 0x5A5A5A5A);
+    // Cifrado simétrico de bajo impacto térmico (XOR en palabras anchas/SIMD)
+    fixed_vec_xor_key(buffer, size, phase_key_word(q_state));
+}
+
+void security_set_crypt_budget(size_t lines_per_heartbeat) {
+    crypt_budget_words = lines_per_heartbeat * SECURITY_CRYPT_LINE_WORDS;
+}
+
+size_t security_crypt_progress(void) {
+    return encrypted_words;
+}
+
+size_t security_encrypted_pages(void) {
+    return encrypted_pages;
+}
+
+static size_t page_size_words(size_t p) {
+    size_t start = p * sec_page_words;
+    return (sec_size - start < sec_page_words) ? sec_size - start : sec_page_words;
+}
+
+// Cifra hasta budget palabras más de la página p (con su llave, o la de la
+// hibernación en curso si estaba en claro). Retorna las palabras cifradas.
+static size_t page_encrypt(size_t p, size_t budget) {
+    size_t n = page_size_words(p) - page_len[p];
+    if (n > budget) n = budget;
+    if (n == 0) return 0;
+    if (page_len[p] == 0) {
+        page_key[p] = epoch_key;
+        encrypted_pages++;
+    }
+    fixed_vec_xor_key(sec_buffer + p * sec_page_words + page_len[p], n, page_key[p]);
+    page_len[p] += (uint32_t)n;
+    encrypted_words += n;
+    return n;
+}
+
+// Descifra hasta budget palabras del final del prefijo cifrado de p
+static size_t page_decrypt(size_t p, size_t budget) {
+    size_t n = page_len[p];
+    if (n > budget) n = budget;
+    if (n == 0) return 0;
+    page_len[p] -= (uint32_t)n;
+    fixed_vec_xor_key(sec_buffer + p * sec_page_words + page_len[p], n, page_key[p]);
+    encrypted_words -= n;
+    if (page_len[p] == 0) {
+        page_key[p] = 0;
+        encrypted_pages--;
     }
+    return n;
+}
+
+// Fija el buffer protegido. Las páginas crecen en potencias de 2 si el
+// buffer no cabe en SECURITY_MAX_PAGES páginas. Un buffer distinto se
+// descifra antes de soltarlo; si se enlaza en plena hibernación, su pasada
+// de evaporación empieza de cero con la llave de la hibernación en curso.
+static void bind_buffer(uint32_t* buffer, size_t size) {
+    if (buffer == sec_buffer && size == sec_size) return;
+
+    for (size_t p = 0; encrypted_pages && p < sec_pages; p++) page_decrypt(p, page_len[p]);
+
+    sec_buffer = buffer;
+    sec_size = size;
+    sec_page_words = SECURITY_PAGE_WORDS;
+    while (size > sec_page_words * SECURITY_MAX_PAGES) sec_page_words <<= 1;
+    sec_pages = (size + sec_page_words - 1) / sec_page_words;
+    enc_page = (current_state == HIBERNATION) ? 0 : sec_pages;
+    dec_page = 0;
+}
+
+// Avanza la pasada de evaporación: solo páginas en claro o a medias
+static void evaporate_step(void) {
+    size_t budget = crypt_budget_words ? crypt_budget_words : sec_size;
+    while (budget && enc_page < sec_pages) {
+        budget -= page_encrypt(enc_page, budget);
+        if (page_len[enc_page] == page_size_words(enc_page)) enc_page++;
+    }
+}
+
+// Condensación en segundo plano de las páginas que nadie ha tocado
+static void condense_step(void) {
+    size_t budget = crypt_budget_words ? crypt_budget_words : sec_size;
+    while (budget && encrypted_pages) {
+        if (dec_page >= sec_pages) dec_page = 0;
+        budget -= page_decrypt(dec_page, budget);
+        if (page_len[dec_page] == 0) dec_page++;
+    }
+}
+
+uint32_t* security_access(size_t offset, size_t count) {
+    if (current_state != LAMINAR_ACTIVE) return 0; // Datos evaporados
+    if (!sec_buffer || offset > sec_size || count > sec_size - offset) return 0;
+    if (count && encrypted_pages) {
+        size_t last = (offset + count - 1) / sec_page_words;
+        for (size_t p = offset / sec_page_words; p <= last; p++) page_decrypt(p, page_len[p]);
+    }
+    return sec_buffer + offset;
 }
 
 /**
  * 2. REGISTRO FORENSE (The Black Box)
  * Guarda la huella digital del ataque antes de la evaporación total.
+ * Cada llamada añade un registro con marca de tiempo al anillo forense
+ * (qcore_forensic.c): los incidentes anteriores no se pierden.
  */
 void write_forensic_log(fixed_t surprise, majorana_byte_t last_q) {
-    #ifdef QCORE_TEST_ENV
-    // En test environment, usamos un buffer estático para evitar segfault
-    static uint32_t forensic_log_buffer[16];
-    volatile uint32_t* log = forensic_log_buffer;
-    #else
-    // En hardware real, escribimos a la dirección física
-    volatile uint32_t* log = (uint32_t*)FORENSIC_MEM_ADDR;
-    #endif
-    
-    log[0] = 0xDEADBEEF;             // Magic: Breach detected
-    log[1] = (uint32_t)surprise;      // Intensidad de la anomalía
-    log[2] = (uint32_t)last_q.raw;    // Último estado del QPU registrado
-    // El log se cifra con una llave maestra de hardware (hardwired)
+    forensic_log_append(surprise, last_q, (uint8_t)current_state, heartbeat_cycle);
 }
 
 /**
  * 3. AUTODESTRUCCIÓN (Singularity Protocol)
  * Inunda la memoria con entropía pura del QPU, borrando el rastro de Landauer.
+ * Todos los harts sobrescriben la RAM en paralelo (qcore_wipe.c), primero la
+ * matriz de pesos de .smop_laminar_mem y después la pila del hart 0, donde
+ * kernel_main guarda secure_buffer y el atractor. Esta función no vuelve, así
+ * que los marcos de sus llamadores están muertos: solo se respetan su propio
+ * marco y WIPE_STACK_RESERVE bytes por debajo para los llamados. El código y
+ * las pilas de los harts secundarios quedan intactos.
  */
+#if defined(ARCH_RISCV) && !defined(QCORE_TEST_ENV)
+extern char _laminar_mem_start[], _laminar_mem_end[];
+extern char _data_start[], _stack_bottom[], _stack_top[];
+extern char _hart_stacks_end[], _ram_end[];
+#endif
+
 void trigger_singularity(void) {
     current_state = SINGULARITY;
-    
-    // Acceso directo a la RAM física para sobreescritura masiva
-    uint32_t* ram_ptr = (uint32_t*)0x80000000; // Base de RAM en Smopsys
-    size_t ram_size_words = (128 * 1024 * 1024) / 4;
-
-    for (size_t i = 0; i < ram_size_words; i++) {
-        // Obtenemos ruido blanco real del puerto cuántico
-        // No es pseudo-aleatorio; es el colapso del sensor sin control de fase
-        ram_ptr[i] = QPORT->DATA_LATCH ^ 0xFFFFFFFF;
-        
-        // Pequeño delay para asegurar que el ruido sature el bus
-        for(int j=0; j<10; j++) __asm__ volatile("nop");
-    }
+    trap_irq_disable();
+
+    // Clave del borrado desde el pool de entropía ya cosechado: sin MMIO
+    uint64_t pool[WIPE_POOL_WORDS];
+    entropy_fill64(pool, WIPE_POOL_WORDS);
+    wipe_job_t job;
+    wipe_job_init(&job, pool);
+#if defined(ARCH_RISCV) && !defined(QCORE_TEST_ENV)
+    uintptr_t sp;
+    __asm__ volatile ("mv %0, sp" : "=r" (sp));
+    uintptr_t frame_top = (uintptr_t)__builtin_frame_address(0);  // sp a la entrada
+    wipe_add_region(&job, (uintptr_t)_laminar_mem_start, (uintptr_t)_laminar_mem_end);
+    wipe_add_stack(&job, (uintptr_t)_stack_bottom, (uintptr_t)_stack_top, sp - WIPE_STACK_RESERVE, frame_top);
+    wipe_add_region(&job, (uintptr_t)_data_start, (uintptr_t)_stack_bottom);
+    wipe_add_region(&job, (uintptr_t)_hart_stacks_end, (uintptr_t)_ram_end);
+#endif
+    wipe_run_all_harts(&job);
 
     // Bloqueo físico del MMQI para evitar re-sincronización
     QPORT->CONTROL_REG = 0x0000000F; // Command: PERMANENT_SHUTDOWN
@@ -76,7 +202,8 @@ void trigger_singularity(void) {
  * Se integra en el ciclo principal del kernel.
  */
 void security_heartbeat(uint32_t* main_buffer, size_t size, fixed_t surprise, majorana_byte_t q_state) {
-    
+    heartbeat_cycle++;
+
     if (surprise > CRITICAL_BREACH_LEVEL) {
         // --- SECUESTRO DETECTADO ---
         write_forensic_log(surprise, q_state);
@@ -84,17 +211,29 @@ void security_heartbeat(uint32_t* main_buffer, size_t size, fixed_t surprise, ma
     } 
     else if (surprise > ANOMALY_THRESHOLD) {
         // --- EVAPORACIÓN (Hibernación) ---
-        // Los datos se vuelven inaccesibles pero recuperables
-        current_state = HIBERNATION;
-        apply_phase_encryption(main_buffer, size, q_state);
+        // Los datos se vuelven inaccesibles pero recuperables. Solo la
+        // transición LAMINAR → HIBERNATION inicia una pasada; una anomalía
+        // sostenida con la pasada terminada no toca el buffer (O(1)).
+        bind_buffer(main_buffer, size);
+        if (current_state == LAMINAR_ACTIVE) {
+            epoch_key = phase_key_word(q_state);
+            enc_page = 0;
+            current_state = HIBERNATION;
+            write_forensic_log(surprise, q_state);
+        }
+        evaporate_step();
     } 
     else {
         // --- CONDENSACIÓN (Operación Normal) ---
+        // Los datos vuelven a ser accesibles al instante: security_access()
+        // descifra las páginas que se tocan y el resto se descifra aquí
+        // (cada página con su propia llave).
+        bind_buffer(main_buffer, size);
         if (current_state == HIBERNATION) {
-            // Revertimos la fase para recuperar los datos (Condensación)
-            apply_phase_encryption(main_buffer, size, q_state); 
             current_state = LAMINAR_ACTIVE;
+            enc_page = sec_pages;
         }
+        if (encrypted_pages) condense_step();
     }
 }
 
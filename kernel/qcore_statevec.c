@@ -0,0 +1,663 @@
+#include "../include/qcore_statevec.h"
+#include "../include/qcore_port.h"
+#include "../include/qcore_arch.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#if defined(ARCH_X86_64)
+    #include <immintrin.h>
+    #define SV_HAVE_AVX2
+#endif
+
+/**
+ * Simulador de vector de estado para el host.
+ * Todas las pasadas se expresan sobre "bloques" de 2^B amplitudes
+ * (B = min(n, SV_BLOCK_QUBITS)): es la unidad de reparto entre hilos y, para
+ * las puertas sobre qubits < B, también la unidad de bloqueo de caché.
+ */
+
+// Por debajo de 2^16 amplitudes despertar hilos cuesta más que la pasada
+#define SV_PARALLEL_MIN_QUBITS 16
+
+// Puerta preparada: matriz 2x2 compleja y máscara de control
+typedef struct {
+    float m[4][2];      // m00, m01, m10, m11 como (re, im)
+    uint32_t target;
+    uint32_t ctrl;      // Bits que deben valer 1 (0 = sin control)
+} sv_op_t;
+
+static int sv_use_avx2 = -1;
+
+static uint32_t sv_block_qubits(const statevec_t *sv) {
+    return (sv->n_qubits < SV_BLOCK_QUBITS) ? sv->n_qubits : SV_BLOCK_QUBITS;
+}
+
+// ============================================================================
+// REPARTO ENTRE HILOS
+// ============================================================================
+
+typedef void (*sv_task_fn)(statevec_t *sv, void *ctx, uint64_t b0, uint64_t b1, uint32_t worker);
+
+typedef struct {
+    sv_task_fn fn;
+    void *ctx;
+    uint64_t b0, b1;
+} sv_job_t;
+
+typedef struct sv_pool sv_pool_t;
+
+typedef struct {
+    sv_pool_t *pool;
+    uint32_t worker;
+} sv_worker_arg_t;
+
+// Hilos persistentes: se crean en la primera pasada paralela y viven hasta
+// statevec_destroy. El hilo w (1..n_workers) ejecuta jobs[w] de cada pasada.
+struct sv_pool {
+    statevec_t *sv;
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    uint64_t generation;    // Pasadas publicadas
+    uint32_t active;        // Trabajos de la pasada en curso
+    uint32_t pending;       // Trabajos de hilos aún sin terminar
+    int quit;
+    uint32_t n_workers;
+    pthread_t threads[SV_MAX_THREADS];
+    sv_job_t jobs[SV_MAX_THREADS];
+    sv_worker_arg_t args[SV_MAX_THREADS];
+};
+
+static void *sv_worker(void *arg) {
+    sv_pool_t *pool = ((sv_worker_arg_t *)arg)->pool;
+    uint32_t w = ((sv_worker_arg_t *)arg)->worker;
+
+    uint64_t seen = 0;
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->quit && pool->generation == seen) pthread_cond_wait(&pool->start, &pool->lock);
+        if (pool->quit) break;
+        seen = pool->generation;
+        if (w >= pool->active) continue;
+
+        sv_job_t job = pool->jobs[w];
+        pthread_mutex_unlock(&pool->lock);
+        job.fn(pool->sv, job.ctx, job.b0, job.b1, w);
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) pthread_cond_signal(&pool->done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return 0;
+}
+
+// Si no se puede crear un hilo, el pool se queda con los que haya
+static sv_pool_t *sv_pool_get(statevec_t *sv) {
+    if (sv->pool) return (sv_pool_t *)sv->pool;
+    sv_pool_t *pool = (sv_pool_t *)calloc(1, sizeof(sv_pool_t));
+    if (!pool) return 0;
+    pool->sv = sv;
+    pthread_mutex_init(&pool->lock, 0);
+    pthread_cond_init(&pool->start, 0);
+    pthread_cond_init(&pool->done, 0);
+    for (uint32_t w = 1; w < sv->n_threads; w++) {
+        pool->args[w].pool = pool;
+        pool->args[w].worker = w;
+        if (pthread_create(&pool->threads[w], 0, sv_worker, &pool->args[w]) != 0) break;
+        pool->n_workers = w;
+    }
+    sv->pool = pool;
+    return pool;
+}
+
+static void sv_pool_destroy(statevec_t *sv) {
+    sv_pool_t *pool = (sv_pool_t *)sv->pool;
+    if (!pool) return;
+    pthread_mutex_lock(&pool->lock);
+    pool->quit = 1;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+    for (uint32_t w = 1; w <= pool->n_workers; w++) pthread_join(pool->threads[w], 0);
+    pthread_cond_destroy(&pool->start);
+    pthread_cond_destroy(&pool->done);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+    sv->pool = 0;
+}
+
+// Ejecuta fn sobre [0, blocks) en rangos contiguos. Retorna los hilos usados.
+static uint32_t sv_parallel(statevec_t *sv, uint64_t blocks, sv_task_fn fn, void *ctx) {
+    uint32_t nt = (sv->n_qubits >= SV_PARALLEL_MIN_QUBITS) ? sv->n_threads : 1;
+    if (nt > blocks) nt = (uint32_t)blocks;
+    if (nt <= 1) {
+        fn(sv, ctx, 0, blocks, 0);
+        return 1;
+    }
+
+    sv_pool_t *pool = sv_pool_get(sv);
+    uint32_t hired = pool ? pool->n_workers + 1 : 1;  // Trabajos que van a hilos del pool: [1, hired)
+    if (hired > nt) hired = nt;
+    sv_job_t jobs[SV_MAX_THREADS];
+    for (uint32_t w = 0; w < nt; w++) {
+        jobs[w].fn = fn;
+        jobs[w].ctx = ctx;
+        jobs[w].b0 = blocks * w / nt;
+        jobs[w].b1 = blocks * (w + 1) / nt;
+    }
+
+    if (hired > 1) {
+        pthread_mutex_lock(&pool->lock);
+        for (uint32_t w = 1; w < hired; w++) pool->jobs[w] = jobs[w];
+        pool->active = hired;
+        pool->pending = hired - 1;
+        pool->generation++;
+        pthread_cond_broadcast(&pool->start);
+        pthread_mutex_unlock(&pool->lock);
+    }
+    // El llamador hace el trabajo 0 y los que no tienen hilo
+    fn(sv, ctx, jobs[0].b0, jobs[0].b1, 0);
+    for (uint32_t w = hired; w < nt; w++) fn(sv, ctx, jobs[w].b0, jobs[w].b1, w);
+    if (hired > 1) {
+        pthread_mutex_lock(&pool->lock);
+        while (pool->pending) pthread_cond_wait(&pool->done, &pool->lock);
+        pthread_mutex_unlock(&pool->lock);
+    }
+    return nt;
+}
+
+// ============================================================================
+// KERNEL DE PUERTA 2x2 (rango de pares k: i0 = k con un 0 insertado en target)
+// ============================================================================
+
+static inline uint64_t pair_index(uint64_t k, uint32_t t) {
+    uint64_t lo = (1ULL << t) - 1;
+    return ((k & ~lo) << 1) | (k & lo);
+}
+
+static void op_pairs_c(statevec_t *sv, const sv_op_t *op, uint64_t k0, uint64_t k1) {
+    float *re = sv->re, *im = sv->im;
+    uint64_t s = 1ULL << op->target;
+    const float (*m)[2] = op->m;
+
+    for (uint64_t k = k0; k < k1; k++) {
+        uint64_t i0 = pair_index(k, op->target);
+        if ((i0 & op->ctrl) != op->ctrl) continue;
+        uint64_t i1 = i0 | s;
+        float ar = re[i0], ai = im[i0], br = re[i1], bi = im[i1];
+        re[i0] = m[0][0] * ar - m[0][1] * ai + m[1][0] * br - m[1][1] * bi;
+        im[i0] = m[0][0] * ai + m[0][1] * ar + m[1][0] * bi + m[1][1] * br;
+        re[i1] = m[2][0] * ar - m[2][1] * ai + m[3][0] * br - m[3][1] * bi;
+        im[i1] = m[2][0] * ai + m[2][1] * ar + m[3][0] * bi + m[3][1] * br;
+    }
+}
+
+#ifdef SV_HAVE_AVX2
+
+#define AVX2_FN static inline __attribute__((target("avx2,fma")))
+
+// (cr + i·ci)·(xr + i·xi) + acc
+AVX2_FN void avx2_cmac(__m256 *accr, __m256 *acci, __m256 cr, __m256 ci, __m256 xr, __m256 xi) {
+    *accr = _mm256_fmadd_ps(cr, xr, _mm256_fnmadd_ps(ci, xi, *accr));
+    *acci = _mm256_fmadd_ps(cr, xi, _mm256_fmadd_ps(ci, xr, *acci));
+}
+
+// -1 en los carriles cuyo índice i + l tiene todos los bits de control
+AVX2_FN __m256 avx2_ctrl_mask(uint64_t i, uint32_t ctrl) {
+    __m256i idx = _mm256_add_epi32(_mm256_set1_epi32((int32_t)i), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256i c = _mm256_set1_epi32((int32_t)ctrl);
+    return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(idx, c), c));
+}
+
+// target >= 3: 8 pares por iteración, i0 e i1 en vectores contiguos. k0, k1 múltiplos de 8.
+static __attribute__((target("avx2,fma")))
+void op_pairs_wide_avx2(statevec_t *sv, const sv_op_t *op, uint64_t k0, uint64_t k1) {
+    float *re = sv->re, *im = sv->im;
+    uint64_t s = 1ULL << op->target;
+    const __m256 m00r = _mm256_set1_ps(op->m[0][0]), m00i = _mm256_set1_ps(op->m[0][1]);
+    const __m256 m01r = _mm256_set1_ps(op->m[1][0]), m01i = _mm256_set1_ps(op->m[1][1]);
+    const __m256 m10r = _mm256_set1_ps(op->m[2][0]), m10i = _mm256_set1_ps(op->m[2][1]);
+    const __m256 m11r = _mm256_set1_ps(op->m[3][0]), m11i = _mm256_set1_ps(op->m[3][1]);
+
+    for (uint64_t k = k0; k < k1; k += 8) {
+        uint64_t i0 = pair_index(k, op->target), i1 = i0 | s;
+        // Control por encima de los 3 bits de carril: igual para los 8 pares
+        if (!(op->ctrl & 7) && (i0 & op->ctrl) != op->ctrl) continue;
+
+        __m256 ar = _mm256_load_ps(re + i0), ai = _mm256_load_ps(im + i0);
+        __m256 br = _mm256_load_ps(re + i1), bi = _mm256_load_ps(im + i1);
+        __m256 nr0 = _mm256_setzero_ps(), ni0 = _mm256_setzero_ps();
+        __m256 nr1 = _mm256_setzero_ps(), ni1 = _mm256_setzero_ps();
+        avx2_cmac(&nr0, &ni0, m00r, m00i, ar, ai);
+        avx2_cmac(&nr0, &ni0, m01r, m01i, br, bi);
+        avx2_cmac(&nr1, &ni1, m10r, m10i, ar, ai);
+        avx2_cmac(&nr1, &ni1, m11r, m11i, br, bi);
+
+        if (op->ctrl & 7) {
+            __m256 keep = avx2_ctrl_mask(i0, op->ctrl);
+            nr0 = _mm256_blendv_ps(ar, nr0, keep);
+            ni0 = _mm256_blendv_ps(ai, ni0, keep);
+            nr1 = _mm256_blendv_ps(br, nr1, keep);
+            ni1 = _mm256_blendv_ps(bi, ni1, keep);
+        }
+        _mm256_store_ps(re + i0, nr0);
+        _mm256_store_ps(im + i0, ni0);
+        _mm256_store_ps(re + i1, nr1);
+        _mm256_store_ps(im + i1, ni1);
+    }
+}
+
+// target < 3: la pareja de cada carril está en el mismo vector (carril l ^ 2^t).
+// Cada carril combina su amplitud y la de su pareja con coeficientes por carril.
+// Recorre las amplitudes [2·k0, 2·k1); k0, k1 múltiplos de 8.
+static __attribute__((target("avx2,fma")))
+void op_pairs_narrow_avx2(statevec_t *sv, const sv_op_t *op, uint64_t k0, uint64_t k1) {
+    float *re = sv->re, *im = sv->im;
+    uint32_t t = op->target;
+    float self_r[8], self_i[8], part_r[8], part_i[8];
+    int32_t perm[8];
+
+    for (int l = 0; l < 8; l++) {
+        int bit = (l >> t) & 1;
+        self_r[l] = op->m[bit ? 3 : 0][0];
+        self_i[l] = op->m[bit ? 3 : 0][1];
+        part_r[l] = op->m[bit ? 2 : 1][0];
+        part_i[l] = op->m[bit ? 2 : 1][1];
+        perm[l] = l ^ (1 << t);
+    }
+    const __m256 sr = _mm256_loadu_ps(self_r), si = _mm256_loadu_ps(self_i);
+    const __m256 pr = _mm256_loadu_ps(part_r), pi = _mm256_loadu_ps(part_i);
+    const __m256i vp = _mm256_loadu_si256((const __m256i *)perm);
+
+    for (uint64_t i = 2 * k0; i < 2 * k1; i += 8) {
+        __m256 xr = _mm256_load_ps(re + i), xi = _mm256_load_ps(im + i);
+        __m256 yr = _mm256_permutevar8x32_ps(xr, vp), yi = _mm256_permutevar8x32_ps(xi, vp);
+        __m256 nr = _mm256_setzero_ps(), ni = _mm256_setzero_ps();
+        avx2_cmac(&nr, &ni, sr, si, xr, xi);
+        avx2_cmac(&nr, &ni, pr, pi, yr, yi);
+
+        if (op->ctrl) {
+            __m256 keep = avx2_ctrl_mask(i, op->ctrl);
+            nr = _mm256_blendv_ps(xr, nr, keep);
+            ni = _mm256_blendv_ps(xi, ni, keep);
+        }
+        _mm256_store_ps(re + i, nr);
+        _mm256_store_ps(im + i, ni);
+    }
+}
+
+#endif // SV_HAVE_AVX2
+
+static void op_pairs(statevec_t *sv, const sv_op_t *op, uint64_t k0, uint64_t k1) {
+#ifdef SV_HAVE_AVX2
+    if (sv_use_avx2 && !((k0 | k1) & 7)) {
+        if (op->target >= 3) op_pairs_wide_avx2(sv, op, k0, k1);
+        else op_pairs_narrow_avx2(sv, op, k0, k1);
+        return;
+    }
+#endif
+    op_pairs_c(sv, op, k0, k1);
+}
+
+// ============================================================================
+// APLICACIÓN DE PUERTAS
+// ============================================================================
+
+static sv_op_t sv_make_op(const sv_gate_t *g) {
+    sv_op_t op = { { { 0 } }, g->target, 0 };
+    const float h = 0.70710678118654752f;
+
+    switch (g->type) {
+        case SV_GATE_H:
+            op.m[0][0] = h; op.m[1][0] = h; op.m[2][0] = h; op.m[3][0] = -h;
+            break;
+        case SV_GATE_CNOT:
+            op.ctrl = 1u << g->control;
+            /* fallthrough */
+        case SV_GATE_X:
+            op.m[1][0] = 1.0f; op.m[2][0] = 1.0f;
+            break;
+        case SV_GATE_Z:
+            op.m[0][0] = 1.0f; op.m[3][0] = -1.0f;
+            break;
+        case SV_GATE_PHASE:
+            op.m[0][0] = 1.0f;
+            op.m[3][0] = cosf(g->theta);
+            op.m[3][1] = sinf(g->theta);
+            break;
+    }
+    return op;
+}
+
+// Racha de puertas que no salen del bloque: se aplican todas a cada bloque
+typedef struct {
+    const sv_op_t *ops;
+    size_t n;
+} sv_run_t;
+
+static void task_block_run(statevec_t *sv, void *ctx, uint64_t b0, uint64_t b1, uint32_t worker) {
+    const sv_run_t *run = (const sv_run_t *)ctx;
+    uint64_t pairs = 1ULL << (sv_block_qubits(sv) - 1);
+    (void)worker;
+
+    for (uint64_t b = b0; b < b1; b++) {
+        for (size_t g = 0; g < run->n; g++) {
+            op_pairs(sv, &run->ops[g], b * pairs, (b + 1) * pairs);
+        }
+    }
+}
+
+static void sv_apply_ops(statevec_t *sv, const sv_op_t *ops, size_t n) {
+    sv_run_t run = { ops, n };
+    sv_parallel(sv, sv->dim >> sv_block_qubits(sv), task_block_run, &run);
+}
+
+static int sv_gate_in_block(const statevec_t *sv, const sv_gate_t *g) {
+    uint32_t b = sv_block_qubits(sv);
+    return g->target < b && (g->type != SV_GATE_CNOT || g->control < b);
+}
+
+// Qubits fuera del registro (pair_index saldría de dim) y CNOT sobre sí mismo
+static int sv_gate_valid(const statevec_t *sv, const sv_gate_t *g) {
+    if (g->target >= sv->n_qubits) return 0;
+    return g->type != SV_GATE_CNOT || (g->control < sv->n_qubits && g->control != g->target);
+}
+
+#define SV_RUN_MAX 64
+
+void statevec_apply(statevec_t *sv, const sv_gate_t *gates, size_t n) {
+    sv_op_t ops[SV_RUN_MAX];
+    size_t i = 0;
+
+    while (i < n) {
+        if (!sv_gate_valid(sv, &gates[i])) {
+            i++; // Puerta inválida: no-op
+            continue;
+        }
+        if (!sv_gate_in_block(sv, &gates[i])) {
+            // Qubit alto: los pares están a >= 2^B, una pasada completa por puerta
+            // (el rango de pares de cada bloque lógico sigue siendo contiguo)
+            ops[0] = sv_make_op(&gates[i++]);
+            sv_apply_ops(sv, ops, 1);
+            continue;
+        }
+        size_t m = 0;
+        while (i < n && m < SV_RUN_MAX && sv_gate_valid(sv, &gates[i]) && sv_gate_in_block(sv, &gates[i])) {
+            ops[m++] = sv_make_op(&gates[i++]);
+        }
+        sv_apply_ops(sv, ops, m);
+    }
+}
+
+static void sv_apply_one(statevec_t *sv, sv_gate_type_t type, uint32_t target, uint32_t control, float theta) {
+    sv_gate_t g = { type, target, control, theta };
+    statevec_apply(sv, &g, 1);
+}
+
+void statevec_h(statevec_t *sv, uint32_t target) { sv_apply_one(sv, SV_GATE_H, target, 0, 0.0f); }
+void statevec_x(statevec_t *sv, uint32_t target) { sv_apply_one(sv, SV_GATE_X, target, 0, 0.0f); }
+void statevec_z(statevec_t *sv, uint32_t target) { sv_apply_one(sv, SV_GATE_Z, target, 0, 0.0f); }
+
+void statevec_phase(statevec_t *sv, uint32_t target, float theta) {
+    sv_apply_one(sv, SV_GATE_PHASE, target, 0, theta);
+}
+
+void statevec_cnot(statevec_t *sv, uint32_t control, uint32_t target) {
+    sv_apply_one(sv, SV_GATE_CNOT, target, control, 0.0f);
+}
+
+// ============================================================================
+// REDUCCIONES, GROVER Y MEDIDA
+// ============================================================================
+
+typedef struct {
+    double acc[SV_MAX_THREADS][2];
+    float mean_r, mean_i;   // Difusión: 2·media
+    uint32_t qubit;         // prob_one
+    float fill;             // uniform
+} sv_reduce_t;
+
+#ifdef SV_HAVE_AVX2
+// Σ re, Σ im sobre [i, end) en doble precisión; retorna dónde empieza la cola
+static __attribute__((target("avx2,fma")))
+uint64_t sum_avx2(const statevec_t *sv, uint64_t i, uint64_t end, double *sr, double *si) {
+    __m256d ar = _mm256_setzero_pd(), ai = _mm256_setzero_pd();
+    for (; i + 8 <= end; i += 8) {
+        __m256 xr = _mm256_load_ps(sv->re + i), xi = _mm256_load_ps(sv->im + i);
+        ar = _mm256_add_pd(ar, _mm256_add_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(xr)),
+                                             _mm256_cvtps_pd(_mm256_extractf128_ps(xr, 1))));
+        ai = _mm256_add_pd(ai, _mm256_add_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(xi)),
+                                             _mm256_cvtps_pd(_mm256_extractf128_ps(xi, 1))));
+    }
+    double lr[4], li[4];
+    _mm256_storeu_pd(lr, ar);
+    _mm256_storeu_pd(li, ai);
+    *sr = lr[0] + lr[1] + lr[2] + lr[3];
+    *si = li[0] + li[1] + li[2] + li[3];
+    return i;
+}
+
+// amp = 2·media - amp sobre [i, end); retorna dónde empieza la cola
+static __attribute__((target("avx2,fma")))
+uint64_t invert_avx2(statevec_t *sv, uint64_t i, uint64_t end, float mean_r, float mean_i) {
+    const __m256 mr = _mm256_set1_ps(mean_r), mi = _mm256_set1_ps(mean_i);
+    for (; i + 8 <= end; i += 8) {
+        _mm256_store_ps(sv->re + i, _mm256_sub_ps(mr, _mm256_load_ps(sv->re + i)));
+        _mm256_store_ps(sv->im + i, _mm256_sub_ps(mi, _mm256_load_ps(sv->im + i)));
+    }
+    return i;
+}
+#endif
+
+static void task_sum(statevec_t *sv, void *ctx, uint64_t b0, uint64_t b1, uint32_t worker) {
+    sv_reduce_t *r = (sv_reduce_t *)ctx;
+    uint32_t bq = sv_block_qubits(sv);
+    uint64_t i = b0 << bq, end = b1 << bq;
+    double sr = 0.0, si = 0.0;
+
+#ifdef SV_HAVE_AVX2
+    if (sv_use_avx2) i = sum_avx2(sv, i, end, &sr, &si);
+#endif
+    for (; i < end; i++) {
+        sr += sv->re[i];
+        si += sv->im[i];
+    }
+    r->acc[worker][0] = sr;
+    r->acc[worker][1] = si;
+}
+
+static void task_invert(statevec_t *sv, void *ctx, uint64_t b0, uint64_t b1, uint32_t worker) {
+    const sv_reduce_t *r = (const sv_reduce_t *)ctx;
+    uint32_t bq = sv_block_qubits(sv);
+    uint64_t i = b0 << bq, end = b1 << bq;
+    (void)worker;
+
+#ifdef SV_HAVE_AVX2
+    if (sv_use_avx2) i = invert_avx2(sv, i, end, r->mean_r, r->mean_i);
+#endif
+    for (; i < end; i++) {
+        sv->re[i] = r->mean_r - sv->re[i];
+        sv->im[i] = r->mean_i - sv->im[i];
+    }
+}
+
+static void task_prob_one(statevec_t *sv, void *ctx, uint64_t b0, uint64_t b1, uint32_t worker) {
+    sv_reduce_t *r = (sv_reduce_t *)ctx;
+    uint32_t bq = sv_block_qubits(sv);
+    uint64_t bit = 1ULL << r->qubit;
+    double p = 0.0;
+
+    for (uint64_t i = b0 << bq; i < (b1 << bq); i++) {
+        if (i & bit) p += (double)sv->re[i] * sv->re[i] + (double)sv->im[i] * sv->im[i];
+    }
+    r->acc[worker][0] = p;
+}
+
+static void task_fill(statevec_t *sv, void *ctx, uint64_t b0, uint64_t b1, uint32_t worker) {
+    const sv_reduce_t *r = (const sv_reduce_t *)ctx;
+    uint32_t bq = sv_block_qubits(sv);
+    (void)worker;
+
+    for (uint64_t i = b0 << bq; i < (b1 << bq); i++) {
+        sv->re[i] = r->fill;
+        sv->im[i] = 0.0f;
+    }
+}
+
+void statevec_oracle(statevec_t *sv, uint64_t marked) {
+    if (marked >= sv->dim) return;
+    sv->re[marked] = -sv->re[marked];
+    sv->im[marked] = -sv->im[marked];
+}
+
+void statevec_diffusion(statevec_t *sv) {
+    sv_reduce_t r;
+    uint32_t nt = sv_parallel(sv, sv->dim >> sv_block_qubits(sv), task_sum, &r);
+
+    double sr = 0.0, si = 0.0;
+    for (uint32_t w = 0; w < nt; w++) {
+        sr += r.acc[w][0];
+        si += r.acc[w][1];
+    }
+    r.mean_r = (float)(2.0 * sr / (double)sv->dim);
+    r.mean_i = (float)(2.0 * si / (double)sv->dim);
+    sv_parallel(sv, sv->dim >> sv_block_qubits(sv), task_invert, &r);
+}
+
+void statevec_uniform(statevec_t *sv) {
+    sv_reduce_t r;
+    r.fill = (float)(1.0 / sqrt((double)sv->dim));
+    sv_parallel(sv, sv->dim >> sv_block_qubits(sv), task_fill, &r);
+}
+
+void statevec_grover(statevec_t *sv, uint64_t marked, uint32_t iterations) {
+    statevec_uniform(sv);
+    for (uint32_t k = 0; k < iterations; k++) {
+        statevec_oracle(sv, marked);
+        statevec_diffusion(sv);
+    }
+}
+
+double statevec_prob_one(const statevec_t *sv, uint32_t qubit) {
+    if (qubit >= sv->n_qubits) return 0.0;
+    sv_reduce_t r;
+    r.qubit = qubit;
+    uint32_t nt = sv_parallel((statevec_t *)sv, sv->dim >> sv_block_qubits(sv), task_prob_one, &r);
+
+    double p = 0.0;
+    for (uint32_t w = 0; w < nt; w++) p += r.acc[w][0];
+    return p;
+}
+
+// splitmix64 -> uniforme en [0, 1)
+static double sv_uniform01(statevec_t *sv) {
+    uint64_t z = (sv->rng += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return (double)(z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+uint32_t statevec_measure(statevec_t *sv, uint32_t qubit) {
+    if (qubit >= sv->n_qubits) return 0;
+    double p1 = statevec_prob_one(sv, qubit);
+    uint32_t outcome = (sv_uniform01(sv) < p1) ? 1u : 0u;
+    double p = outcome ? p1 : 1.0 - p1;
+    float scale = (p > 0.0) ? (float)(1.0 / sqrt(p)) : 0.0f;
+
+    // Proyector sobre el resultado, renormalizado
+    sv_op_t op = { { { 0 } }, qubit, 0 };
+    op.m[outcome ? 3 : 0][0] = scale;
+    sv_apply_ops(sv, &op, 1);
+    return outcome;
+}
+
+uint64_t statevec_sample(statevec_t *sv) {
+    double u = sv_uniform01(sv);
+    double acc = 0.0;
+    for (uint64_t i = 0; i < sv->dim; i++) {
+        acc += (double)sv->re[i] * sv->re[i] + (double)sv->im[i] * sv->im[i];
+        if (u < acc) return i;
+    }
+    return sv->dim - 1;
+}
+
+// ============================================================================
+// CICLO DE VIDA
+// ============================================================================
+
+statevec_t *statevec_create(uint32_t n_qubits, uint32_t n_threads, uint64_t seed) {
+    if (n_qubits == 0 || n_qubits > SV_MAX_QUBITS) return 0;
+
+#ifdef SV_HAVE_AVX2
+    if (sv_use_avx2 < 0) sv_use_avx2 = arch_probe_vector() && __builtin_cpu_supports("fma");
+#endif
+
+    statevec_t *sv = (statevec_t *)calloc(1, sizeof(statevec_t));
+    if (!sv) return 0;
+
+    sv->n_qubits = n_qubits;
+    sv->dim = 1ULL << n_qubits;
+    // Al menos 8 floats: los kernels AVX2 trabajan con vectores alineados completos
+    size_t bytes = (size_t)((sv->dim < 16) ? 16 : sv->dim) * sizeof(float);
+    if (posix_memalign((void **)&sv->re, 64, bytes) != 0) sv->re = 0;
+    if (posix_memalign((void **)&sv->im, 64, bytes) != 0) sv->im = 0;
+    if (!sv->re || !sv->im) {
+        statevec_destroy(sv);
+        return 0;
+    }
+
+    if (n_threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        n_threads = (online > 0) ? (uint32_t)online : 1;
+    }
+    sv->n_threads = (n_threads > SV_MAX_THREADS) ? SV_MAX_THREADS : n_threads;
+    sv->rng = seed ? seed : 0x51425247ULL;
+
+    statevec_reset(sv);
+    return sv;
+}
+
+void statevec_destroy(statevec_t *sv) {
+    if (!sv) return;
+    sv_pool_destroy(sv);
+    free(sv->re);
+    free(sv->im);
+    free(sv);
+}
+
+void statevec_reset(statevec_t *sv) {
+    sv_reduce_t r;
+    r.fill = 0.0f;
+    sv_parallel(sv, sv->dim >> sv_block_qubits(sv), task_fill, &r);
+    sv->re[0] = 1.0f;
+}
+
+// ============================================================================
+// FUENTE DE COLAPSOS DEL BRIDGE (modo simulación)
+// ============================================================================
+
+static statevec_t *bridge_sv = 0;
+static uint32_t bridge_qubit = 0;
+
+static uint8_t statevec_bridge_source(uint8_t phase) {
+    const float theta = (float)phase * (float)(2.0 * M_PI / 128.0);
+    const sv_gate_t interferometer[3] = {
+        { SV_GATE_H, bridge_qubit, 0, 0.0f },
+        { SV_GATE_PHASE, bridge_qubit, 0, theta },
+        { SV_GATE_H, bridge_qubit, 0, 0.0f },
+    };
+    statevec_apply(bridge_sv, interferometer, 3);
+    return (uint8_t)statevec_measure(bridge_sv, bridge_qubit);
+}
+
+void statevec_attach_bridge(statevec_t *sv, uint32_t qubit) {
+    if (!sv || qubit >= sv->n_qubits) {
+        bridge_sv = 0;
+        bridge_set_sim_source(0);
+        return;
+    }
+    bridge_sv = sv;
+    bridge_qubit = qubit;
+    bridge_set_sim_source(statevec_bridge_source);
+}
@@ -0,0 +1,121 @@
+#include "../include/qcore_trap.h"
+#include "../include/qcore_port.h"
+#include "../include/qcore_uart.h"
+
+_Static_assert(sizeof(trap_frame_t) == TRAP_FRAME_SIZE, "Actualizar TRAP_FRAME_SIZE en entry.S");
+
+// Manejadores de interrupciones externas (una entrada por fuente PLIC)
+static irq_handler_t irq_table[PLIC_MAX_IRQ];
+
+#define MMIO32(addr) (*(volatile uint32_t *)(uintptr_t)(addr))
+#define MMIO64(addr) (*(volatile uint64_t *)(uintptr_t)(addr))
+
+void trap_init(void) {
+    // Todas las fuentes deshabilitadas; umbral 0 (cualquier prioridad > 0 pasa)
+    for (uint32_t w = 0; w < PLIC_MAX_IRQ / 32; w++) {
+        MMIO32(PLIC_ENABLE(w)) = 0;
+    }
+    MMIO32(PLIC_THRESHOLD) = 0;
+    MMIO32(CLINT_MSIP) = 0;
+
+    // Solo interrupciones externas y software; el timer se arma bajo demanda
+    __asm__ volatile ("csrw mie, %0" :: "r" ((1UL << IRQ_M_EXT) | (1UL << IRQ_M_SOFT)));
+    __asm__ volatile ("csrsi mstatus, 8" ::: "memory");
+}
+
+void trap_register_irq(uint32_t irq, irq_handler_t handler) {
+    if (irq == 0 || irq >= PLIC_MAX_IRQ) return;
+    irq_table[irq] = handler;
+}
+
+void plic_enable_irq(uint32_t irq) {
+    MMIO32(PLIC_PRIORITY(irq)) = 1;
+    MMIO32(PLIC_ENABLE(irq / 32)) |= (1u << (irq % 32));
+}
+
+void plic_disable_irq(uint32_t irq) {
+    MMIO32(PLIC_ENABLE(irq / 32)) &= ~(1u << (irq % 32));
+}
+
+void clint_arm_timer(uint64_t delta_ticks) {
+    MMIO64(CLINT_MTIMECMP) = MMIO64(CLINT_MTIME) + delta_ticks;
+    __asm__ volatile ("csrs mie, %0" :: "r" (1UL << IRQ_M_TIMER));
+}
+
+void clint_disarm_timer(void) {
+    __asm__ volatile ("csrc mie, %0" :: "r" (1UL << IRQ_M_TIMER));
+}
+
+// Lectura del puerto MMQI sin hardware detrás (Load Access Fault):
+// se emula como lectura de 0 para que el handshake caiga a simulación.
+static int emulate_mmqi_load(trap_frame_t *frame, unsigned long mtval) {
+    if (mtval < QPORT_BASE_ADDR || mtval >= QPORT_BASE_ADDR + QPORT_MMIO_SIZE) return 0;
+
+    uint16_t lo = *(const uint16_t *)(uintptr_t)frame->mepc;
+    uint32_t rd;
+    uint32_t len;
+    if ((lo & 3) != 3) {
+        // RVC: c.lw / c.ld (quadrant 0), rd' en bits [4:2]
+        uint32_t funct3 = lo >> 13;
+        if ((lo & 3) != 0 || (funct3 != 2 && funct3 != 3)) return 0;
+        rd = 8 + ((lo >> 2) & 7);
+        len = 2;
+    } else {
+        uint32_t insn = lo | ((uint32_t)*(const uint16_t *)(uintptr_t)(frame->mepc + 2) << 16);
+        if ((insn & 0x7F) != 0x03) return 0; // Opcode LOAD
+        rd = (insn >> 7) & 0x1F;
+        len = 4;
+    }
+
+    if (rd != 0) frame->regs[rd] = 0;
+    frame->mepc += len;
+    return 1;
+}
+
+void trap_handler(trap_frame_t *frame) {
+    unsigned long mcause;
+    __asm__ volatile ("csrr %0, mcause" : "=r" (mcause));
+
+    if (mcause & MCAUSE_INTERRUPT) {
+        switch (mcause & 0xFF) {
+            case IRQ_M_EXT: {
+                // Claim/complete hasta vaciar las fuentes pendientes
+                uint32_t irq;
+                while ((irq = MMIO32(PLIC_CLAIM)) != 0) {
+                    if (irq < PLIC_MAX_IRQ && irq_table[irq]) {
+                        irq_table[irq](irq);
+                    } else {
+                        plic_disable_irq(irq); // Fuente sin dueño: silenciarla
+                    }
+                    MMIO32(PLIC_CLAIM) = irq;
+                }
+                break;
+            }
+            case IRQ_M_TIMER:
+                clint_disarm_timer(); // Un solo disparo: solo despierta al wfi
+                break;
+            case IRQ_M_SOFT:
+                MMIO32(CLINT_MSIP) = 0;
+                break;
+            default:
+                break;
+        }
+        return;
+    }
+
+    unsigned long mtval;
+    __asm__ volatile ("csrr %0, mtval" : "=r" (mtval));
+    if (mcause == EXC_LOAD_ACCESS_FAULT && emulate_mmqi_load(frame, mtval)) {
+        return;
+    }
+
+    // Excepción no recuperable: nos quedamos parados para evitar corrupción
+    uart_puts("\n\r!! TRAP: UNRECOVERABLE EXCEPTION mcause=");
+    uart_print_hex((uint32_t)mcause);
+    uart_puts(" mepc=");
+    uart_print_hex((uint32_t)frame->mepc);
+    uart_puts(" !!\n\r");
+    for (;;) {
+        trap_wfi();
+    }
+}
@@ -0,0 +1,53 @@
+#include "../include/qcore_trap.h"
+
+/**
+ * PLIC del host (solo libqcore.so)
+ * Tabla de manejadores, habilitación y una línea de nivel por fuente. El
+ * emulador de QPU sube y baja la línea de cada placa junto con DATA_READY;
+ * trap_irq_window() atiende las líneas activas y habilitadas en el hilo que
+ * espera, como lo haría trap_handler en la hart 0. Así los ISR reales
+ * (bridge_collapse_isr, qport_table_isr) se ejecutan en los tests.
+ */
+
+static irq_handler_t irq_table[PLIC_MAX_IRQ];
+static uint64_t irq_enabled = 0;
+static uint64_t irq_line = 0;
+
+void trap_register_irq(uint32_t irq, irq_handler_t handler) {
+    if (irq == 0 || irq >= PLIC_MAX_IRQ) return;
+    __atomic_store_n(&irq_table[irq], handler, __ATOMIC_SEQ_CST);
+}
+
+void plic_enable_irq(uint32_t irq) {
+    if (irq >= PLIC_MAX_IRQ) return;
+    __atomic_fetch_or(&irq_enabled, 1ULL << irq, __ATOMIC_SEQ_CST);
+}
+
+void plic_disable_irq(uint32_t irq) {
+    if (irq >= PLIC_MAX_IRQ) return;
+    __atomic_fetch_and(&irq_enabled, ~(1ULL << irq), __ATOMIC_SEQ_CST);
+}
+
+void trap_host_set_irq_line(uint32_t irq, int level) {
+    if (irq >= PLIC_MAX_IRQ) return;
+    if (level) {
+        __atomic_fetch_or(&irq_line, 1ULL << irq, __ATOMIC_SEQ_CST);
+    } else {
+        __atomic_fetch_and(&irq_line, ~(1ULL << irq), __ATOMIC_SEQ_CST);
+    }
+}
+
+void trap_irq_window(void) {
+    uint64_t ready = __atomic_load_n(&irq_line, __ATOMIC_SEQ_CST) &
+                     __atomic_load_n(&irq_enabled, __ATOMIC_SEQ_CST);
+    while (ready) {
+        uint32_t irq = (uint32_t)__builtin_ctzll(ready);
+        ready &= ready - 1;
+        irq_handler_t handler = __atomic_load_n(&irq_table[irq], __ATOMIC_SEQ_CST);
+        if (handler) {
+            handler(irq);
+        } else {
+            plic_disable_irq(irq); // Fuente sin dueño: silenciarla
+        }
+    }
+}
@@ -1,11 +1,10 @@
 #include "../include/qcore_viz.h"
 #include "../include/qcore_uart.h"
+#include "../include/qcore_entropy.h"
 
-static uint32_t next = 1;
-
+// Servido por el pool de entropía (qcore_entropy.c)
 uint32_t pseudo_random(void) {
-    next = next * 1103515245 + 12345;
-    return (uint32_t)(next / 65536) % 32768;
+    return entropy_next32();
 }
 
 void visualize_laminar_flow(float entropy) {
@@ -19,9 +18,12 @@ void visualize_laminar_flow(float entropy) {
     uart_puts(color);
     
     // Generamos una línea de "lluvia binaria" basada en la fragmentación
+    // (una palabra del pool por columna: gota y dígito)
+    uint32_t drops[80];
+    entropy_fill(drops, 80);
     for (int i = 0; i < 80; i++) {
-        if (pseudo_random() % 10 > 7) {
-            uart_putc((pseudo_random() % 2) ? '1' : '0');
+        if (drops[i] % 10 > 7) {
+            uart_putc(((drops[i] >> 16) & 1) ? '1' : '0');
         } else {
             uart_putc(' '); // Espacios para el efecto de gotas
         }
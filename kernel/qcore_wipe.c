@@ -0,0 +1,178 @@
+#include "../include/qcore_wipe.h"
+#include "../include/qcore_port.h"
+#include "../include/qcore_trap.h"
+
+#define WIPE_GOLDEN_64 0x9E3779B97F4A7C15ULL // φ·2^64 (incremento de splitmix64)
+
+// Finalizador de splitmix64: biyectivo, avalancha completa en 64 bits
+static inline uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t keystream(const uint64_t *pool, uint64_t i) {
+    return mix64(pool[i & (WIPE_POOL_WORDS - 1)] + i * WIPE_GOLDEN_64);
+}
+
+_Static_assert((WIPE_POOL_WORDS & (WIPE_POOL_WORDS - 1)) == 0, "WIPE_POOL_WORDS debe ser potencia de 2");
+_Static_assert(WIPE_CHUNK_BYTES % 64 == 0, "Los trozos deben ser líneas de caché completas");
+
+void wipe_job_init(wipe_job_t *job, const uint64_t *pool) {
+    uint8_t *raw = (uint8_t *)job;
+    for (size_t k = 0; k < sizeof(*job); k++) raw[k] = 0;
+
+    for (uint32_t k = 0; k < WIPE_POOL_WORDS; k++) {
+        if (pool) {
+            job->pool[k] = pool[k];
+        } else {
+            // Un puerto sin hardware lee 0: el tick evita una clave constante
+            uint64_t hi = QPORT->DATA_LATCH;
+            uint64_t lo = QPORT->DATA_LATCH;
+            job->pool[k] = ((hi << 32) | lo) ^ get_hardware_tick();
+        }
+    }
+}
+
+int wipe_add_region(wipe_job_t *job, uintptr_t start, uintptr_t end) {
+    if (job->n_regions >= WIPE_MAX_REGIONS) return -1;
+    start = (start + 7) & ~(uintptr_t)7;
+    end &= ~(uintptr_t)7;
+    if (end <= start) return 0;
+
+    wipe_region_t *r = &job->region[job->n_regions++];
+    uint64_t bytes = end - start;
+    r->start = start;
+    r->end = end;
+    r->first_chunk = job->total_chunks;
+    r->n_chunks = (bytes + WIPE_CHUNK_BYTES - 1) / WIPE_CHUNK_BYTES;
+    r->first_word = job->total_bytes / 8;
+    job->total_chunks += r->n_chunks;
+    job->total_bytes += bytes;
+    return 0;
+}
+
+int wipe_add_stack(wipe_job_t *job, uintptr_t bottom, uintptr_t top, uintptr_t live_lo, uintptr_t live_hi) {
+    if (live_lo < bottom) live_lo = bottom;
+    if (live_lo > top) live_lo = top;
+    if (live_hi < live_lo) live_hi = live_lo;
+    if (live_hi > top) live_hi = top;
+    if (job->n_regions + 2 > WIPE_MAX_REGIONS) return -1;
+    wipe_add_region(job, bottom, live_lo);
+    wipe_add_region(job, live_hi, top);
+    return 0;
+}
+
+// n palabras a partir del índice global i, por líneas de 8 palabras
+static void wipe_fill(const uint64_t *pool, uint64_t *dst, size_t n, uint64_t i) {
+    size_t k = 0;
+    for (; k + 8 <= n; k += 8, i += 8) {
+        uint64_t line[8];
+        for (uint32_t l = 0; l < 8; l++) line[l] = keystream(pool, i + l);
+        for (uint32_t l = 0; l < 8; l++) dst[k + l] = line[l];
+    }
+    for (; k < n; k++, i++) dst[k] = keystream(pool, i);
+}
+
+uint64_t wipe_run_worker(wipe_job_t *job) {
+    uint64_t pool[WIPE_POOL_WORDS];
+    for (uint32_t k = 0; k < WIPE_POOL_WORDS; k++) pool[k] = job->pool[k];
+
+    uint64_t mine = 0;
+    for (;;) {
+        uint64_t c = __atomic_fetch_add(&job->next_chunk, 1, __ATOMIC_RELAXED);
+        if (c >= job->total_chunks) break;
+
+        uint32_t r = 0;
+        while (c >= job->region[r].first_chunk + job->region[r].n_chunks) r++;
+        const wipe_region_t *reg = &job->region[r];
+
+        uint64_t off = (c - reg->first_chunk) * WIPE_CHUNK_BYTES;
+        uintptr_t lo = reg->start + off;
+        uintptr_t hi = (reg->end - lo > WIPE_CHUNK_BYTES) ? lo + WIPE_CHUNK_BYTES : reg->end;
+        wipe_fill(pool, (uint64_t *)lo, (hi - lo) / 8, reg->first_word + off / 8);
+
+        __atomic_fetch_add(&job->bytes_done, hi - lo, __ATOMIC_RELEASE);
+        if (__atomic_add_fetch(&job->region_chunks_done[r], 1, __ATOMIC_ACQ_REL) == reg->n_chunks && r == 0) {
+            __atomic_store_n(&job->tick_first_region, get_hardware_tick(), __ATOMIC_RELAXED);
+        }
+        if (__atomic_add_fetch(&job->chunks_done, 1, __ATOMIC_ACQ_REL) == job->total_chunks) {
+            __atomic_store_n(&job->tick_end, get_hardware_tick(), __ATOMIC_RELAXED);
+        }
+        mine++;
+    }
+    return mine;
+}
+
+uint64_t wipe_progress(const wipe_job_t *job) {
+    return __atomic_load_n(&job->bytes_done, __ATOMIC_ACQUIRE);
+}
+
+int wipe_done(const wipe_job_t *job) {
+    return __atomic_load_n(&job->chunks_done, __ATOMIC_ACQUIRE) == job->total_chunks;
+}
+
+uint64_t wipe_keystream_word(const wipe_job_t *job, uint64_t i) {
+    return keystream(job->pool, i);
+}
+
+#if defined(ARCH_RISCV) && !defined(QCORE_TEST_ENV)
+
+#define MMIO32(addr) (*(volatile uint32_t *)(uintptr_t)(addr))
+
+// Buzón de los harts aparcados. Vive en .hart_park (kernel.ld), fuera del
+// .bss que limpia el hart 0 y fuera de las regiones que borra el propio trabajo.
+static struct {
+    uint32_t ready[WIPE_MAX_HARTS];
+    wipe_job_t *job;
+} hart_park __attribute__((section(".hart_park"))) = { { 0 }, 0 };
+
+static void hart_halt(void) {
+    __asm__ volatile ("csrw mie, zero");
+    while (1) __asm__ volatile ("wfi");
+}
+
+void hart_secondary_main(uint64_t hartid) {
+    __atomic_store_n(&hart_park.ready[hartid], 1, __ATOMIC_RELEASE);
+    __asm__ volatile ("csrs mie, %0" :: "r" (1UL << IRQ_M_SOFT));
+
+    // MIE = 0: el MSIP pendiente despierta el wfi sin entrar al trap
+    wipe_job_t *job;
+    while (!(job = __atomic_load_n(&hart_park.job, __ATOMIC_ACQUIRE))) trap_wfi();
+    MMIO32(CLINT_MSIP_HART(hartid)) = 0;
+
+    wipe_run_worker(job);
+    hart_halt();
+}
+
+uint32_t wipe_harts_online(void) {
+    uint32_t n = 0;
+    for (uint32_t h = 1; h < WIPE_MAX_HARTS; h++) {
+        n += __atomic_load_n(&hart_park.ready[h], __ATOMIC_ACQUIRE);
+    }
+    return n;
+}
+
+void wipe_run_all_harts(wipe_job_t *job) {
+    job->tick_start = get_hardware_tick();
+    __atomic_store_n(&hart_park.job, job, __ATOMIC_RELEASE);
+    for (uint32_t h = 1; h < WIPE_MAX_HARTS; h++) {
+        if (__atomic_load_n(&hart_park.ready[h], __ATOMIC_ACQUIRE)) MMIO32(CLINT_MSIP_HART(h)) = 1;
+    }
+
+    wipe_run_worker(job);
+    while (!wipe_done(job)) cpu_relax_yield();
+}
+
+#else
+
+uint32_t wipe_harts_online(void) {
+    return 0;
+}
+
+void wipe_run_all_harts(wipe_job_t *job) {
+    job->tick_start = get_hardware_tick();
+    wipe_run_worker(job);
+}
+
+#endif
@@ -2,10 +2,16 @@ import pytest
 import ctypes
 
 # Define structures
+SURPRISE_CACHE_SIZE = 256
+
 class BayesianAttractor(ctypes.Structure):
     _fields_ = [("mu", ctypes.c_int32 * 2),
                 ("cov", (ctypes.c_int32 * 2) * 2),
-                ("inv_cov", (ctypes.c_int32 * 2) * 2)]
+                ("inv_cov", (ctypes.c_int32 * 2) * 2),
+                ("surprise_cache", ctypes.c_int32 * SURPRISE_CACHE_SIZE),
+                ("cache_valid", ctypes.c_uint32 * (SURPRISE_CACHE_SIZE // 32)),
+                ("cache_hits", ctypes.c_uint32),
+                ("cache_misses", ctypes.c_uint32)]
 
 def test_bayesian_update_convergence(qcore_lib, to_fixed):
     """
@@ -69,3 +75,336 @@ def test_mahalanobis_anomaly(qcore_lib, to_fixed):
     # Anomaly distance should be significantly higher
     assert dist_anomaly > dist_normal
     assert dist_anomaly > to_fixed(1.0) # Heuristic threshold
+
+def test_surprise_cache_hits_and_invalidation(qcore_lib, to_fixed):
+    """
+    La caché por byte de Majorana debe devolver la misma D^2 que el cálculo
+    directo, contar aciertos/fallos y vaciarse cuando el atractor aprende.
+    """
+    init_bayes = qcore_lib.init_bayesian_attractor
+    update = qcore_lib.update_belief
+    calc_mahal = qcore_lib.calculate_mahalanobis_sq
+    cached = qcore_lib.calculate_surprise_cached
+
+    init_bayes.argtypes = [ctypes.POINTER(BayesianAttractor)]
+    update.argtypes = [ctypes.POINTER(BayesianAttractor), ctypes.c_int32, ctypes.c_int32]
+    calc_mahal.argtypes = [ctypes.POINTER(BayesianAttractor), ctypes.c_int32, ctypes.c_int32]
+    calc_mahal.restype = ctypes.c_int32
+    cached.argtypes = [ctypes.POINTER(BayesianAttractor), ctypes.c_uint8]
+    cached.restype = ctypes.c_int32
+
+    attractor = BayesianAttractor()
+    init_bayes(ctypes.byref(attractor))
+    for _ in range(20):
+        update(ctypes.byref(attractor), to_fixed(3.0), to_fixed(0.0))
+
+    def direct(raw):
+        return calc_mahal(ctypes.byref(attractor), to_fixed(raw & 0x7F), to_fixed(raw >> 7))
+
+    # Ciclo laminar: todas las claves se resuelven una vez y luego por tabla
+    for _ in range(3):
+        for raw in range(256):
+            assert cached(ctypes.byref(attractor), raw) == direct(raw)
+    assert attractor.cache_misses == 256
+    assert attractor.cache_hits == 512
+
+    # Aprender invalida la caché y los valores nuevos reflejan el atractor nuevo
+    update(ctypes.byref(attractor), to_fixed(4.0), to_fixed(1.0))
+    assert all(w == 0 for w in attractor.cache_valid)
+    raw = 0x83  # fase 3, colapso 1
+    assert cached(ctypes.byref(attractor), raw) == direct(raw)
+    assert attractor.cache_misses == 257
+
+BAYES_ND_MAX_DIM = 16
+ALPHA_ND = 3276 / 65536
+
+class BayesianAttractorND(ctypes.Structure):
+    _fields_ = [("dim", ctypes.c_uint32),
+                ("mu", ctypes.c_int32 * BAYES_ND_MAX_DIM),
+                ("chol", (ctypes.c_int32 * BAYES_ND_MAX_DIM) * BAYES_ND_MAX_DIM),
+                ("inv_diag", ctypes.c_int32 * BAYES_ND_MAX_DIM)]
+
+def _nd_api(lib):
+    lib.init_bayesian_attractor_nd.argtypes = [ctypes.POINTER(BayesianAttractorND), ctypes.c_uint32]
+    lib.update_belief_nd.argtypes = [ctypes.POINTER(BayesianAttractorND), ctypes.POINTER(ctypes.c_int32)]
+    lib.calculate_mahalanobis_sq_nd.argtypes = [ctypes.POINTER(BayesianAttractorND), ctypes.POINTER(ctypes.c_int32)]
+    lib.calculate_mahalanobis_sq_nd.restype = ctypes.c_int32
+    return lib
+
+def _mahalanobis_ref(cov, d):
+    """D^2 = dᵀ Σ^-1 d por eliminación gaussiana (referencia en flotante)"""
+    n = len(d)
+    m = [row[:] + [d[i]] for i, row in enumerate(cov)]
+    for k in range(n):
+        for i in range(k + 1, n):
+            f = m[i][k] / m[k][k]
+            for j in range(k, n + 1):
+                m[i][j] -= f * m[k][j]
+    y = [0.0] * n
+    for i in reversed(range(n)):
+        y[i] = (m[i][n] - sum(m[i][j] * y[j] for j in range(i + 1, n))) / m[i][i]
+    return sum(a * b for a, b in zip(d, y))
+
+@pytest.mark.parametrize("dim", [2, 5])
+def test_nd_attractor_matches_float_reference(qcore_lib, to_fixed, dim):
+    """
+    El factor de Cholesky mantenido en rango 1 debe reproducir la EMA
+    Σ' = (1-α)(Σ + α d dᵀ) calculada en flotante.
+    """
+    import random
+    lib = _nd_api(qcore_lib)
+    att = BayesianAttractorND()
+    lib.init_bayesian_attractor_nd(ctypes.byref(att), dim)
+    assert att.dim == dim
+
+    rng = random.Random(dim)
+    mu = [0.0] * dim
+    cov = [[1.0 if i == j else 0.0 for j in range(dim)] for i in range(dim)]
+    center = [0.3 * (i + 1) for i in range(dim)]
+
+    for _ in range(120):
+        base = rng.gauss(0, 0.4)
+        x = [center[i] + 0.5 * base + rng.gauss(0, 0.2) for i in range(dim)]
+        xf = [to_fixed(v) for v in x]
+        lib.update_belief_nd(ctypes.byref(att), (ctypes.c_int32 * dim)(*xf))
+
+        d = [xf[i] / 65536.0 - mu[i] for i in range(dim)]
+        mu = [mu[i] + ALPHA_ND * d[i] for i in range(dim)]
+        cov = [[(1 - ALPHA_ND) * (cov[i][j] + ALPHA_ND * d[i] * d[j]) for j in range(dim)]
+               for i in range(dim)]
+
+    for i in range(dim):
+        assert abs(att.mu[i] / 65536.0 - mu[i]) < 0.01
+
+    for _ in range(20):
+        probe = [center[i] + rng.gauss(0, 0.6) for i in range(dim)]
+        got = lib.calculate_mahalanobis_sq_nd(ctypes.byref(att),
+                                              (ctypes.c_int32 * dim)(*[to_fixed(v) for v in probe])) / 65536.0
+        ref = _mahalanobis_ref(cov, [probe[i] - mu[i] for i in range(dim)])
+        assert abs(got - ref) <= 0.02 * ref + 0.05, f"dim={dim} got={got} ref={ref}"
+
+def test_nd_attractor_anomaly_and_degenerate_input(qcore_lib, to_fixed):
+    """Entrada constante: la covarianza colapsa sin singularidad y la anomalía domina."""
+    lib = _nd_api(qcore_lib)
+    att = BayesianAttractorND()
+    lib.init_bayesian_attractor_nd(ctypes.byref(att), 64)
+    assert att.dim == BAYES_ND_MAX_DIM
+
+    normal = (ctypes.c_int32 * BAYES_ND_MAX_DIM)(*([to_fixed(0.5)] * BAYES_ND_MAX_DIM))
+    for _ in range(500):
+        lib.update_belief_nd(ctypes.byref(att), normal)
+
+    for k in range(BAYES_ND_MAX_DIM):
+        assert att.chol[k][k] > 0
+
+    anomaly = (ctypes.c_int32 * BAYES_ND_MAX_DIM)(*([to_fixed(0.5)] * (BAYES_ND_MAX_DIM - 1) + [to_fixed(0.9)]))
+    dist_normal = lib.calculate_mahalanobis_sq_nd(ctypes.byref(att), normal)
+    dist_anomaly = lib.calculate_mahalanobis_sq_nd(ctypes.byref(att), anomaly)
+    assert dist_anomaly > dist_normal
+    assert dist_anomaly > to_fixed(1.0)
+
+def test_nd_attractor_saturates_full_range_diagonal(qcore_lib, to_fixed):
+    """
+    Con L[k][k] cerca de INT32_MAX, r = sqrt(L[k][k]² + v[k]²) no cabe en
+    int32: la diagonal y la columna rotada se saturan en lugar de envolver.
+    """
+    lib = _nd_api(qcore_lib)
+    att = BayesianAttractorND()
+    lib.init_bayesian_attractor_nd(ctypes.byref(att), 2)
+    att.chol[0][0] = 0x7FFFFFF0
+    att.chol[1][0] = 0x7FFF0000
+    att.chol[1][1] = to_fixed(1.0)
+
+    x = (ctypes.c_int32 * 2)(2**30, 2**30)
+    lib.update_belief_nd(ctypes.byref(att), x)
+
+    top = (0x7FFFFFFF * 63877) >> 16   # Saturado y luego el olvido sqrt(1 - α)
+    assert att.chol[0][0] == top
+    assert att.chol[1][0] == top
+    assert att.chol[1][1] >= 0x100
+    assert att.inv_diag[0] == (1 << 32) // top
+
+    mu = (ctypes.c_int32 * 2)(*att.mu[:2])
+    assert lib.calculate_mahalanobis_sq_nd(ctypes.byref(att), mu) == 0
+    assert lib.calculate_mahalanobis_sq_nd(ctypes.byref(att), (ctypes.c_int32 * 2)(0, 0)) > 0
+
+def test_mahalanobis_batch_matches_scalar(qcore_lib, to_fixed):
+    """
+    El lote SoA (y su variante fusionada con umbral) debe coincidir bit a bit
+    con calculate_mahalanobis_sq en todos los backends vectoriales.
+    """
+    import random
+    lib = qcore_lib
+    lib.init_bayesian_attractor.argtypes = [ctypes.POINTER(BayesianAttractor)]
+    lib.update_belief.argtypes = [ctypes.POINTER(BayesianAttractor), ctypes.c_int32, ctypes.c_int32]
+    lib.calculate_mahalanobis_sq.argtypes = [ctypes.POINTER(BayesianAttractor), ctypes.c_int32, ctypes.c_int32]
+    lib.calculate_mahalanobis_sq.restype = ctypes.c_int32
+    lib.calculate_mahalanobis_sq_batch.argtypes = [ctypes.POINTER(BayesianAttractor)] + \
+        [ctypes.POINTER(ctypes.c_int32)] * 3 + [ctypes.c_size_t]
+    lib.calculate_mahalanobis_sq_batch_count.argtypes = [ctypes.POINTER(BayesianAttractor)] + \
+        [ctypes.POINTER(ctypes.c_int32)] * 3 + [ctypes.c_size_t, ctypes.c_int32]
+    lib.calculate_mahalanobis_sq_batch_count.restype = ctypes.c_size_t
+    lib.fixed_vec_set_backend.argtypes = [ctypes.c_int]
+    lib.fixed_vec_set_backend.restype = ctypes.c_int
+
+    rng = random.Random(2718)
+    attractor = BayesianAttractor()
+    lib.init_bayesian_attractor(ctypes.byref(attractor))
+    for _ in range(40):
+        lib.update_belief(ctypes.byref(attractor), to_fixed(rng.uniform(0, 2)), to_fixed(rng.uniform(0, 1)))
+
+    n = 1001
+    phase = [to_fixed(rng.uniform(-8, 130)) for _ in range(n)]
+    entropy = [to_fixed(rng.uniform(-2, 3)) for _ in range(n)]
+    phase[:2] = [0x7FFFFFFF, -2**31]  # Desborde modular igual que la versión escalar
+    expected = [lib.calculate_mahalanobis_sq(ctypes.byref(attractor), p, e) for p, e in zip(phase, entropy)]
+
+    MAX_ENTROPY_TOLERANCE = 393216
+    expected_count = sum(1 for v in expected if v > MAX_ENTROPY_TOLERANCE)
+    assert 0 < expected_count < n
+
+    P = (ctypes.c_int32 * n)(*phase)
+    E = (ctypes.c_int32 * n)(*entropy)
+    for backend in (0, 1):  # C, AVX2
+        if not lib.fixed_vec_set_backend(backend):
+            continue
+        out = (ctypes.c_int32 * n)()
+        lib.calculate_mahalanobis_sq_batch(ctypes.byref(attractor), P, E, out, n)
+        assert list(out) == expected, f"backend={backend}"
+
+        out = (ctypes.c_int32 * n)()
+        count = lib.calculate_mahalanobis_sq_batch_count(ctypes.byref(attractor), P, E, out, n,
+                                                         MAX_ENTROPY_TOLERANCE)
+        assert list(out) == expected
+        assert count == expected_count
+    lib.fixed_vec_set_backend(0)
+
+ATTRACTOR_BANK_MAX = 32
+BANK_SOA_ROWS = 6
+
+class BankComponent(ctypes.Structure):
+    _fields_ = [("mu", ctypes.c_int32 * 2),
+                ("cov", (ctypes.c_int32 * 2) * 2)]
+
+class AttractorBank(ctypes.Structure):
+    _fields_ = [("capacity", ctypes.c_uint32),
+                ("active", ctypes.c_uint32),
+                ("soa", (ctypes.c_int32 * ATTRACTOR_BANK_MAX) * BANK_SOA_ROWS),
+                ("weight", ctypes.c_int32 * ATTRACTOR_BANK_MAX),
+                ("inv_sqrt_det", ctypes.c_int32 * ATTRACTOR_BANK_MAX),
+                ("d2", ctypes.c_int32 * ATTRACTOR_BANK_MAX),
+                ("resp", ctypes.c_int32 * ATTRACTOR_BANK_MAX),
+                ("comp", BankComponent * ATTRACTOR_BANK_MAX)]
+
+def _bank_api(lib):
+    P = ctypes.POINTER(AttractorBank)
+    lib.attractor_bank_init.argtypes = [P, ctypes.c_uint32]
+    lib.attractor_bank_update.argtypes = [P, ctypes.c_int32, ctypes.c_int32]
+    lib.attractor_bank_score.argtypes = [P, ctypes.c_int32, ctypes.c_int32]
+    lib.attractor_bank_score.restype = ctypes.c_int32
+    lib.attractor_bank_score_range.argtypes = [P, ctypes.c_int32, ctypes.c_int32, ctypes.c_uint32, ctypes.c_uint32]
+    lib.attractor_bank_finish_score.argtypes = [P]
+    lib.attractor_bank_finish_score.restype = ctypes.c_int32
+    lib.init_bayesian_attractor.argtypes = [ctypes.POINTER(BayesianAttractor)]
+    lib.update_belief.argtypes = [ctypes.POINTER(BayesianAttractor), ctypes.c_int32, ctypes.c_int32]
+    lib.calculate_mahalanobis_sq.argtypes = [ctypes.POINTER(BayesianAttractor), ctypes.c_int32, ctypes.c_int32]
+    lib.calculate_mahalanobis_sq.restype = ctypes.c_int32
+    lib.fixed_vec_set_backend.argtypes = [ctypes.c_int]
+    lib.fixed_vec_set_backend.restype = ctypes.c_int
+    return lib
+
+def test_attractor_bank_absorbs_regime_switches(qcore_lib, to_fixed):
+    """
+    El QPU alterna entre dos regímenes de calibración. Un atractor único ve
+    cada cambio como anomalía; el banco abre un componente por régimen.
+    """
+    import random
+    lib = _bank_api(qcore_lib)
+    rng = random.Random(99)
+    regimes = [(to_fixed(1.0), to_fixed(0.2)), (to_fixed(5.0), to_fixed(0.8))]
+
+    bank = AttractorBank()
+    lib.attractor_bank_init(ctypes.byref(bank), 4)
+    single = BayesianAttractor()
+    lib.init_bayesian_attractor(ctypes.byref(single))
+
+    def sample(regime):
+        cx, cy = regimes[regime]
+        return cx + to_fixed(rng.gauss(0, 0.1)), cy + to_fixed(rng.gauss(0, 0.05))
+
+    for block in range(6):
+        for _ in range(80):
+            p, e = sample(block % 2)
+            lib.attractor_bank_update(ctypes.byref(bank), p, e)
+            lib.update_belief(ctypes.byref(single), p, e)
+
+    assert bank.active == 2, "Un componente por régimen"
+    total = sum(bank.weight[k] for k in range(bank.active))
+    assert abs(total - to_fixed(1.0)) < to_fixed(0.02)
+
+    MAX_ENTROPY_TOLERANCE = 393216
+    bank_anomalies = single_anomalies = 0
+    for regime in (0, 1):
+        for _ in range(20):
+            p, e = sample(regime)
+            if lib.attractor_bank_score(ctypes.byref(bank), p, e) > MAX_ENTROPY_TOLERANCE:
+                bank_anomalies += 1
+            if lib.calculate_mahalanobis_sq(ctypes.byref(single), p, e) > MAX_ENTROPY_TOLERANCE:
+                single_anomalies += 1
+            # La responsabilidad recae en un único componente
+            assert max(bank.resp[k] for k in range(bank.active)) > to_fixed(0.95)
+
+    assert bank_anomalies == 0
+    assert single_anomalies > bank_anomalies
+
+    # Un punto fuera de ambos regímenes sigue siendo anomalía
+    assert lib.attractor_bank_score(ctypes.byref(bank), to_fixed(20.0), to_fixed(3.0)) > MAX_ENTROPY_TOLERANCE
+
+def test_attractor_bank_split_scoring_matches_components(qcore_lib, to_fixed):
+    """
+    La pasada SoA (por rangos, como la repartirían varios harts) debe dar la
+    misma D² que calculate_mahalanobis_sq sobre cada componente.
+    """
+    import random
+    lib = _bank_api(qcore_lib)
+    rng = random.Random(5)
+    bank = AttractorBank()
+    lib.attractor_bank_init(ctypes.byref(bank), ATTRACTOR_BANK_MAX)
+    for _ in range(3000):
+        c = rng.randrange(ATTRACTOR_BANK_MAX)
+        lib.attractor_bank_update(ctypes.byref(bank), to_fixed(c * 4.0 + rng.gauss(0, 0.2)),
+                                  to_fixed(rng.gauss(0, 0.2)))
+    assert bank.active > 8
+
+    # Cada componente como atractor clásico: mu y Σ propios, Σ^-1 del espejo SoA
+    singles = []
+    for k in range(bank.active):
+        comp, single = bank.comp[k], BayesianAttractor()
+        single.mu[:] = list(comp.mu)
+        for i in range(2):
+            single.cov[i][:] = list(comp.cov[i])
+        single.inv_cov[0][:] = [bank.soa[2][k], bank.soa[3][k]]
+        single.inv_cov[1][:] = [bank.soa[4][k], bank.soa[5][k]]
+        singles.append(single)
+
+        a, b, d = (v / 65536.0 for v in (comp.cov[0][0], comp.cov[0][1], comp.cov[1][1]))
+        det = a * d - b * b
+        assert abs(single.inv_cov[0][0] / 65536.0 - d / det) < 0.01 * d / det + 0.01
+
+    probe = (to_fixed(13.3), to_fixed(0.1))
+    expected = [lib.calculate_mahalanobis_sq(ctypes.byref(single), *probe) for single in singles]
+    for backend in (0, 1):
+        if not lib.fixed_vec_set_backend(backend):
+            continue
+        full_min = lib.attractor_bank_score(ctypes.byref(bank), *probe)
+        assert list(bank.d2)[:bank.active] == expected
+        full_resp = list(bank.resp)[:bank.active]
+
+        for k in range(ATTRACTOR_BANK_MAX):
+            bank.d2[k] = 0
+        mid = bank.active // 2
+        lib.attractor_bank_score_range(ctypes.byref(bank), *probe, mid, bank.active)
+        lib.attractor_bank_score_range(ctypes.byref(bank), *probe, 0, mid)
+        assert lib.attractor_bank_finish_score(ctypes.byref(bank)) == full_min == min(expected)
+        assert list(bank.resp)[:bank.active] == full_resp
+    lib.fixed_vec_set_backend(0)
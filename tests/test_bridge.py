@@ -143,3 +143,133 @@ def test_bridge_tick_cycle(qcore_lib):
     # Verify result - the QPU should have written back to the cycle
     # We expect the full byte from DATA_LATCH
     assert q_cycle.raw == 0xEF, f"Expected 0xEF, got {q_cycle.raw:#x}"
+
+class MajoranaByteAsync(ctypes.Union):
+    _fields_ = [("raw", ctypes.c_uint8)]
+
+BRIDGE_QUEUE_DEPTH = 4
+
+def _async_api(lib):
+    lib.bridge_submit.argtypes = [ctypes.c_uint8]
+    lib.bridge_submit.restype = ctypes.c_int
+    lib.bridge_poll.restype = ctypes.c_int
+    lib.bridge_complete.argtypes = [ctypes.POINTER(MajoranaByteAsync)]
+    lib.bridge_complete.restype = ctypes.c_int
+    lib.bridge_inflight.restype = ctypes.c_uint32
+    return lib
+
+def test_bridge_async_pipeline(qcore_lib):
+    """
+    bridge_submit/poll/complete: un colapso en el QPU, el resto en cola.
+    El test hace de QPU entre llamadas (determinista, sin hilos).
+    """
+    lib = _async_api(qcore_lib)
+    ctypes.c_int.in_dll(lib, "g_simulation_mode").value = 0
+    mock_buffer = ctypes.c_uint8.in_dll(lib, "mock_mmio_buffer")
+    mmio = ctypes.cast(ctypes.byref(mock_buffer), ctypes.POINTER(QuantumPort)).contents
+    mmio.STATUS_REG = STATUS_TEMP_OK
+    mmio.CONTROL_REG = 0
+
+    def collapse():
+        """El QPU colapsa lo que tiene en el latch (bit 7 = 1) y queda libre"""
+        assert mmio.CONTROL_REG == CMD_PREPARE_STATE
+        mmio.CONTROL_REG = 0
+        mmio.DATA_LATCH = (mmio.DATA_LATCH & 0x7F) | 0x80
+        mmio.STATUS_REG |= STATUS_DATA_READY
+
+    def accept_next():
+        """El QPU acepta el siguiente comando y baja DATA_READY"""
+        mmio.STATUS_REG &= ~STATUS_DATA_READY
+
+    assert lib.bridge_inflight() == 0
+    out = MajoranaByteAsync()
+    assert lib.bridge_complete(ctypes.byref(out)) == -1  # Cola vacía
+
+    # El primero va directo al QPU; el resto espera en software
+    for phase in (1, 2, 3, 4):
+        assert lib.bridge_submit(phase) == 0
+    assert lib.bridge_submit(5) == -1
+    assert lib.bridge_inflight() == BRIDGE_QUEUE_DEPTH
+    assert mmio.DATA_LATCH == 1
+    assert lib.bridge_poll() == 0
+
+    # Colapso del ciclo 1: el ciclo 2 se lanza en el mismo poll
+    collapse()
+    assert lib.bridge_poll() == 1
+    assert mmio.DATA_LATCH == 2 and mmio.CONTROL_REG == CMD_PREPARE_STATE
+    accept_next()
+
+    assert lib.bridge_complete(ctypes.byref(out)) == 0
+    assert out.raw == 0x81
+    assert lib.bridge_submit(5) == 0  # Hay hueco otra vez
+
+    results = []
+    for expected_phase in (2, 3, 4, 5):
+        collapse()
+        assert lib.bridge_poll() >= 1
+        accept_next()
+        assert lib.bridge_complete(ctypes.byref(out)) == 0
+        results.append(out.raw)
+    assert results == [0x82, 0x83, 0x84, 0x85]
+    assert lib.bridge_inflight() == 0
+
+def test_bridge_async_simulation_mode(qcore_lib):
+    """En simulación los colapsos son inmediatos y conservan la fase propuesta"""
+    lib = _async_api(qcore_lib)
+    sim = ctypes.c_int.in_dll(lib, "g_simulation_mode")
+    sim.value = 1
+    try:
+        for phase in (10, 20, 30):
+            assert lib.bridge_submit(phase) == 0
+        out = MajoranaByteAsync()
+        for phase in (10, 20, 30):
+            assert lib.bridge_complete(ctypes.byref(out)) == 0
+            assert out.raw & 0x7F == phase
+        assert lib.bridge_inflight() == 0
+    finally:
+        sim.value = 0
+
+def test_bridge_wait_hands_idle_time_to_hook(qcore_lib):
+    """
+    Espera spin-then-wfi: si el colapso tarda más que la ventana de spin,
+    la hart cede el tiempo al idle hook antes de dormir.
+    """
+    lib = qcore_lib
+    ctypes.c_int.in_dll(lib, "g_simulation_mode").value = 0
+    mock_buffer = ctypes.c_uint8.in_dll(lib, "mock_mmio_buffer")
+    mmio = ctypes.cast(ctypes.byref(mock_buffer), ctypes.POINTER(QuantumPort)).contents
+    mmio.STATUS_REG = STATUS_TEMP_OK
+    mmio.CONTROL_REG = 0
+
+    idle_calls = []
+    HOOK = ctypes.CFUNCTYPE(None)
+    hook = HOOK(lambda: idle_calls.append(1))
+    lib.bridge_set_idle_hook.argtypes = [HOOK]
+    lib.bridge_set_idle_hook(hook)
+
+    class MajoranaByte(ctypes.Union):
+        _fields_ = [("raw", ctypes.c_uint8)]
+    lib.bridge_tick_sync.argtypes = [ctypes.POINTER(MajoranaByte)]
+
+    def slow_qpu():
+        for _ in range(200):
+            if mmio.CONTROL_REG == CMD_PREPARE_STATE:
+                time.sleep(0.02)  # Mucho más que la ventana de spin
+                mmio.DATA_LATCH = 0x80 | (mmio.DATA_LATCH & 0x7F)
+                mmio.STATUS_REG |= STATUS_DATA_READY
+                return
+            time.sleep(0.002)
+
+    sim = threading.Thread(target=slow_qpu, daemon=True)
+    sim.start()
+    cycle = MajoranaByte()
+    cycle.raw = 0x21
+    try:
+        lib.bridge_tick_sync(ctypes.byref(cycle))
+    finally:
+        lib.bridge_set_idle_hook(HOOK())
+        mmio.STATUS_REG = STATUS_TEMP_OK
+    sim.join(timeout=1.0)
+
+    assert cycle.raw == 0xA1
+    assert len(idle_calls) == 1
@@ -0,0 +1,182 @@
+"""
+Test Suite for the Lindblad master-equation integrator (qcore_density.c)
+
+Verifica:
+1. Qubit del Lindblad Filter contra la solución analítica (Q16.16 y float)
+2. Traza exacta en Q16.16 y canales independientes dentro de un lote
+3. AVX2 frente al camino escalar en float
+4. Evolución unitaria de un qutrit (orden de los parámetros compactos)
+5. Rechazo de pasos inestables y dimensiones no soportadas
+"""
+
+import ctypes
+import math
+import random
+
+import pytest
+
+MAX_DIM = 4
+MAX_PARAMS = MAX_DIM * MAX_DIM
+ONE = 1 << 16
+PHI_SQUARED_FIXED = 0x00029E3A
+
+
+class CFixed(ctypes.Structure):
+    _fields_ = [("re", ctypes.c_int32), ("im", ctypes.c_int32)]
+
+
+class DensityProp(ctypes.Structure):
+    _fields_ = [
+        ("dim", ctypes.c_uint32),
+        ("n_params", ctypes.c_uint32),
+        ("p", (ctypes.c_int32 * MAX_PARAMS) * MAX_PARAMS),
+    ]
+
+
+@pytest.fixture
+def dens(qcore_lib):
+    lib = qcore_lib
+    lib.density_prop_build.argtypes = [
+        ctypes.POINTER(DensityProp), ctypes.c_uint32, ctypes.POINTER(CFixed),
+        ctypes.POINTER(CFixed), ctypes.POINTER(ctypes.c_int32), ctypes.c_uint32, ctypes.c_int32,
+    ]
+    lib.density_prop_build.restype = ctypes.c_int
+    lib.density_prop_qubit.argtypes = [ctypes.POINTER(DensityProp), ctypes.c_int32,
+                                       ctypes.c_int32, ctypes.c_int32]
+    lib.density_prop_qubit.restype = ctypes.c_int
+    lib.density_step_q16.argtypes = [ctypes.POINTER(DensityProp), ctypes.POINTER(ctypes.c_int32),
+                                     ctypes.c_size_t, ctypes.c_size_t, ctypes.c_uint32]
+    lib.density_step_q16.restype = None
+    lib.density_step_f32.argtypes = [ctypes.POINTER(DensityProp), ctypes.POINTER(ctypes.c_float),
+                                     ctypes.c_size_t, ctypes.c_size_t, ctypes.c_uint32]
+    lib.density_step_f32.restype = None
+    lib.density_f32_set_simd.argtypes = [ctypes.c_int]
+    lib.density_f32_set_simd.restype = ctypes.c_int
+    yield lib
+    lib.density_f32_set_simd(1)
+
+
+def qubit_exact(rho11, r01, i01, omega, g_pi, g_phi, t):
+    """ρ_11 decae a Γ_π; ρ_01 gira a -ω y decae a Γ_π/2 + Γ_φ"""
+    p1 = rho11 * math.exp(-g_pi * t)
+    decay = math.exp(-(g_pi / 2 + g_phi) * t)
+    c, s = math.cos(omega * t), math.sin(omega * t)
+    return (1.0 - p1, p1, decay * (r01 * c + i01 * s), decay * (i01 * c - r01 * s))
+
+
+def random_qubit_states(rng, n):
+    """Estados puros aleatorios como (ρ00, ρ11, Re ρ01, Im ρ01)"""
+    states = []
+    for _ in range(n):
+        theta, phi = rng.uniform(0, math.pi), rng.uniform(0, 2 * math.pi)
+        a, b = math.cos(theta / 2), math.sin(theta / 2)
+        states.append((a * a, b * b, a * b * math.cos(phi), -a * b * math.sin(phi)))
+    return states
+
+
+def test_qubit_matches_analytic_solution(dens):
+    omega, g_phi, dt, steps = 2.0, 0.25, 1.0 / 64, 256
+    prop = DensityProp()
+    assert dens.density_prop_qubit(ctypes.byref(prop), int(omega * ONE), int(g_phi * ONE),
+                                   int(dt * ONE)) == 0
+    assert prop.dim == 2 and prop.n_params == 4
+    g_pi = ((PHI_SQUARED_FIXED * int(g_phi * ONE)) >> 16) / ONE
+
+    states = random_qubit_states(random.Random(17), 11)
+    n = len(states)
+    xq = (ctypes.c_int32 * (4 * n))()
+    xf = (ctypes.c_float * (4 * n))()
+    for c, st in enumerate(states):
+        for k in range(4):
+            xq[k * n + c] = round(st[k] * ONE)
+            xf[k * n + c] = st[k]
+
+    dens.density_step_q16(ctypes.byref(prop), xq, n, n, steps)
+    dens.density_step_f32(ctypes.byref(prop), xf, n, n, steps)
+
+    for c, st in enumerate(states):
+        exact = qubit_exact(st[1], st[2], st[3], omega, g_pi, g_phi, steps * dt)
+        for k in range(4):
+            assert abs(xq[k * n + c] / ONE - exact[k]) < 2e-3, (c, k)
+            assert abs(xf[k * n + c] - exact[k]) < 1e-4, (c, k)
+
+
+def test_fixed_trace_exact_and_channels_independent(dens):
+    prop = DensityProp()
+    assert dens.density_prop_qubit(ctypes.byref(prop), 3 * ONE, ONE // 3, ONE // 100) == 0
+
+    states = random_qubit_states(random.Random(5), 21)
+    n, stride = len(states), 32
+    batch = (ctypes.c_int32 * (4 * stride))()
+    for c, st in enumerate(states):
+        q = [round(v * ONE) for v in st]
+        q[1] = ONE - q[0]
+        for k in range(4):
+            batch[k * stride + c] = q[k]
+
+    single = []
+    for c in range(n):
+        x = (ctypes.c_int32 * 4)(*[batch[k * stride + c] for k in range(4)])
+        dens.density_step_q16(ctypes.byref(prop), x, 1, 1, 500)
+        single.append(list(x))
+
+    dens.density_step_q16(ctypes.byref(prop), batch, stride, n, 500)
+    for c in range(n):
+        got = [batch[k * stride + c] for k in range(4)]
+        assert got == single[c]
+        assert got[0] + got[1] == ONE
+        # 500 pasos a Γ_π ≈ 0.87: casi todo en |0>
+        assert got[0] > int(0.95 * ONE)
+    # Lo que queda fuera de los n canales no se toca
+    assert all(batch[k * stride + c] == 0 for k in range(4) for c in range(n, stride))
+
+
+def test_f32_simd_matches_scalar(dens):
+    prop = DensityProp()
+    assert dens.density_prop_qubit(ctypes.byref(prop), ONE, ONE // 2, ONE // 50) == 0
+    states = random_qubit_states(random.Random(9), 37)
+    n = len(states)
+
+    def run(simd):
+        dens.density_f32_set_simd(simd)
+        x = (ctypes.c_float * (4 * n))()
+        for c, st in enumerate(states):
+            for k in range(4):
+                x[k * n + c] = st[k]
+        dens.density_step_f32(ctypes.byref(prop), x, n, n, 300)
+        return list(x)
+
+    scalar = run(0)
+    wide = run(1)
+    assert max(abs(a - b) for a, b in zip(scalar, wide)) < 1e-5
+
+
+def test_qutrit_unitary_phases(dens):
+    """Sin disipación ρ_ab(t) = ρ_ab(0)·e^{-i(E_a - E_b)t}"""
+    energies = [0.0, 1.0, 2.5]
+    h = (CFixed * 9)()
+    for a in range(3):
+        h[a * 3 + a] = CFixed(int(energies[a] * ONE), 0)
+    prop = DensityProp()
+    dt, steps = 1.0 / 128, 256
+    assert dens.density_prop_build(ctypes.byref(prop), 3, h, None, None, 0, int(dt * ONE)) == 0
+    assert prop.n_params == 9
+
+    # Estado puro uniforme: ρ_ab = 1/3 para todo a, b
+    x = (ctypes.c_float * 9)(*([1 / 3] * 3 + [1 / 3, 0.0] * 3))
+    dens.density_step_f32(ctypes.byref(prop), x, 1, 1, steps)
+
+    t = dt * steps
+    assert all(abs(x[k] - 1 / 3) < 1e-5 for k in range(3))
+    for idx, (a, b) in enumerate([(0, 1), (0, 2), (1, 2)]):
+        w = (energies[a] - energies[b]) * t
+        assert abs(x[3 + 2 * idx] - math.cos(w) / 3) < 1e-4
+        assert abs(x[4 + 2 * idx] + math.sin(w) / 3) < 1e-4
+
+
+def test_rejects_unstable_step_and_bad_dim(dens):
+    prop = DensityProp()
+    assert dens.density_prop_qubit(ctypes.byref(prop), 64 * ONE, ONE, ONE // 4) == -1
+    h = (CFixed * 25)()
+    assert dens.density_prop_build(ctypes.byref(prop), 5, h, None, None, 0, ONE // 100) == -1
+    assert dens.density_prop_build(ctypes.byref(prop), 0, h, None, None, 0, ONE // 100) == -1
@@ -0,0 +1,191 @@
+"""
+Test Suite for the QPU entropy pool (qcore_entropy.c)
+
+Verifica:
+1. Generador por contador y rellaves contra un modelo de referencia (simulación)
+2. entropy_next32 / entropy_fill / entropy_bit sirven el mismo flujo de 64 bits
+3. Con hardware: cosecha de DATA_LATCH al anillo y rellave solo desde memoria
+4. El bridge rellena el pool mientras espera un colapso
+5. Los colapsos simulados consumen bits del pool
+"""
+
+import ctypes
+import threading
+import time
+
+import pytest
+
+MASK64 = (1 << 64) - 1
+GOLDEN_64 = 0x9E3779B97F4A7C15
+RING_WORDS = 32
+IDLE_BATCH = 4
+RESEED_INTERVAL = 256
+RESEED_WORDS = 4
+
+CMD_PREPARE_STATE = 0x04
+STATUS_TEMP_OK = 0x02
+STATUS_DATA_READY = 0x04
+
+
+class QuantumPort(ctypes.Structure):
+    _fields_ = [("MAGIC_SIG", ctypes.c_uint32),
+                ("CONTROL_REG", ctypes.c_uint32),
+                ("STATUS_REG", ctypes.c_uint32),
+                ("DATA_LATCH", ctypes.c_uint32),
+                ("PHASE_LOCK", ctypes.c_uint32)]
+
+
+class MajoranaByte(ctypes.Union):
+    _fields_ = [("raw", ctypes.c_uint8)]
+
+
+def mix64(z):
+    z = ((z ^ (z >> 30)) * 0xBF58476D1CE4E5B9) & MASK64
+    z = ((z ^ (z >> 27)) * 0x94D049BB133111EB) & MASK64
+    return z ^ (z >> 31)
+
+
+class PoolModel:
+    """Modelo del pool en modo simulación (o con hardware y anillo vacío)"""
+
+    def __init__(self, seed, sim=True):
+        self.key, self.ctr, self.sim_state = mix64(seed), 0, seed
+        self.ring, self.reseeds, self.sim = [], 0, sim
+
+    def harvest_sim(self, n):
+        for _ in range(n):
+            self.sim_state = (self.sim_state + GOLDEN_64) & MASK64
+            self.ring.append(mix64(self.sim_state))
+
+    def next64(self):
+        if self.ctr and self.ctr % RESEED_INTERVAL == 0:
+            if not self.ring and self.sim:
+                self.harvest_sim(RESEED_WORDS)
+            if self.ring:
+                for w in self.ring:
+                    self.key = mix64(self.key ^ w)
+                self.ring = []
+                self.reseeds += 1
+        v = mix64((self.key + self.ctr * GOLDEN_64) & MASK64)
+        self.ctr += 1
+        return v
+
+
+@pytest.fixture
+def pool(qcore_lib):
+    lib = qcore_lib
+    lib.entropy_seed.argtypes = [ctypes.c_uint64]
+    lib.entropy_seed.restype = None
+    lib.entropy_harvest.argtypes = [ctypes.c_size_t]
+    lib.entropy_harvest.restype = ctypes.c_size_t
+    lib.entropy_available.restype = ctypes.c_size_t
+    lib.entropy_reseeds.restype = ctypes.c_uint64
+    lib.entropy_next64.restype = ctypes.c_uint64
+    lib.entropy_next32.restype = ctypes.c_uint32
+    lib.entropy_bit.restype = ctypes.c_uint32
+    lib.entropy_fill.argtypes = [ctypes.POINTER(ctypes.c_uint32), ctypes.c_size_t]
+    lib.entropy_fill.restype = None
+    lib.pseudo_random.restype = ctypes.c_uint32
+    sim = ctypes.c_int.in_dll(lib, "g_simulation_mode")
+    saved = sim.value
+    sim.value = 1
+    yield lib
+    sim.value = saved
+
+
+def test_counter_generator_and_reseeds_match_model(pool):
+    pool.entropy_seed(1234)
+    model = PoolModel(1234)
+    got = [pool.entropy_next64() for _ in range(3 * RESEED_INTERVAL + 5)]
+    assert got == [model.next64() for _ in range(len(got))]
+    assert pool.entropy_reseeds() == model.reseeds == 3
+
+    # Lo cosechado en simulación entra en la siguiente rellave
+    assert pool.entropy_harvest(6) == 6 and pool.entropy_available() == 6
+    model.harvest_sim(6)
+    got = [pool.entropy_next64() for _ in range(RESEED_INTERVAL)]
+    assert got == [model.next64() for _ in range(RESEED_INTERVAL)]
+    assert pool.entropy_available() == 0
+
+
+def test_word_bit_and_bulk_views_share_stream(pool):
+    pool.entropy_seed(77)
+    model = PoolModel(77)
+    w = [model.next64() for _ in range(8)]
+
+    assert pool.entropy_next32() == w[0] & 0xFFFFFFFF
+    out = (ctypes.c_uint32 * 6)()
+    pool.entropy_fill(out, 6)
+    assert list(out) == [w[0] >> 32, w[1] & 0xFFFFFFFF, w[1] >> 32,
+                         w[2] & 0xFFFFFFFF, w[2] >> 32, w[3] & 0xFFFFFFFF]
+    assert pool.pseudo_random() == w[3] >> 32
+    bits = [pool.entropy_bit() for _ in range(70)]
+    assert bits == [(w[4] >> k) & 1 for k in range(64)] + [(w[5] >> k) & 1 for k in range(6)]
+
+
+def test_hardware_harvest_fills_ring_and_reseeds_from_memory(pool):
+    lib = pool
+    mmio = ctypes.cast(ctypes.byref(ctypes.c_uint8.in_dll(lib, "mock_mmio_buffer")),
+                       ctypes.POINTER(QuantumPort)).contents
+    ctypes.c_int.in_dll(lib, "g_simulation_mode").value = 0
+
+    # Anillo vacío: la rellave no cosecha (nada de MMIO desde los consumidores)
+    lib.entropy_seed(5)
+    model = PoolModel(5, sim=False)
+    got = [lib.entropy_next64() for _ in range(RESEED_INTERVAL + 3)]
+    assert got == [model.next64() for _ in range(len(got))]
+    assert lib.entropy_reseeds() == 0
+
+    mmio.DATA_LATCH = 0xA5
+    assert lib.entropy_harvest(100) == RING_WORDS
+    assert lib.entropy_harvest(1) == 0
+    assert lib.entropy_available() == RING_WORDS
+    for _ in range(RESEED_INTERVAL):
+        lib.entropy_next64()
+    assert lib.entropy_reseeds() == 1 and lib.entropy_available() == 0
+
+
+def test_bridge_wait_refills_pool(pool):
+    lib = pool
+    ctypes.c_int.in_dll(lib, "g_simulation_mode").value = 0
+    mmio = ctypes.cast(ctypes.byref(ctypes.c_uint8.in_dll(lib, "mock_mmio_buffer")),
+                       ctypes.POINTER(QuantumPort)).contents
+    mmio.STATUS_REG = STATUS_TEMP_OK
+    mmio.CONTROL_REG = 0
+    lib.bridge_tick_sync.argtypes = [ctypes.POINTER(MajoranaByte)]
+    lib.entropy_seed(9)
+
+    def slow_qpu():
+        for _ in range(200):
+            if mmio.CONTROL_REG == CMD_PREPARE_STATE:
+                time.sleep(0.02)  # Más que la ventana de spin: la espera pasa a wfi
+                mmio.DATA_LATCH = 0x80 | (mmio.DATA_LATCH & 0x7F)
+                mmio.STATUS_REG |= STATUS_DATA_READY
+                return
+            time.sleep(0.002)
+
+    qpu = threading.Thread(target=slow_qpu, daemon=True)
+    qpu.start()
+    cycle = MajoranaByte(0x33)
+    try:
+        lib.bridge_tick_sync(ctypes.byref(cycle))
+    finally:
+        mmio.STATUS_REG = STATUS_TEMP_OK
+    qpu.join(timeout=1.0)
+
+    assert cycle.raw == 0xB3
+    assert lib.entropy_available() == IDLE_BATCH
+
+
+def test_simulated_collapses_draw_pool_bits(pool):
+    lib = pool
+    lib.bridge_tick_sync_batch.argtypes = [ctypes.POINTER(MajoranaByte), ctypes.c_size_t]
+    lib.bridge_set_sim_source.argtypes = [ctypes.c_void_p]
+    lib.bridge_set_sim_source(None)
+    lib.entropy_seed(31)
+    w = PoolModel(31).next64()
+
+    cycles = (MajoranaByte * 40)(*[MajoranaByte(k & 0x7F) for k in range(40)])
+    lib.bridge_tick_sync_batch(cycles, 40)
+    assert [c.raw >> 7 for c in cycles] == [(w >> k) & 1 for k in range(40)]
+    assert [c.raw & 0x7F for c in cycles] == [k & 0x7F for k in range(40)]
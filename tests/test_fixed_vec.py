@@ -0,0 +1,198 @@
+import pytest
+import ctypes
+import random
+
+# fixed_vec_backend_t
+BACKEND_C = 0
+BACKEND_AVX2 = 1
+BACKEND_RVV = 2
+
+N = 1003  # No múltiplo de 8: ejercita bloques SIMD y cola escalar
+
+def _arr(values):
+    return (ctypes.c_int32 * len(values))(*values)
+
+@pytest.fixture
+def vec(qcore_lib):
+    lib = qcore_lib
+    for name in ("fixed_vec_mul", "fixed_vec_add_sat"):
+        getattr(lib, name).argtypes = [ctypes.POINTER(ctypes.c_int32)] * 3 + [ctypes.c_size_t]
+    lib.fixed_vec_div_scalar.argtypes = [ctypes.POINTER(ctypes.c_int32), ctypes.POINTER(ctypes.c_int32),
+                                         ctypes.c_int32, ctypes.c_size_t]
+    lib.fixed_vec_cos.argtypes = [ctypes.POINTER(ctypes.c_int32)] * 2 + [ctypes.c_size_t]
+    lib.fixed_vec_golden.argtypes = [ctypes.POINTER(ctypes.c_int32), ctypes.c_int32, ctypes.c_size_t]
+    lib.fixed_vec_set_backend.argtypes = [ctypes.c_int]
+    lib.fixed_vec_set_backend.restype = ctypes.c_int
+    lib.fixed_vec_get_backend.restype = ctypes.c_int
+    for name in ("mult_q16", "div_q16"):
+        getattr(lib, name).argtypes = [ctypes.c_int32, ctypes.c_int32]
+        getattr(lib, name).restype = ctypes.c_int32
+    lib.fixed_cos.argtypes = [ctypes.c_int32]
+    lib.fixed_cos.restype = ctypes.c_int32
+    lib.calculate_golden_operator.argtypes = [ctypes.c_int32]
+    lib.calculate_golden_operator.restype = ctypes.c_int32
+
+    backends = [b for b in (BACKEND_C, BACKEND_AVX2, BACKEND_RVV) if lib.fixed_vec_set_backend(b)]
+    yield lib, backends
+    lib.fixed_vec_set_backend(BACKEND_C)
+
+def test_backend_dispatch(vec):
+    """El backend C siempre existe y el RVV nunca en la librería del host."""
+    lib, backends = vec
+    assert BACKEND_C in backends
+    assert BACKEND_RVV not in backends
+    for b in backends:
+        assert lib.fixed_vec_set_backend(b) == 1
+        assert lib.fixed_vec_get_backend() == b
+
+def test_vec_mul_add_sat_match_scalar(vec):
+    lib, backends = vec
+    rng = random.Random(1618)
+    a = [rng.randint(-2**31, 2**31 - 1) for _ in range(N)]
+    b = [rng.randint(-2**31, 2**31 - 1) for _ in range(N)]
+    a[:4] = [0x7FFFFFFF, -2**31, 0x7FFFFFFF, -2**31]
+    b[:4] = [1, -1, 0x7FFFFFFF, -2**31]
+
+    expected_mul = [lib.mult_q16(x, y) for x, y in zip(a, b)]
+    expected_add = [max(-2**31, min(2**31 - 1, x + y)) for x, y in zip(a, b)]
+
+    for backend in backends:
+        lib.fixed_vec_set_backend(backend)
+        out = _arr([0] * N)
+        lib.fixed_vec_mul(out, _arr(a), _arr(b), N)
+        assert list(out) == expected_mul, f"mul backend={backend}"
+        lib.fixed_vec_add_sat(out, _arr(a), _arr(b), N)
+        assert list(out) == expected_add, f"add_sat backend={backend}"
+
+def test_vec_div_scalar_within_one_lsb(vec):
+    lib, backends = vec
+    rng = random.Random(42)
+    a = [rng.randint(-2**24, 2**24) for _ in range(N)] + [-2**31, 2**31 - 1]
+    for d in (0x00010000, -0x00018000, 0x00060000, 393216, 3, 0x7FFFFFFF, -2**31):
+        expected = [lib.div_q16(x, d) for x in a]
+        for backend in backends:
+            lib.fixed_vec_set_backend(backend)
+            out = _arr([0] * len(a))
+            lib.fixed_vec_div_scalar(out, _arr(a), d, len(a))
+            for x, got, exp in zip(a, out, expected):
+                exact = abs(x) * 65536 // abs(d)
+                if exact < 2**30:
+                    assert abs(got - exp) <= 1, f"a={x} d={d} backend={backend}"
+
+    # División por cero: saturación como div_q16
+    out = _arr([0] * 4)
+    lib.fixed_vec_div_scalar(out, _arr([1, -1, 0, 5]), 0, 4)
+    assert list(out) == [0x7FFFFFFF] * 4
+
+def test_vec_cos_golden_bit_exact(vec):
+    lib, backends = vec
+    rng = random.Random(7)
+    angles = [rng.randint(-2**31, 2**31 - 1) for _ in range(N)]
+    expected_cos = [lib.fixed_cos(x) for x in angles]
+    n0 = 123456
+    expected_golden = [lib.calculate_golden_operator(n0 + i) for i in range(N)]
+
+    for backend in backends:
+        lib.fixed_vec_set_backend(backend)
+        out = _arr([0] * N)
+        lib.fixed_vec_cos(out, _arr(angles), N)
+        assert list(out) == expected_cos, f"cos backend={backend}"
+        lib.fixed_vec_golden(out, n0, N)
+        assert list(out) == expected_golden, f"golden backend={backend}"
+        # Inicio impar para cubrir el patrón de paridad alternativo
+        lib.fixed_vec_golden(out, -5, 17)
+        assert list(out)[:17] == [lib.calculate_golden_operator(-5 + i) for i in range(17)]
+
+def _s32(x):
+    x &= 0xFFFFFFFF
+    return x - 2**32 if x >= 2**31 else x
+
+def _tdiv(a, b):
+    """División entera de C (trunca hacia cero)"""
+    q = abs(a) // b
+    return q if a >= 0 else -q
+
+def _grover_reference(amp, data, target, iterations):
+    """apply_grover_oracle + apply_diffusion_operator (suma exacta, división truncada)."""
+    amp = list(amp)
+    for _ in range(iterations):
+        amp = [-a if d == target else a for a, d in zip(amp, data)]
+        active = [a for a in amp if a != 0]
+        if not active:
+            continue
+        mean = _tdiv(sum(active), len(active))
+        amp = [_s32(2 * mean - a) if a != 0 else 0 for a in amp]
+    return amp
+
+def test_vec_grover_fused_matches_reference(vec):
+    lib, backends = vec
+    p32 = ctypes.POINTER(ctypes.c_int32)
+    p64 = ctypes.POINTER(ctypes.c_int64)
+    lib.fixed_vec_grover_oracle_sum.argtypes = [p32, p32, ctypes.c_size_t, ctypes.c_int32, p64]
+    lib.fixed_vec_grover_oracle_sum.restype = ctypes.c_size_t
+    lib.fixed_vec_grover_step.argtypes = [p32, p32, ctypes.c_size_t, ctypes.c_int32, ctypes.c_int32, p64]
+    lib.fixed_vec_grover_step.restype = ctypes.c_size_t
+
+    rng = random.Random(314)
+    for n in (N, 64, 5):
+        data = [rng.randint(0, 15) for _ in range(n)]
+        amp = [rng.choice((0, 0x2000, 0x200, rng.randint(-2**31, 2**31 - 1))) for _ in range(n)]
+        expected = _grover_reference(amp, data, 7, 6)
+
+        for backend in backends:
+            lib.fixed_vec_set_backend(backend)
+            out = _arr(amp)
+            s = ctypes.c_int64(0)
+            count = lib.fixed_vec_grover_oracle_sum(out, _arr(data), n, 7, ctypes.byref(s))
+            assert list(out) == amp, "oracle_sum must not modify the amplitudes"
+            for _ in range(6):
+                if count == 0:
+                    break
+                mean = _tdiv(s.value, count)
+                count = lib.fixed_vec_grover_step(out, _arr(data), n, 7, _s32(2 * mean), ctypes.byref(s))
+            assert list(out) == expected, f"grover n={n} backend={backend}"
+            assert count == sum(1 for a in expected if a != 0)
+
+def _visibility_reference(s, m):
+    """lindblad_update() con la división original: div_q16(min(s, MAX), MAX)"""
+    MAX = 393216
+    s = min(s, MAX)
+    f = int((s << 16) / MAX)  # división C: trunca hacia cero
+    v = max(0x10000 - f, 0)
+    v += -0x1999 if m == 1 else 0xCCC
+    return min(max(v, 0), 0x10000)
+
+def test_vec_lindblad_visibility_matches_division(vec):
+    lib, backends = vec
+    p32 = ctypes.POINTER(ctypes.c_int32)
+    lib.fixed_vec_lindblad_visibility.argtypes = [p32, p32, ctypes.POINTER(ctypes.c_uint8), ctypes.c_size_t]
+    lib.fixed_vec_lindblad_visibility.restype = ctypes.c_size_t
+
+    rng = random.Random(2718)
+    surprise = [rng.choice((rng.randint(0, 393216), rng.randint(-50000, 500000),
+                            rng.randint(-2**31, 2**31 - 1), 393216, 0, -1)) for _ in range(N)]
+    majorana = [rng.choice((0, 1, 1, 2, 255)) for _ in range(N)]
+    expected = [_visibility_reference(s, m) for s, m in zip(surprise, majorana)]
+    below = sum(1 for v in expected if v < 0x4CCC)
+
+    for backend in backends:
+        lib.fixed_vec_set_backend(backend)
+        out = _arr([0] * N)
+        count = lib.fixed_vec_lindblad_visibility(out, _arr(surprise), (ctypes.c_uint8 * N)(*majorana), N)
+        assert list(out) == expected, f"backend={backend}"
+        assert count == below
+
+def test_vec_xor_key_all_offsets(vec):
+    lib, backends = vec
+    lib.fixed_vec_xor_key.argtypes = [ctypes.POINTER(ctypes.c_uint32), ctypes.c_size_t, ctypes.c_uint32]
+    rng = random.Random(11)
+    base = [rng.getrandbits(32) for _ in range(N + 3)]
+    key = 0x1B5A5A5A
+    for backend in backends:
+        lib.fixed_vec_set_backend(backend)
+        for off in range(3):  # Cabeceras desalineadas a 8 bytes y colas
+            buf = (ctypes.c_uint32 * len(base))(*base)
+            ptr = ctypes.cast(ctypes.byref(buf, 4 * off), ctypes.POINTER(ctypes.c_uint32))
+            lib.fixed_vec_xor_key(ptr, N, key)
+            expected = base[:off] + [w ^ key for w in base[off:off + N]] + base[off + N:]
+            assert list(buf) == expected, f"backend={backend} off={off}"
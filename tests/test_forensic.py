@@ -0,0 +1,188 @@
+"""
+Test Suite for the forensic ring log (qcore_forensic.c)
+
+Verifica:
+1. Registros con marca de tiempo, en orden, decodificados por tools/forensic_decode.py
+2. El anillo conserva los FORENSIC_LOG_RECORDS más recientes
+3. Escritores concurrentes: sin registros perdidos ni mezclados; un
+   registro en manos de otro escritor o con un sello más reciente no se pisa
+4. El heartbeat registra la entrada en hibernación
+5. Decodificación desde un volcado de memoria con el CLI
+"""
+
+import ctypes
+import os
+import subprocess
+import sys
+import threading
+
+import pytest
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), "..", "tools"))
+import forensic_decode  # noqa: E402
+
+RECORDS = 64
+SEQ_WRITING = 0xFFFFFFFF
+LOG_BYTES = 16 + 24 * RECORDS
+FORENSIC_MEM_ADDR = 0x1000
+HIBERNATION = 1
+
+
+class MajoranaByte(ctypes.Union):
+    _fields_ = [("raw", ctypes.c_uint8)]
+
+
+class ForensicRecord(ctypes.Structure):
+    _fields_ = [
+        ("tick", ctypes.c_uint64),
+        ("surprise", ctypes.c_int32),
+        ("cycle", ctypes.c_uint32),
+        ("seq", ctypes.c_uint32),
+        ("majorana", ctypes.c_uint8),
+        ("state", ctypes.c_uint8),
+        ("reserved", ctypes.c_uint16),
+    ]
+
+
+@pytest.fixture
+def flog(qcore_lib):
+    lib = qcore_lib
+    lib.forensic_log_region.restype = ctypes.c_void_p
+    lib.forensic_log_reset.restype = None
+    lib.forensic_log_append.argtypes = [ctypes.c_int32, MajoranaByte, ctypes.c_uint8, ctypes.c_uint32]
+    lib.forensic_log_append.restype = ctypes.c_uint64
+    lib.forensic_log_read.argtypes = [ctypes.c_uint64, ctypes.POINTER(ForensicRecord)]
+    lib.forensic_log_read.restype = ctypes.c_int
+    lib.forensic_log_reset()
+    yield lib
+    lib.forensic_log_reset()
+
+
+def snapshot(lib):
+    return ctypes.string_at(lib.forensic_log_region(), LOG_BYTES)
+
+
+def test_records_in_order_with_timestamps(flog):
+    for k in range(10):
+        assert flog.forensic_log_append(0x10000 * k - 5, MajoranaByte(0x80 | k), k % 3, 100 + k) == k
+
+    records = forensic_decode.decode(snapshot(flog))
+    assert [r["seq"] for r in records] == list(range(10))
+    assert [r["cycle"] for r in records] == [100 + k for k in range(10)]
+    assert [r["surprise"] for r in records] == [0x10000 * k - 5 for k in range(10)]
+    assert [r["majorana"] for r in records] == [0x80 | k for k in range(10)]
+    assert [r["state"] for r in records] == [k % 3 for k in range(10)]
+    ticks = [r["tick"] for r in records]
+    assert ticks == sorted(ticks) and ticks[0] > 0
+
+    rec = ForensicRecord()
+    assert flog.forensic_log_read(3, ctypes.byref(rec)) == 0
+    assert rec.cycle == 103 and rec.seq == 4 and rec.tick == ticks[3]
+    assert flog.forensic_log_read(10, ctypes.byref(rec)) == -1
+
+
+def test_ring_keeps_most_recent(flog):
+    total = 3 * RECORDS + 7
+    for k in range(total):
+        flog.forensic_log_append(k, MajoranaByte(k & 0xFF), 0, k)
+
+    records = forensic_decode.decode(snapshot(flog))
+    assert [r["seq"] for r in records] == list(range(total - RECORDS, total))
+    assert all(r["cycle"] == r["seq"] == r["surprise"] for r in records)
+
+    rec = ForensicRecord()
+    assert flog.forensic_log_read(total - RECORDS - 1, ctypes.byref(rec)) == -1
+    assert flog.forensic_log_read(total - 1, ctypes.byref(rec)) == 0
+
+
+def test_concurrent_writers_lose_nothing(flog):
+    per_thread, n_threads = 12, 4
+
+    def writer(t):
+        for k in range(per_thread):
+            flog.forensic_log_append(t << 16 | k, MajoranaByte(t), t, t * 1000 + k)
+
+    threads = [threading.Thread(target=writer, args=(t,)) for t in range(n_threads)]
+    for th in threads:
+        th.start()
+    for th in threads:
+        th.join()
+
+    records = forensic_decode.decode(snapshot(flog))
+    assert len(records) == per_thread * n_threads
+    seen = set()
+    for r in records:
+        t = r["majorana"]
+        assert r["state"] == t and r["surprise"] >> 16 == t
+        assert r["cycle"] == t * 1000 + (r["surprise"] & 0xFFFF)
+        seen.add(r["cycle"])
+    assert len(seen) == per_thread * n_threads
+
+
+def test_slot_owned_by_another_writer_is_not_torn(flog):
+    log_addr = flog.forensic_log_region()
+    head = ctypes.c_uint64.from_address(log_addr + 8)
+    rec = (ForensicRecord * RECORDS).from_address(log_addr + 16)
+
+    for k in range(RECORDS + 6):
+        flog.forensic_log_append(k, MajoranaByte(1), 0, k)
+
+    # Escritor de hace una vuelta que reanuda: el registro 69 ya ocupa su
+    # ranura con un sello más reciente y no se toca
+    before = bytes(rec[5])
+    head.value = 5
+    assert flog.forensic_log_append(-1, MajoranaByte(2), 2, 999) == 5
+    assert bytes(rec[5]) == before
+    out = ForensicRecord()
+    assert flog.forensic_log_read(RECORDS + 5, ctypes.byref(out)) == 0 and out.cycle == RECORDS + 5
+    assert flog.forensic_log_read(5, ctypes.byref(out)) == -1
+
+    # Ranura en manos de un escritor parado a medias: el nuevo registro se
+    # descarta y los campos del dueño quedan como estaban
+    head.value = RECORDS + 6
+    rec[6].seq = SEQ_WRITING
+    before = bytes(rec[6])
+    n = flog.forensic_log_append(-2, MajoranaByte(3), 1, 1234)
+    assert n == RECORDS + 6 and bytes(rec[6]) == before
+    assert flog.forensic_log_read(n, ctypes.byref(out)) == -1
+
+    # La siguiente ranura libre sigue funcionando
+    n = flog.forensic_log_append(7, MajoranaByte(4), 1, 4321)
+    assert flog.forensic_log_read(n, ctypes.byref(out)) == 0 and out.cycle == 4321
+    assert [r["seq"] for r in forensic_decode.decode(snapshot(flog))][-1] == n
+
+
+def test_heartbeat_logs_hibernation_entry(flog):
+    lib = flog
+    lib.security_heartbeat.argtypes = [ctypes.POINTER(ctypes.c_uint32), ctypes.c_size_t,
+                                       ctypes.c_int32, MajoranaByte]
+    buf = (ctypes.c_uint32 * 64)(*range(64))
+    anomaly = 0x00080000
+
+    lib.security_heartbeat(buf, 64, 0, MajoranaByte(0))
+    lib.security_heartbeat(buf, 64, anomaly, MajoranaByte(0x95))
+    lib.security_heartbeat(buf, 64, anomaly, MajoranaByte(0x95))   # Sostenida: sin registro
+    lib.security_heartbeat(buf, 64, 0, MajoranaByte(0))
+
+    records = forensic_decode.decode(snapshot(lib))
+    assert len(records) == 1
+    r = records[0]
+    assert r["surprise"] == anomaly and r["majorana"] == 0x95 and r["state"] == HIBERNATION
+    assert list(buf) == list(range(64))
+
+
+def test_cli_decodes_memory_dump(flog, tmp_path):
+    flog.forensic_log_append(0x00120000, MajoranaByte(0xC1), 2, 77)
+    base = 0x0
+    dump = bytearray(FORENSIC_MEM_ADDR - base) + snapshot(flog) + bytearray(256)
+    path = tmp_path / "ram.bin"
+    path.write_bytes(bytes(dump))
+
+    tool = os.path.join(os.path.dirname(__file__), "..", "tools", "forensic_decode.py")
+    out = subprocess.run([sys.executable, tool, str(path), "--base", hex(base)],
+                         capture_output=True, text=True, check=True).stdout
+    assert "cycle=77" in out and "majorana=0xc1" in out and "SINGULARITY" in out
+    assert "surprise=   18.00000" in out
+
+    bad = subprocess.run([sys.executable, tool, str(path), "--offset", "0"], capture_output=True, text=True)
+    assert bad.returncode == 1 and "no forensic ring" in bad.stderr
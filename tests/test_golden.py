@@ -48,3 +48,100 @@ def test_lagrangian_computation_rule_3_1(qcore_lib, to_fixed):
     # We convert back to int to check the raw fixed point values roughly
     assert state.L_symp > 0
     assert state.L_metr < 0
+
+def test_fixed_cos_sin_accuracy(qcore_lib, to_fixed, from_fixed):
+    """
+    fixed_cos/fixed_sin (tabla de cuarto de onda) deben quedar dentro de
+    la cota documentada de 2 LSB en todo el rango, incluidos ángulos enormes.
+    """
+    import math
+    fcos = qcore_lib.fixed_cos
+    fsin = qcore_lib.fixed_sin
+    for f in (fcos, fsin):
+        f.argtypes = [ctypes.c_int32]
+        f.restype = ctypes.c_int32
+
+    bound = 2.0 / 65536.0
+    worst = 0.0
+    for raw in list(range(-0x00080000, 0x00080000, 997)) + [0x7FFF0000, -0x7FFF0000]:
+        x = raw / 65536.0
+        worst = max(worst,
+                    abs(from_fixed(fcos(raw) & 0xFFFFFFFF) - math.cos(x)),
+                    abs(from_fixed(fsin(raw) & 0xFFFFFFFF) - math.sin(x)))
+    print(f"max |err| = {worst:.2e}")
+    assert worst <= bound
+
+    # La serie de Taylor previa fallaba ~0.12 en π; ahora cos(π) ≈ -1
+    assert abs(from_fixed(fcos(to_fixed(math.pi)) & 0xFFFFFFFF) + 1.0) < bound
+
+def test_golden_operator_large_n(qcore_lib, from_fixed):
+    """
+    El Operador Áureo no debe desbordar ni degradarse con n grande
+    (ticks de un kernel con mucho tiempo encendido).
+    """
+    import math
+    calc_golden = qcore_lib.calculate_golden_operator
+    calc_golden.argtypes = [ctypes.c_int32]
+    calc_golden.restype = ctypes.c_int32
+
+    phi = (1 + math.sqrt(5)) / 2
+    for n in (7, 6447, 100000, 12345678, 2**31 - 1):
+        expected = math.cos(math.pi * n) * math.cos(math.pi * phi * n)
+        got = from_fixed(calc_golden(n) & 0xFFFFFFFF)
+        assert abs(got - expected) < 1e-4, f"n={n}: {got} vs {expected}"
+
+class GoldenSeq(ctypes.Structure):
+    _fields_ = [("n", ctypes.c_int32),
+                ("cos_q30", ctypes.c_int32),
+                ("sin_q30", ctypes.c_int32),
+                ("since_renorm", ctypes.c_uint32)]
+
+def test_golden_seq_tracks_operator(qcore_lib):
+    """
+    El iterador incremental (rotación + renormalización periódica) debe
+    reproducir calculate_golden_operator(n) paso a paso sin derivar.
+    """
+    calc_golden = qcore_lib.calculate_golden_operator
+    calc_golden.argtypes = [ctypes.c_int32]
+    calc_golden.restype = ctypes.c_int32
+
+    seq_init = qcore_lib.golden_seq_init
+    seq_init.argtypes = [ctypes.POINTER(GoldenSeq), ctypes.c_int32]
+    seq_value = qcore_lib.golden_seq_value
+    seq_value.argtypes = [ctypes.POINTER(GoldenSeq)]
+    seq_value.restype = ctypes.c_int32
+    seq_next = qcore_lib.golden_seq_next
+    seq_next.argtypes = [ctypes.POINTER(GoldenSeq)]
+    seq_next.restype = ctypes.c_int32
+    seq_seek = qcore_lib.golden_seq_seek
+    seq_seek.argtypes = [ctypes.POINTER(GoldenSeq), ctypes.c_int32]
+    seq_seek.restype = ctypes.c_int32
+
+    seq = GoldenSeq()
+    for start in (0, 1000000):
+        seq_init(ctypes.byref(seq), start)
+        assert abs(seq_value(ctypes.byref(seq)) - calc_golden(start)) <= 2
+        worst = 0
+        for n in range(start + 1, start + 5000):
+            worst = max(worst, abs(seq_next(ctypes.byref(seq)) - calc_golden(n)))
+        assert worst <= 2, f"deriva de {worst} LSB desde n={start}"
+
+    # seek: salto arbitrario re-siembra, tick consecutivo avanza
+    assert abs(seq_seek(ctypes.byref(seq), 42) - calc_golden(42)) <= 2
+    assert abs(seq_seek(ctypes.byref(seq), 43) - calc_golden(43)) <= 2
+    assert seq.n == 43
+
+
+def test_fixed_exp_neg_accuracy(qcore_lib, to_fixed):
+    """e^-x en Q16.16 (responsabilidades del banco de atractores)"""
+    import math
+    exp_neg = qcore_lib.fixed_exp_neg
+    exp_neg.argtypes = [ctypes.c_int32]
+    exp_neg.restype = ctypes.c_int32
+
+    assert exp_neg(0) == 0x10000
+    assert exp_neg(-to_fixed(3.0)) == 0x10000
+    assert exp_neg(to_fixed(40.0)) == 0
+    for i in range(0, 400):
+        x = i * 0.05
+        assert abs(exp_neg(to_fixed(x)) - math.exp(-x) * 65536) <= 16, f"x={x}"
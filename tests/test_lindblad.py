@@ -10,9 +10,20 @@ Verifica:
 """
 
 import ctypes
+import random
 import pytest
 
 
+class GoldenSeq(ctypes.Structure):
+    """Iterador incremental del Operador Áureo (golden_seq_t)"""
+    _fields_ = [
+        ("n", ctypes.c_int32),
+        ("cos_q30", ctypes.c_int32),
+        ("sin_q30", ctypes.c_int32),
+        ("since_renorm", ctypes.c_uint32),
+    ]
+
+
 class LindblادState(ctypes.Structure):
     """Estructura de estado del Lindblad Filter"""
     _fields_ = [
@@ -21,6 +32,7 @@ class LindblادState(ctypes.Structure):
         ("cycle_count", ctypes.c_uint32),
         ("gamma_pi", ctypes.c_int32),          # fixed_t
         ("gamma_phi", ctypes.c_int32),         # fixed_t
+        ("golden", GoldenSeq),                 # golden_seq_t
     ]
 
 
@@ -94,6 +106,12 @@ def test_lindblad_bf_axis_oscillation(qcore_lib):
     
     print(f"✓ bf_axis oscila correctamente en {len(unique_values)} valores distintos")
 
+    # bf_axis debe seguir el Operador Áureo exacto O_n con n = cycle_count
+    calc_golden = qcore_lib.calculate_golden_operator
+    calc_golden.argtypes = [ctypes.c_int32]
+    calc_golden.restype = ctypes.c_int32
+    assert abs(state.bf_axis - calc_golden(state.cycle_count)) <= 2
+
 
 def test_lindblad_visibility_modulation(qcore_lib):
     """
@@ -247,3 +265,140 @@ def test_lindblad_metriplectic_compliance(qcore_lib):
     assert vis_changes > 0, "Componente disipativa (visibility) debe modular"
     
     print(f"✓ Cumplimiento Metriplético: bf_changes={bf_changes}, vis_changes={vis_changes}")
+
+
+def test_lindblad_update_batch_matches_sequential(qcore_lib):
+    """
+    Test: lindblad_update_batch() sobre una ráfaga del puente equivale a
+    n llamadas a lindblad_update() y cuenta los ciclos en modo launder
+    """
+    lib = qcore_lib
+    lib.lindblad_init.argtypes = [ctypes.POINTER(LindblادState)]
+    lib.lindblad_update.argtypes = [ctypes.POINTER(LindblادState), ctypes.c_int32, ctypes.c_uint8]
+    lib.lindblad_should_launder.argtypes = [ctypes.POINTER(LindblادState)]
+    lib.lindblad_should_launder.restype = ctypes.c_int
+    lib.lindblad_update_batch.argtypes = [ctypes.POINTER(LindblادState), ctypes.POINTER(ctypes.c_int32),
+                                          ctypes.POINTER(ctypes.c_uint8), ctypes.c_size_t]
+    lib.lindblad_update_batch.restype = ctypes.c_uint32
+
+    N = 64
+    surprise = (ctypes.c_int32 * N)(*[((i * 37) % 23) * 0x00008000 for i in range(N)])
+    majorana = (ctypes.c_uint8 * N)(*[(i * 5) % 3 == 0 for i in range(N)])
+
+    seq = LindblادState()
+    lib.lindblad_init(ctypes.byref(seq))
+    laundered = 0
+    for i in range(N):
+        lib.lindblad_update(ctypes.byref(seq), surprise[i], majorana[i])
+        laundered += lib.lindblad_should_launder(ctypes.byref(seq))
+
+    bulk = LindblادState()
+    lib.lindblad_init(ctypes.byref(bulk))
+    assert lib.lindblad_update_batch(ctypes.byref(bulk), surprise, majorana, N) == laundered
+    assert bytes(bulk) == bytes(seq)
+
+
+class LindbladBank(ctypes.Structure):
+    """Banco de filtros en SoA (lindblad_bank_t)"""
+    _fields_ = [
+        ("n_channels", ctypes.c_uint32),
+        ("cycle_count", ctypes.c_uint64),
+        ("phase", ctypes.c_uint64),
+        ("bf_axis", ctypes.c_int32),
+        ("gamma_pi", ctypes.c_int32),
+        ("gamma_phi", ctypes.c_int32),
+        ("visibility", ctypes.POINTER(ctypes.c_int32)),
+    ]
+
+
+def test_lindblad_bank_matches_per_channel_filters(qcore_lib):
+    """
+    Test: un banco de C canales equivale a C filtros escalares independientes
+    (visibilidad bit a bit) y su bf_axis es O_n exacto del acumulador de fase
+    """
+    lib = qcore_lib
+    lib.lindblad_init.argtypes = [ctypes.POINTER(LindblادState)]
+    lib.lindblad_update.argtypes = [ctypes.POINTER(LindblادState), ctypes.c_int32, ctypes.c_uint8]
+    lib.lindblad_should_launder.argtypes = [ctypes.POINTER(LindblادState)]
+    lib.lindblad_should_launder.restype = ctypes.c_int
+    lib.lindblad_bank_init.argtypes = [ctypes.POINTER(LindbladBank), ctypes.POINTER(ctypes.c_int32),
+                                       ctypes.c_uint32]
+    lib.lindblad_bank_update.argtypes = [ctypes.POINTER(LindbladBank), ctypes.POINTER(ctypes.c_int32),
+                                         ctypes.POINTER(ctypes.c_uint8)]
+    lib.lindblad_bank_update.restype = ctypes.c_uint32
+    lib.lindblad_bank_should_launder.argtypes = [ctypes.POINTER(LindbladBank), ctypes.c_uint32]
+    lib.lindblad_bank_should_launder.restype = ctypes.c_int
+    lib.calculate_golden_operator.argtypes = [ctypes.c_int32]
+    lib.calculate_golden_operator.restype = ctypes.c_int32
+
+    C, CYCLES = 61, 40
+    rng = random.Random(60)
+    vis = (ctypes.c_int32 * C)()
+    bank = LindbladBank()
+    lib.lindblad_bank_init(ctypes.byref(bank), vis, C)
+    assert all(v == 0x00010000 for v in vis)
+
+    filters = [LindblادState() for _ in range(C)]
+    for f in filters:
+        lib.lindblad_init(ctypes.byref(f))
+
+    for n in range(1, CYCLES + 1):
+        surprise = (ctypes.c_int32 * C)(*[rng.randint(-0x10000, 0x80000) for _ in range(C)])
+        majorana = (ctypes.c_uint8 * C)(*[rng.randint(0, 1) for _ in range(C)])
+        laundered = lib.lindblad_bank_update(ctypes.byref(bank), surprise, majorana)
+
+        expected = 0
+        for c, f in enumerate(filters):
+            lib.lindblad_update(ctypes.byref(f), surprise[c], majorana[c])
+            assert vis[c] == f.visibility_score
+            assert lib.lindblad_bank_should_launder(ctypes.byref(bank), c) == \
+                lib.lindblad_should_launder(ctypes.byref(f))
+            expected += lib.lindblad_should_launder(ctypes.byref(f))
+        assert laundered == expected
+        assert bank.cycle_count == n
+        assert bank.bf_axis == lib.calculate_golden_operator(n)
+        assert abs(bank.bf_axis - filters[0].bf_axis) <= 2
+
+
+def test_lindblad_bank_cycle_count_past_32_bits(qcore_lib):
+    """
+    Test: n y el acumulador de fase avanzan juntos más allá de 2^32 ciclos;
+    hasta INT32_MAX bf_axis es calculate_golden_operator(n) bit a bit
+    """
+    lib = qcore_lib
+    lib.lindblad_bank_init.argtypes = [ctypes.POINTER(LindbladBank), ctypes.POINTER(ctypes.c_int32),
+                                       ctypes.c_uint32]
+    lib.lindblad_bank_update.argtypes = [ctypes.POINTER(LindbladBank), ctypes.POINTER(ctypes.c_int32),
+                                         ctypes.POINTER(ctypes.c_uint8)]
+    lib.calculate_golden_operator.argtypes = [ctypes.c_int32]
+    lib.calculate_golden_operator.restype = ctypes.c_int32
+    GOLDEN_HALF_TURN_BAM64 = 0xCF1BBCDCBFA53E0B
+    surprise = (ctypes.c_int32 * 1)(0)
+    majorana = (ctypes.c_uint8 * 1)(0)
+
+    def bank_at(n):
+        vis = (ctypes.c_int32 * 1)()
+        bank = LindbladBank()
+        lib.lindblad_bank_init(ctypes.byref(bank), vis, 1)
+        bank.cycle_count = n
+        bank.phase = (n * GOLDEN_HALF_TURN_BAM64) % (1 << 64)
+        bank._vis = vis
+        return bank
+
+    bank = bank_at(2**31 - 3)
+    for n in range(2**31 - 2, 2**31):
+        lib.lindblad_bank_update(ctypes.byref(bank), surprise, majorana)
+        assert bank.cycle_count == n
+        assert bank.bf_axis == lib.calculate_golden_operator(n)
+
+    # Cruce de 2^32: el contador no vuelve a 0 y la paridad sigue a n
+    bank = bank_at(2**32 - 2)
+    for n in range(2**32 - 1, 2**32 + 3):
+        lib.lindblad_bank_update(ctypes.byref(bank), surprise, majorana)
+        assert bank.cycle_count == n
+        assert bank.phase == (n * GOLDEN_HALF_TURN_BAM64) % (1 << 64)
+        # Mismo ángulo y misma paridad: un banco en n = 2 o 3 con esa fase
+        ref = bank_at(1 + (n & 1))
+        ref.phase = (bank.phase - GOLDEN_HALF_TURN_BAM64) % (1 << 64)
+        lib.lindblad_bank_update(ctypes.byref(ref), surprise, majorana)
+        assert ref.bf_axis == bank.bf_axis
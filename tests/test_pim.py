@@ -0,0 +1,158 @@
+"""
+Test Suite for the host PIM update (qcore_pim_host.c)
+
+Verifica:
+1. La versión C reproduce la rutina escalar en ensamblador, redondeo a float incluido
+2. AVX2 idéntica bit a bit a C, sin tocar probability ni metadata
+3. El reparto multihilo sobre pim_tensor_x/y/z equivale a tres llamadas en serie
+4. Un modelo en Python del producto por 1/φ (la semántica de la ruta RVV, que
+   aquí no se ejecuta) queda a 1 ULP como máximo de la división del host
+"""
+
+import ctypes
+import random
+import struct
+
+import pytest
+
+TENSOR_BASE_N = 4448
+PARALLEL_MIN_CELLS = 32768
+GOLDEN_PRIOR = 0.618033
+
+
+class LaminarCell(ctypes.Structure):
+    _fields_ = [
+        ("weight", ctypes.c_float),
+        ("probability", ctypes.c_float),
+        ("metadata", ctypes.c_uint64),
+    ]
+
+
+def f32(x):
+    return struct.unpack("f", struct.pack("f", x))[0]
+
+
+def f32_bits(x):
+    return struct.unpack("<i", struct.pack("f", x))[0]
+
+
+THRESHOLD = f32(1.618033)
+THRESHOLD_RECIP = struct.unpack("<f", struct.pack("<I", 0x3F1E3780))[0]
+
+
+def asm_scalar(w, p, prior):
+    """smopsys_bayesian_update_scalar: fmul.s, fmul.s, fdiv.s (binary64 -> binary32 es exacto aquí)"""
+    return f32(f32(f32(prior * w) * p) / THRESHOLD)
+
+
+def reciprocal_model(w, p, prior):
+    """Modelo de smopsys_bayesian_update_rvv: el último paso es un producto por 1/φ"""
+    return f32(f32(f32(prior * w) * p) * THRESHOLD_RECIP)
+
+
+@pytest.fixture
+def pim(qcore_lib):
+    lib = qcore_lib
+    for name in ("smopsys_bayesian_update", "smopsys_bayesian_update_c", "smopsys_bayesian_update_avx2"):
+        fn = getattr(lib, name)
+        fn.argtypes = [ctypes.POINTER(LaminarCell), ctypes.c_uint32, ctypes.c_float]
+        fn.restype = None
+    lib.pim_set_simd.argtypes = [ctypes.c_int]
+    lib.pim_set_simd.restype = ctypes.c_int
+    lib.pim_update_tensors.argtypes = [ctypes.POINTER(ctypes.POINTER(LaminarCell)), ctypes.c_uint32,
+                                       ctypes.c_uint32, ctypes.c_float, ctypes.c_uint32]
+    lib.pim_update_tensors.restype = ctypes.c_uint32
+    lib.pim_init()
+    yield lib
+    lib.pim_set_simd(1)
+
+
+def random_cells(rng, n):
+    cells = (LaminarCell * n)()
+    for c in cells:
+        c.weight = rng.uniform(-2.0, 2.0)
+        c.probability = rng.uniform(0.0, 1.0)
+        c.metadata = rng.getrandbits(64)
+    return cells
+
+
+def snapshot(cells):
+    return [(c.weight, c.probability, c.metadata) for c in cells]
+
+
+def test_c_matches_scalar_assembly(pim):
+    rng = random.Random(3)
+    cells = random_cells(rng, 301)
+    before = snapshot(cells)
+    pim.smopsys_bayesian_update_c(cells, 301, GOLDEN_PRIOR)
+
+    prior = f32(GOLDEN_PRIOR)
+    for c, (w, p, m) in zip(cells, before):
+        assert f32_bits(c.weight) == f32_bits(asm_scalar(w, p, prior))
+        assert c.probability == p and c.metadata == m
+
+    pim.smopsys_bayesian_update_c(cells, 0, GOLDEN_PRIOR)
+    assert [c.weight for c in cells] == [f32(asm_scalar(w, p, prior)) for w, p, _ in before]
+
+
+def test_avx2_bit_identical_to_c(pim):
+    if not pim.pim_set_simd(1):
+        pytest.skip("AVX2 not available")
+    rng = random.Random(11)
+    for n in list(range(0, 20)) + [37, 64, 1001]:
+        ref = random_cells(rng, n + 3)
+        wide = (LaminarCell * (n + 3))()
+        ctypes.memmove(wide, ref, ctypes.sizeof(ref))
+        # Desplazado una celda: grupos de 8 sin alinear
+        pim.smopsys_bayesian_update_c(ctypes.cast(ctypes.byref(ref, 16), ctypes.POINTER(LaminarCell)), n, 0.75)
+        pim.smopsys_bayesian_update_avx2(ctypes.cast(ctypes.byref(wide, 16), ctypes.POINTER(LaminarCell)), n, 0.75)
+        assert bytes(wide) == bytes(ref), n
+
+
+def _serial_reference(pim, tensors, count):
+    expected = []
+    for t in tensors:
+        copy = (LaminarCell * count)()
+        ctypes.memmove(copy, t, ctypes.sizeof(copy))
+        pim.smopsys_bayesian_update_c(copy, count, GOLDEN_PRIOR)
+        expected.append(bytes(copy))
+    return expected
+
+
+def _tensor_ptrs(tensors):
+    return (ctypes.POINTER(LaminarCell) * len(tensors))(*[ctypes.cast(t, ctypes.POINTER(LaminarCell)) for t in tensors])
+
+
+def test_threaded_tensors_match_serial(pim):
+    rng = random.Random(23)
+
+    # Carga real: pim_tensor_x/y/z quedan por debajo del umbral, un solo hilo
+    tensors = [(LaminarCell * TENSOR_BASE_N).in_dll(pim, name) for name in ("pim_tensor_x", "pim_tensor_y", "pim_tensor_z")]
+    for t in tensors:
+        ctypes.memmove(t, random_cells(rng, TENSOR_BASE_N), ctypes.sizeof(t))
+    expected = _serial_reference(pim, tensors, TENSOR_BASE_N)
+    assert pim.pim_update_tensors(_tensor_ptrs(tensors), 3, TENSOR_BASE_N, GOLDEN_PRIOR, 8) == 1
+    assert [bytes(t) for t in tensors] == expected
+
+    # Tensores grandes: rangos que cruzan de un tensor al siguiente
+    count = 40_003
+    tensors = [random_cells(rng, count) for _ in range(3)]
+    for n_threads in (1, 3, 0):
+        expected = _serial_reference(pim, tensors, count)
+        used = pim.pim_update_tensors(_tensor_ptrs(tensors), 3, count, GOLDEN_PRIOR, n_threads)
+        assert 1 <= used <= 3 * count // PARALLEL_MIN_CELLS
+        if n_threads:
+            assert used == min(n_threads, 3 * count // PARALLEL_MIN_CELLS)
+        assert [bytes(t) for t in tensors] == expected
+
+
+def test_reciprocal_model_within_one_ulp(pim):
+    rng = random.Random(41)
+    cells = random_cells(rng, 2000)
+    before = snapshot(cells)
+    pim.smopsys_bayesian_update(cells, 2000, GOLDEN_PRIOR)
+
+    prior = f32(GOLDEN_PRIOR)
+    diffs = [abs(f32_bits(c.weight) - f32_bits(reciprocal_model(w, p, prior))) for c, (w, p, _) in zip(cells, before)]
+    assert max(diffs) <= 1
+    assert diffs.count(0) > len(diffs) // 2
@@ -0,0 +1,196 @@
+"""
+Test Suite for the multi-QPU port table (qcore_qport_table.c)
+
+Cada placa se emula con su propio hilo detrás de QPORT_AT(board); la tabla
+las descubre por firma, reparte propuestas y recoge los colapsos en el
+orden en que terminan.
+"""
+
+import ctypes
+import time
+import pytest
+
+from test_qpu_emu import QpuEmuConfig, QpuEmuStats, QPU_EMU_LATENCY_FIXED
+
+QPORT_MAX_BOARDS = 4
+QPORT_BOARD_DEPTH = 4
+QPORT_BOARD_STRIDE = 0x1000
+PHASE_LOCK_OFFSET = 0x10
+QPORT_DISPATCH_ROUND_ROBIN = 0
+QPORT_DISPATCH_LEAST_LOADED = 1
+
+
+class MajoranaByte(ctypes.Union):
+    _fields_ = [("raw", ctypes.c_uint8)]
+
+
+class QportResult(ctypes.Structure):
+    _fields_ = [("tag", ctypes.c_uint32),
+                ("board", ctypes.c_uint32),
+                ("cycle", MajoranaByte)]
+
+
+@pytest.fixture
+def table(qcore_lib):
+    lib = qcore_lib
+    lib.qpu_emu_start_board.argtypes = [ctypes.c_uint32, ctypes.POINTER(QpuEmuConfig)]
+    lib.qpu_emu_start_board.restype = ctypes.c_int
+    lib.qpu_emu_get_stats_board.argtypes = [ctypes.c_uint32, ctypes.POINTER(QpuEmuStats)]
+    lib.qport_table_discover.restype = ctypes.c_uint32
+    lib.qport_table_phase_zero.argtypes = [ctypes.c_uint32]
+    lib.qport_table_phase_zero.restype = ctypes.c_uint32
+    lib.qport_table_set_policy.argtypes = [ctypes.c_int]
+    lib.qport_table_submit.argtypes = [ctypes.c_uint8, ctypes.POINTER(ctypes.c_uint32)]
+    lib.qport_table_submit.restype = ctypes.c_int
+    lib.qport_table_gather.argtypes = [ctypes.POINTER(QportResult), ctypes.c_size_t]
+    lib.qport_table_gather.restype = ctypes.c_size_t
+    lib.qport_table_complete.argtypes = [ctypes.POINTER(QportResult)]
+    lib.qport_table_complete.restype = ctypes.c_int
+    lib.qport_table_inflight.restype = ctypes.c_uint32
+
+    def start(boards, **kw):
+        for b in boards:
+            cfg = QpuEmuConfig(**kw.get("per_board", {}).get(b, kw["cfg"]))
+            assert lib.qpu_emu_start_board(b, ctypes.byref(cfg)) == 0
+        return lib.qport_table_discover()
+
+    yield lib, start
+    while lib.qport_table_inflight():
+        lib.qport_table_complete(ctypes.byref(QportResult()))
+    lib.qpu_emu_stop()
+    lib.qport_table_discover()  # Tabla vacía para el resto de tests
+    lib.qport_table_set_policy(QPORT_DISPATCH_ROUND_ROBIN)
+
+
+def _port_word(lib, board, offset):
+    buf = ctypes.c_uint8.in_dll(lib, "mock_mmio_buffer")
+    addr = ctypes.addressof(buf) + board * QPORT_BOARD_STRIDE + offset
+    return ctypes.c_uint32.from_address(addr)
+
+
+def _drain(lib, n):
+    out = QportResult()
+    results = []
+    for _ in range(n):
+        assert lib.qport_table_complete(ctypes.byref(out)) == 0
+        results.append((out.tag, out.board, out.cycle.raw))
+    return results
+
+
+def test_qport_table_discovers_boards_by_signature(table):
+    lib, start = table
+    cfg = dict(latency_dist=QPU_EMU_LATENCY_FIXED, mean_ns=1000, calibrate_ns=0)
+    # Placas en las ventanas 0 y 2; la 1 y la 3 no responden
+    assert start([0, 2], cfg=cfg) == 2
+
+    # Cada placa conserva su propia fase cero
+    _port_word(lib, 2, PHASE_LOCK_OFFSET).value = 77
+    assert lib.qport_table_discover() == 2
+    assert lib.qport_table_phase_zero(0) == 0
+    assert lib.qport_table_phase_zero(2) == 77
+
+    tags = []
+    for i in range(8):
+        tag = ctypes.c_uint32()
+        assert lib.qport_table_submit(i, ctypes.byref(tag)) == 0
+        tags.append(tag.value)
+    assert lib.qport_table_inflight() == 8
+
+    results = _drain(lib, 8)
+    # Round-robin: las propuestas alternan entre las dos placas
+    assert sorted(r[0] for r in results) == tags
+    assert {r[0]: r[1] for r in results} == {t: (0 if t % 2 == 0 else 2) for t in tags}
+    assert all(r[2] & 0x7F == r[0] - tags[0] for r in results)
+    assert lib.qport_table_complete(ctypes.byref(QportResult())) == -1
+
+
+def test_qport_table_backpressure(table):
+    lib, start = table
+    cfg = dict(latency_dist=QPU_EMU_LATENCY_FIXED, mean_ns=200000, calibrate_ns=0)
+    assert start([0, 1], cfg=cfg) == 2
+
+    for i in range(2 * QPORT_BOARD_DEPTH):
+        assert lib.qport_table_submit(i, None) == 0
+    assert lib.qport_table_submit(0, None) == -1
+    _drain(lib, 1)
+    assert lib.qport_table_submit(0, None) == 0
+
+
+def test_qport_table_least_loaded_favours_fast_board(table):
+    lib, start = table
+    fast = dict(latency_dist=QPU_EMU_LATENCY_FIXED, mean_ns=20000, calibrate_ns=0)
+    slow = dict(latency_dist=QPU_EMU_LATENCY_FIXED, mean_ns=2000000, calibrate_ns=0)
+    assert start([0, 1], cfg=fast, per_board={1: slow}) == 2
+    lib.qport_table_set_policy(QPORT_DISPATCH_LEAST_LOADED)
+
+    N = 60
+    per_board = {0: 0, 1: 0}
+    out = QportResult()
+    for i in range(N):
+        while lib.qport_table_submit(i & 0x7F, None) != 0:
+            assert lib.qport_table_complete(ctypes.byref(out)) == 0
+            per_board[out.board] += 1
+    for tag, board, _ in _drain(lib, lib.qport_table_inflight()):
+        per_board[board] += 1
+
+    assert sum(per_board.values()) == N
+    assert per_board[0] > 3 * per_board[1]
+
+
+def _throughput(lib, start, boards, n):
+    cfg = dict(latency_dist=QPU_EMU_LATENCY_FIXED, mean_ns=1000000, calibrate_ns=0, seed=9)
+    assert start(boards, cfg=cfg) == len(boards)
+    out = QportResult()
+    t0 = time.perf_counter()
+    done = 0
+    for i in range(n):
+        while lib.qport_table_submit(i & 0x7F, None) != 0:
+            assert lib.qport_table_complete(ctypes.byref(out)) == 0
+            done += 1
+    while lib.qport_table_complete(ctypes.byref(out)) == 0:
+        done += 1
+    elapsed = time.perf_counter() - t0
+    assert done == n
+    for b in boards:
+        assert _port_word(lib, b, PHASE_LOCK_OFFSET).value == n // len(boards)
+    lib.qpu_emu_stop()
+    return elapsed
+
+
+def test_qport_table_throughput_scales_with_boards(table):
+    lib, start = table
+    N = 80
+    one = _throughput(lib, start, [0], N)
+    four = _throughput(lib, start, [0, 1, 2, 3], N)
+    # Latencias de 1 ms solapadas en 4 placas: ~4x (margen para el planificador)
+    assert one / four > 2.0
+
+
+def test_discover_keeps_bridge_spin_calibration(table):
+    """
+    La placa 0 comparte la IRQ de colapso con el bridge: tras el
+    descubrimiento, bridge_collapse_isr sigue marcando la llegada y la
+    ventana de spin de bridge_tick_sync sigue adaptándose.
+    """
+    lib, start = table
+    lib.bridge_spin_window.restype = ctypes.c_uint64
+    lib.bridge_tick_sync.argtypes = [ctypes.POINTER(MajoranaByte)]
+    sim = ctypes.c_int.in_dll(lib, "g_simulation_mode")
+
+    cfg = dict(latency_dist=QPU_EMU_LATENCY_FIXED, mean_ns=2000000, calibrate_ns=0)
+    assert lib.qpu_emu_start_board(0, ctypes.byref(QpuEmuConfig(**cfg))) == 0
+    sim.value = 0
+    lib.set_mock_uart_input(ord('H'))
+    lib.qport_handshake()
+    assert sim.value == 0
+    default = lib.bridge_spin_window()
+
+    assert lib.qport_table_discover() == 1
+    cycle = MajoranaByte()
+    for i in range(10):
+        cycle.raw = i
+        lib.bridge_tick_sync(ctypes.byref(cycle))
+        assert cycle.raw & 0x7F == i
+    # Colapsos de 2 ms atendidos por IRQ: la ventana se mueve hacia el coste
+    # de dormir y despertar, muy por debajo del valor por defecto
+    assert lib.bridge_spin_window() < default
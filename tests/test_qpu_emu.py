@@ -0,0 +1,180 @@
+"""
+Test Suite for the host QPU emulator (qcore_qpu_emu.c)
+
+El emulador responde detrás de mock_mmio_buffer como el hardware real, así
+que qport_handshake() y bridge_tick_sync()/bridge_complete() recorren el
+camino de hardware (no el modo simulación).
+"""
+
+import ctypes
+import pytest
+
+QPU_EMU_LATENCY_FIXED = 0
+QPU_EMU_LATENCY_UNIFORM = 1
+QPU_EMU_LATENCY_EXPONENTIAL = 2
+PHASE_LOCK_OFFSET = 0x10
+
+
+class QpuEmuConfig(ctypes.Structure):
+    _fields_ = [("latency_dist", ctypes.c_int),
+                ("mean_ns", ctypes.c_uint64),
+                ("spread_ns", ctypes.c_uint64),
+                ("calibrate_ns", ctypes.c_uint64),
+                ("collapse_bias", ctypes.c_uint32),
+                ("seed", ctypes.c_uint32),
+                ("no_batch", ctypes.c_uint32)]
+
+
+class QpuEmuStats(ctypes.Structure):
+    _fields_ = [("commands", ctypes.c_uint64),
+                ("collapses", ctypes.c_uint64),
+                ("measures", ctypes.c_uint64),
+                ("batches", ctypes.c_uint64),
+                ("ones", ctypes.c_uint64),
+                ("busy_ns", ctypes.c_uint64)]
+
+
+class MajoranaByte(ctypes.Union):
+    _fields_ = [("raw", ctypes.c_uint8)]
+
+
+@pytest.fixture
+def qpu(qcore_lib):
+    lib = qcore_lib
+    lib.qpu_emu_start.argtypes = [ctypes.POINTER(QpuEmuConfig)]
+    lib.qpu_emu_start.restype = ctypes.c_int
+    lib.qpu_emu_get_stats.argtypes = [ctypes.POINTER(QpuEmuStats)]
+    lib.bridge_tick_sync.argtypes = [ctypes.POINTER(MajoranaByte)]
+    lib.bridge_submit.argtypes = [ctypes.c_uint8]
+    lib.bridge_submit.restype = ctypes.c_int
+    lib.bridge_complete.argtypes = [ctypes.POINTER(MajoranaByte)]
+    lib.bridge_complete.restype = ctypes.c_int
+    lib.bridge_tick_sync_batch.argtypes = [ctypes.POINTER(MajoranaByte), ctypes.c_size_t]
+    sim = ctypes.c_int.in_dll(lib, "g_simulation_mode")
+
+    def start(**kw):
+        cfg = QpuEmuConfig(**kw)
+        assert lib.qpu_emu_start(ctypes.byref(cfg)) == 0
+        # Camino de hardware: el handshake encuentra la firma y calibra
+        sim.value = 0
+        lib.set_mock_uart_input(ord('H'))
+        lib.qport_handshake()
+        assert sim.value == 0, "El handshake debe encontrar el QPU emulado"
+
+    yield lib, start
+    lib.qpu_emu_stop()
+    sim.value = 0
+
+
+def _phase_lock(lib):
+    buf = ctypes.c_uint8.in_dll(lib, "mock_mmio_buffer")
+    return ctypes.c_uint32.from_address(ctypes.addressof(buf) + PHASE_LOCK_OFFSET).value
+
+
+def test_qpu_emu_sync_bridge_under_load(qpu):
+    lib, start = qpu
+    start(latency_dist=QPU_EMU_LATENCY_UNIFORM, mean_ns=20000, spread_ns=10000,
+          calibrate_ns=1000000, collapse_bias=49152, seed=7)  # P(1) = 0.75
+
+    N = 1500
+    cycle = MajoranaByte()
+    ones = 0
+    for i in range(N):
+        cycle.raw = i & 0x7F
+        lib.bridge_tick_sync(ctypes.byref(cycle))
+        assert cycle.raw & 0x7F == i & 0x7F, "El QPU devuelve la fase propuesta"
+        ones += cycle.raw >> 7
+
+    stats = QpuEmuStats()
+    lib.qpu_emu_get_stats(ctypes.byref(stats))
+    assert stats.collapses == N
+    assert stats.ones == ones
+    assert _phase_lock(lib) == N
+    assert abs(ones / N - 0.75) < 0.05
+
+
+def test_qpu_emu_async_pipeline(qpu):
+    lib, start = qpu
+    start(latency_dist=QPU_EMU_LATENCY_EXPONENTIAL, mean_ns=30000, spread_ns=5000,
+          calibrate_ns=0, collapse_bias=0, seed=11)
+
+    N = 500
+    out = MajoranaByte()
+    results = []
+    assert lib.bridge_submit(0) == 0
+    for i in range(1, N + 1):
+        if i < N:
+            assert lib.bridge_submit(i & 0x7F) == 0
+        assert lib.bridge_complete(ctypes.byref(out)) == 0
+        results.append(out.raw)
+
+    # Orden FIFO y sesgo 0: el bit de Majorana nunca colapsa a 1
+    assert results == [i & 0x7F for i in range(N)]
+    assert _phase_lock(lib) == N
+
+
+def _run_batch(lib, n):
+    cycles = (MajoranaByte * n)()
+    for i in range(n):
+        cycles[i].raw = (3 * i) & 0x7F
+    lib.bridge_tick_sync_batch(cycles, n)
+    for i in range(n):
+        assert cycles[i].raw & 0x7F == (3 * i) & 0x7F, "La ventana conserva las fases"
+    return [c.raw >> 7 for c in cycles]
+
+
+def test_qpu_emu_batch_single_handshake_per_burst(qpu):
+    lib, start = qpu
+    start(latency_dist=QPU_EMU_LATENCY_FIXED, mean_ns=2000,
+          calibrate_ns=0, collapse_bias=49152, seed=3)
+
+    N = 100  # 32 + 32 + 32 + 4: la última ráfaga es parcial
+    bits = _run_batch(lib, N)
+
+    stats = QpuEmuStats()
+    lib.qpu_emu_get_stats(ctypes.byref(stats))
+    assert stats.batches == 4
+    assert stats.commands == 4 + 1  # + CMD_CALIBRATE del handshake
+    assert stats.collapses == N
+    assert stats.ones == sum(bits)
+    assert _phase_lock(lib) == N
+
+
+def test_qpu_emu_batch_unpack_feeds_bulk_stages(qpu):
+    lib, start = qpu
+    start(latency_dist=QPU_EMU_LATENCY_FIXED, mean_ns=1000,
+          calibrate_ns=0, collapse_bias=32768, seed=5)
+    lib.bridge_batch_unpack.argtypes = [ctypes.POINTER(MajoranaByte), ctypes.POINTER(ctypes.c_int32),
+                                        ctypes.POINTER(ctypes.c_int32), ctypes.POINTER(ctypes.c_uint8),
+                                        ctypes.c_size_t]
+
+    N = 32
+    cycles = (MajoranaByte * N)()
+    for i in range(N):
+        cycles[i].raw = (3 * i) & 0x7F
+    lib.bridge_tick_sync_batch(cycles, N)
+
+    phase = (ctypes.c_int32 * N)()
+    collapse = (ctypes.c_int32 * N)()
+    majorana = (ctypes.c_uint8 * N)()
+    lib.bridge_batch_unpack(cycles, phase, collapse, majorana, N)
+    for i in range(N):
+        assert phase[i] == ((3 * i) & 0x7F) << 16
+        assert majorana[i] == cycles[i].raw >> 7
+        assert collapse[i] == majorana[i] << 16
+
+
+def test_qpu_emu_batch_falls_back_without_capability(qpu):
+    lib, start = qpu
+    start(latency_dist=QPU_EMU_LATENCY_FIXED, mean_ns=2000,
+          calibrate_ns=0, collapse_bias=65536, seed=3, no_batch=1)
+
+    N = 40
+    bits = _run_batch(lib, N)
+
+    stats = QpuEmuStats()
+    lib.qpu_emu_get_stats(ctypes.byref(stats))
+    assert stats.batches == 0
+    assert stats.collapses == N
+    assert bits == [1] * N
+    assert _phase_lock(lib) == N
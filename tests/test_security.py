@@ -112,3 +112,170 @@ def test_forensic_log_write(qcore_lib):
         assert True
     except Exception as e:
         pytest.fail(f"write_forensic_log raised exception: {e}")
+
+def _heartbeat_lib(qcore_lib):
+    lib = qcore_lib
+    lib.security_heartbeat.argtypes = [ctypes.POINTER(ctypes.c_uint32), ctypes.c_size_t, ctypes.c_int32, MajoranaByte]
+    lib.get_security_state.restype = ctypes.c_int
+    lib.security_set_crypt_budget.argtypes = [ctypes.c_size_t]
+    lib.security_crypt_progress.restype = ctypes.c_size_t
+    return lib
+
+def test_incremental_encryption_bounded_per_heartbeat(qcore_lib):
+    """
+    Con un presupuesto de B líneas por ciclo, cada heartbeat cifra como
+    mucho 16·B palabras y el buffer queda cubierto en ceil(N / 16B) ciclos,
+    todo con la llave del colapso que inició la hibernación.
+    """
+    lib = _heartbeat_lib(qcore_lib)
+    N, B = 1000, 4
+    buffer = (ctypes.c_uint32 * N)(*[(0x9E3779B9 * i) & 0xFFFFFFFF for i in range(N)])
+    original = list(buffer)
+    first, other = MajoranaByte(), MajoranaByte()
+    first.raw, other.raw = 0x42, 0x17
+    key = ((0x42 << 24) | (0x42 << 16)) ^ 0x5A5A5A5A  # raw y phase_trajectory (7 bits bajos)
+
+    lib.security_set_crypt_budget(B)
+    try:
+        medium = ANOMALY_THRESHOLD + 0x1000
+        cycles = 0
+        while lib.security_crypt_progress() < N:
+            before = lib.security_crypt_progress()
+            lib.security_heartbeat(buffer, N, medium, first if cycles == 0 else other)
+            assert lib.security_crypt_progress() - before <= 16 * B
+            assert lib.get_security_state() == HIBERNATION
+            cycles += 1
+        assert cycles == -(-N // (16 * B))
+        assert list(buffer) == [w ^ key for w in original]
+
+        # Anomalía sostenida: nada que cifrar, los datos no oscilan
+        lib.security_heartbeat(buffer, N, medium, other)
+        assert list(buffer) == [w ^ key for w in original]
+
+        # La condensación devuelve el acceso en el acto y descifra en segundo plano
+        low = 0x00001000
+        cycles = 0
+        while lib.security_crypt_progress() > 0:
+            before = lib.security_crypt_progress()
+            lib.security_heartbeat(buffer, N, low, other)
+            assert lib.get_security_state() == LAMINAR_ACTIVE
+            assert before - lib.security_crypt_progress() <= 16 * B
+            cycles += 1
+        assert cycles == -(-N // (16 * B))
+        assert list(buffer) == original
+    finally:
+        lib.security_set_crypt_budget(0)
+
+def test_incremental_encryption_reverses_mid_pass(qcore_lib):
+    """
+    Condensación a mitad de la evaporación: se descifra desde el final del
+    prefijo cifrado, y una anomalía nueva continúa la página con su llave.
+    """
+    lib = _heartbeat_lib(qcore_lib)
+    N = 333
+    buffer = (ctypes.c_uint32 * N)(*range(N))
+    q_state = MajoranaByte()
+    q_state.raw = 0x81
+
+    lib.security_set_crypt_budget(2)
+    try:
+        for _ in range(3):
+            lib.security_heartbeat(buffer, N, ANOMALY_THRESHOLD + 1, q_state)
+        assert lib.security_crypt_progress() == 96
+        assert list(buffer)[96:] == list(range(96, N))
+
+        lib.security_heartbeat(buffer, N, 0, q_state)
+        assert lib.security_crypt_progress() == 64
+        other = MajoranaByte()
+        other.raw = 0x33
+        lib.security_heartbeat(buffer, N, ANOMALY_THRESHOLD + 1, other)
+        assert lib.security_crypt_progress() == 96
+        for _ in range(3):
+            lib.security_heartbeat(buffer, N, 0, q_state)
+        assert lib.security_crypt_progress() == 0
+        assert lib.get_security_state() == LAMINAR_ACTIVE
+        assert list(buffer) == list(range(N))
+    finally:
+        lib.security_set_crypt_budget(0)
+
+def _security_access(lib):
+    lib.security_access.argtypes = [ctypes.c_size_t, ctypes.c_size_t]
+    lib.security_access.restype = ctypes.POINTER(ctypes.c_uint32)
+    lib.security_encrypted_pages.restype = ctypes.c_size_t
+    return lib.security_access
+
+def test_page_hibernation_transition_only_and_lazy_access(qcore_lib):
+    """
+    Solo la transición cifra; una anomalía sostenida no toca el buffer. Tras
+    la condensación, security_access() descifra únicamente las páginas tocadas.
+    """
+    lib = _heartbeat_lib(qcore_lib)
+    access = _security_access(lib)
+    PAGE, PAGES = 1024, 6
+    N = PAGE * PAGES - 100
+    buffer = (ctypes.c_uint32 * N)(*[(i * 2654435761) & 0xFFFFFFFF for i in range(N)])
+    original = list(buffer)
+    q1, q2 = MajoranaByte(), MajoranaByte()
+    q1.raw, q2.raw = 0x11, 0x6C
+    key1 = ((0x11 << 24) | (0x11 << 16)) ^ 0x5A5A5A5A
+
+    lib.security_heartbeat(buffer, N, ANOMALY_THRESHOLD + 1, q1)
+    assert lib.security_encrypted_pages() == PAGES
+    assert not access(0, 1)  # Evaporado
+    encrypted = [w ^ key1 for w in original]
+    assert list(buffer) == encrypted
+    for _ in range(5):
+        lib.security_heartbeat(buffer, N, ANOMALY_THRESHOLD + 1, q2)
+    assert list(buffer) == encrypted
+
+    # Condensación incremental: una línea por ciclo, casi todo sigue cifrado
+    lib.security_set_crypt_budget(1)
+    try:
+        lib.security_heartbeat(buffer, N, 0, q2)
+        assert lib.get_security_state() == LAMINAR_ACTIVE
+        ptr = access(2 * PAGE + 10, PAGE)  # Toca las páginas 2 y 3
+        assert ptr
+        assert [ptr[i] for i in range(PAGE)] == original[2 * PAGE + 10:3 * PAGE + 10]
+        assert lib.security_encrypted_pages() == PAGES - 2
+        assert list(buffer)[4 * PAGE:] == encrypted[4 * PAGE:]
+        assert not access(N - 5, 6)
+
+        # Hibernación nueva con otra llave: las páginas 2 y 3 se cifran con
+        # ella, las demás conservan la suya; la condensación lo deshace todo
+        lib.security_set_crypt_budget(0)
+        lib.security_heartbeat(buffer, N, ANOMALY_THRESHOLD + 1, q2)
+        assert lib.security_encrypted_pages() == PAGES
+        assert list(buffer)[4 * PAGE:] == encrypted[4 * PAGE:]
+        lib.security_heartbeat(buffer, N, 0, q1)
+        assert lib.security_encrypted_pages() == 0
+        assert list(buffer) == original
+    finally:
+        lib.security_set_crypt_budget(0)
+
+def test_rebind_during_hibernation_encrypts_new_buffer(qcore_lib):
+    """
+    Un buffer enlazado con la hibernación ya en curso también se evapora
+    (con la llave de esa hibernación); el anterior se devuelve en claro.
+    """
+    lib = _heartbeat_lib(qcore_lib)
+    N = 3000
+    first = (ctypes.c_uint32 * N)(*[(i * 40503) & 0xFFFFFFFF for i in range(N)])
+    second = (ctypes.c_uint32 * N)(*[(i * 2246822519) & 0xFFFFFFFF for i in range(N)])
+    first_plain, second_plain = list(first), list(second)
+    q1, q2 = MajoranaByte(), MajoranaByte()
+    q1.raw, q2.raw = 0x11, 0x6C
+    key1 = ((0x11 << 24) | (0x11 << 16)) ^ 0x5A5A5A5A
+
+    lib.security_heartbeat(first, N, ANOMALY_THRESHOLD + 1, q1)
+    assert lib.get_security_state() == HIBERNATION
+    assert list(first) == [w ^ key1 for w in first_plain]
+
+    lib.security_heartbeat(second, N, ANOMALY_THRESHOLD + 1, q2)
+    assert lib.get_security_state() == HIBERNATION
+    assert list(first) == first_plain
+    assert list(second) == [w ^ key1 for w in second_plain]
+    assert lib.security_encrypted_pages() == 3
+
+    lib.security_heartbeat(second, N, 0, q2)
+    assert lib.security_encrypted_pages() == 0
+    assert list(second) == second_plain
@@ -0,0 +1,198 @@
+import pytest
+import ctypes
+import cmath
+import math
+import random
+
+# sv_gate_type_t
+GATE_H, GATE_X, GATE_Z, GATE_PHASE, GATE_CNOT = range(5)
+
+class StateVec(ctypes.Structure):
+    _fields_ = [("n_qubits", ctypes.c_uint32),
+                ("n_threads", ctypes.c_uint32),
+                ("dim", ctypes.c_uint64),
+                ("re", ctypes.POINTER(ctypes.c_float)),
+                ("im", ctypes.POINTER(ctypes.c_float)),
+                ("rng", ctypes.c_uint64),
+                ("pool", ctypes.c_void_p)]
+
+class Gate(ctypes.Structure):
+    _fields_ = [("type", ctypes.c_int),
+                ("target", ctypes.c_uint32),
+                ("control", ctypes.c_uint32),
+                ("theta", ctypes.c_float)]
+
+@pytest.fixture
+def sv_lib(qcore_lib):
+    lib = qcore_lib
+    psv = ctypes.POINTER(StateVec)
+    lib.statevec_create.argtypes = [ctypes.c_uint32, ctypes.c_uint32, ctypes.c_uint64]
+    lib.statevec_create.restype = psv
+    lib.statevec_destroy.argtypes = [psv]
+    lib.statevec_apply.argtypes = [psv, ctypes.POINTER(Gate), ctypes.c_size_t]
+    for name in ("statevec_h", "statevec_x", "statevec_z"):
+        getattr(lib, name).argtypes = [psv, ctypes.c_uint32]
+    lib.statevec_phase.argtypes = [psv, ctypes.c_uint32, ctypes.c_float]
+    lib.statevec_cnot.argtypes = [psv, ctypes.c_uint32, ctypes.c_uint32]
+    lib.statevec_grover.argtypes = [psv, ctypes.c_uint64, ctypes.c_uint32]
+    lib.statevec_prob_one.argtypes = [psv, ctypes.c_uint32]
+    lib.statevec_prob_one.restype = ctypes.c_double
+    lib.statevec_measure.argtypes = [psv, ctypes.c_uint32]
+    lib.statevec_measure.restype = ctypes.c_uint32
+    lib.statevec_attach_bridge.argtypes = [psv, ctypes.c_uint32]
+    return lib
+
+def _amps(sv):
+    s = sv.contents
+    return [complex(s.re[i], s.im[i]) for i in range(s.dim)]
+
+def _reference(n, gates):
+    """Vector de estado de referencia en Python (complejos de doble precisión)."""
+    h = 1 / math.sqrt(2)
+    mats = {GATE_H: (h, h, h, -h), GATE_X: (0, 1, 1, 0), GATE_Z: (1, 0, 0, -1)}
+    amp = [0j] * (1 << n)
+    amp[0] = 1 + 0j
+    for g in gates:
+        m = mats.get(g.type) or ((0, 1, 1, 0) if g.type == GATE_CNOT else (1, 0, 0, cmath.exp(1j * g.theta)))
+        s = 1 << g.target
+        for i0 in range(1 << n):
+            if i0 & s or (g.type == GATE_CNOT and not (i0 >> g.control) & 1):
+                continue
+            a, b = amp[i0], amp[i0 | s]
+            amp[i0], amp[i0 | s] = m[0] * a + m[1] * b, m[2] * a + m[3] * b
+    return amp
+
+def _random_circuit(rng, n, count):
+    gates = []
+    for _ in range(count):
+        kind = rng.choice((GATE_H, GATE_X, GATE_Z, GATE_PHASE, GATE_CNOT))
+        t = rng.randrange(n)
+        c = rng.choice([q for q in range(n) if q != t])
+        gates.append(Gate(kind, t, c, rng.uniform(-math.pi, math.pi)))
+    return gates
+
+def test_bell_state(sv_lib):
+    sv = sv_lib.statevec_create(2, 1, 7)
+    sv_lib.statevec_h(sv, 0)
+    sv_lib.statevec_cnot(sv, 0, 1)
+    amp = _amps(sv)
+    assert abs(amp[0] - 1 / math.sqrt(2)) < 1e-6 and abs(amp[3] - 1 / math.sqrt(2)) < 1e-6
+    assert abs(amp[1]) < 1e-7 and abs(amp[2]) < 1e-7
+    assert abs(sv_lib.statevec_prob_one(sv, 1) - 0.5) < 1e-6
+
+    # La medida colapsa ambos qubits al mismo valor
+    m0 = sv_lib.statevec_measure(sv, 0)
+    assert sv_lib.statevec_prob_one(sv, 1) == pytest.approx(float(m0), abs=1e-6)
+    sv_lib.statevec_destroy(sv)
+
+def test_gates_match_reference(sv_lib):
+    """Puertas sobre qubits bajos (permutación en registro) y altos contra la referencia."""
+    rng = random.Random(11)
+    n = 7
+    gates = _random_circuit(rng, n, 40)
+    expected = _reference(n, gates)
+
+    sv = sv_lib.statevec_create(n, 1, 1)
+    sv_lib.statevec_apply(sv, (Gate * len(gates))(*gates), len(gates))
+    got = _amps(sv)
+    assert max(abs(a - b) for a, b in zip(got, expected)) < 1e-5
+    sv_lib.statevec_destroy(sv)
+
+def test_out_of_range_gates_are_no_ops(sv_lib):
+    """Qubits >= n_qubits y CNOT con control == target no tocan el vector."""
+    rng = random.Random(5)
+    n = 4
+    valid = _random_circuit(rng, n, 12)
+    invalid = [Gate(GATE_H, n, 0, 0.0), Gate(GATE_X, 40, 0, 0.0), Gate(GATE_PHASE, 64, 0, 1.0),
+               Gate(GATE_CNOT, 1, n + 5, 0.0), Gate(GATE_CNOT, 2, 2, 0.0)]
+    gates = valid[:6] + invalid + valid[6:]
+
+    sv = sv_lib.statevec_create(n, 2, 3)
+    sv_lib.statevec_apply(sv, (Gate * len(gates))(*gates), len(gates))
+    sv_lib.statevec_h(sv, n)
+    sv_lib.statevec_cnot(sv, 3, 3)
+    sv_lib.statevec_cnot(sv, 99, 0)
+    expected = _reference(n, valid)
+    got = _amps(sv)
+    assert max(abs(a - b) for a, b in zip(got, expected)) < 1e-5
+
+    for q in (n, 63, 64, 1000):
+        assert sv_lib.statevec_prob_one(sv, q) == 0.0
+        assert sv_lib.statevec_measure(sv, q) == 0
+    assert _amps(sv) == got
+    sv_lib.statevec_destroy(sv)
+
+def test_blocked_threaded_matches_gate_by_gate(sv_lib):
+    """
+    17 qubits: rachas bloqueadas (qubits < 13), pasadas completas para los
+    altos y 4 hilos, frente a puerta a puerta con un solo hilo.
+    """
+    rng = random.Random(5)
+    n = 17
+    gates = _random_circuit(rng, n, 30)
+
+    blocked = sv_lib.statevec_create(n, 4, 1)
+    sv_lib.statevec_apply(blocked, (Gate * len(gates))(*gates), len(gates))
+    serial = sv_lib.statevec_create(n, 1, 1)
+    for g in gates:
+        sv_lib.statevec_apply(serial, ctypes.byref(g), 1)
+
+    a, b = blocked.contents, serial.contents
+    # Los hilos se crean una vez y se reutilizan; con un hilo no hay pool
+    assert a.pool and not b.pool
+    assert all(a.re[i] == b.re[i] and a.im[i] == b.im[i] for i in range(0, a.dim, 37))
+    norm = sum(a.re[i] ** 2 + a.im[i] ** 2 for i in range(a.dim))
+    assert abs(norm - 1.0) < 1e-3
+    sv_lib.statevec_destroy(blocked)
+    sv_lib.statevec_destroy(serial)
+
+def test_grover_amplifies_marked_state(sv_lib):
+    n = 12
+    marked = 1234
+    sv = sv_lib.statevec_create(n, 2, 3)
+    sv_lib.statevec_grover(sv, marked, int(math.pi / 4 * math.sqrt(1 << n)))
+    s = sv.contents
+    assert s.re[marked] ** 2 + s.im[marked] ** 2 > 0.99
+    sv_lib.statevec_destroy(sv)
+
+def test_bridge_collapses_follow_statevector(sv_lib):
+    """
+    Con el simulador enganchado al bridge, cada tick aplica H·P(θ)·H y mide:
+    fase 0 nunca cambia el bit, fase 64 (θ = π) siempre lo invierte y
+    fase 32 (θ = π/2) lo cambia la mitad de las veces.
+    """
+    lib = sv_lib
+    # Otros módulos fijan argtypes con su propia unión MajoranaByte
+    lib.bridge_tick_sync.argtypes = [ctypes.POINTER(ctypes.c_uint8)]
+    lib.bridge_tick_sync.restype = None
+    sim_mode = ctypes.c_int.in_dll(lib, "g_simulation_mode")
+    saved = sim_mode.value
+    sim_mode.value = 1
+    sv = lib.statevec_create(3, 1, 99)
+    lib.statevec_attach_bridge(sv, 2)
+    try:
+        cycle = ctypes.c_uint8(0)
+        for _ in range(8):
+            cycle.value = 0
+            lib.bridge_tick_sync(ctypes.byref(cycle))
+            assert cycle.value == 0
+
+        bits = []
+        for _ in range(8):
+            cycle.value = 64
+            lib.bridge_tick_sync(ctypes.byref(cycle))
+            assert cycle.value & 0x7F == 64
+            bits.append(cycle.value >> 7)
+        assert bits == [1, 0] * 4
+
+        changes, last = 0, bits[-1]
+        for _ in range(400):
+            cycle.value = 32
+            lib.bridge_tick_sync(ctypes.byref(cycle))
+            changes += (cycle.value >> 7) != last
+            last = cycle.value >> 7
+        assert 140 < changes < 260
+    finally:
+        lib.statevec_attach_bridge(None, 0)
+        sim_mode.value = saved
+        lib.statevec_destroy(sv)
@@ -1,4 +1,5 @@
 import pytest
+import math
 import ctypes
 
 def test_quantum_assoc_memory_grover(qcore_lib, to_fixed, from_fixed):
@@ -71,3 +72,170 @@ def test_metriplectic_residue_coupling(qcore_lib, to_fixed):
     residue = get_residue()
     # It should be non-zero as it represents the "Waste" entropy
     assert residue != 0, "No quantum residue (entropy) generated"
+
+def test_quantum_index_and_weakest_eviction(qcore_lib):
+    """
+    Test 5: Índice hash + desalojo por amplitud
+    - Cada escritura ocupa un slot de señal y una fuga de vacío en el vecino.
+    - Con el registro lleno, se desalojan primero las fugas (|amp| mínima),
+      no el slot 0: los datos más antiguos siguen indexados.
+    """
+    init_q = qcore_lib.init_quantum_register
+    write_q = qcore_lib.write_superposition
+    slot_of = qcore_lib.quantum_slot_of
+    write_q.argtypes = [ctypes.c_int32]
+    slot_of.argtypes = [ctypes.c_int32]
+    slot_of.restype = ctypes.c_int32
+
+    init_q()
+    size = 64  # QUANTUM_MEMORY_SIZE
+
+    # Señal en slots pares, fuga en los impares: el registro queda lleno
+    for k in range(size // 2):
+        write_q(1000 + k)
+    assert [slot_of(1000 + k) for k in range(size // 2)] == list(range(0, size, 2))
+
+    # Reescribir un dato existente no consume slots
+    write_q(1000)
+    assert slot_of(1000) == 0
+
+    # Registro lleno: los nuevos datos reemplazan fugas (slots impares)
+    for k in range(size // 2):
+        write_q(5000 + k)
+        assert slot_of(5000 + k) % 2 == 1
+    assert all(slot_of(1000 + k) >= 0 for k in range(size // 2)), "Signal evicted before vacuum leaks"
+
+    # Sin fugas, se desaloja el estado de señal más antiguo (FIFO dentro de la clase)
+    write_q(9999)
+    assert slot_of(9999) >= 0
+    assert slot_of(1001) == -1
+    assert slot_of(1000) == 0, "Reinforced state should be younger than 1001"
+
+def test_quantum_reindex_after_grover(qcore_lib):
+    """
+    Tras una lectura Grover el índice sigue siendo coherente y el registro
+    acepta nuevas escrituras recuperables.
+    """
+    init_q = qcore_lib.init_quantum_register
+    write_q = qcore_lib.write_superposition
+    read_q = qcore_lib.read_quantum_register
+    slot_of = qcore_lib.quantum_slot_of
+    write_q.argtypes = [ctypes.c_int32]
+    read_q.argtypes = [ctypes.c_int32]
+    read_q.restype = ctypes.c_int32
+    slot_of.argtypes = [ctypes.c_int32]
+    slot_of.restype = ctypes.c_int32
+
+    init_q()
+    write_q(7)
+    assert read_q(7) == 7
+
+    for k in range(200):
+        write_q(k * 31 + 3)
+    assert slot_of(199 * 31 + 3) >= 0
+    assert read_q(199 * 31 + 3) == 199 * 31 + 3
+
+def test_grover_iteration_count(qcore_lib):
+    """⌊π/4·√(N/M)⌋ sobre los estados vivos; 0 si no hay marcados o M >= N/2."""
+    iters = qcore_lib.quantum_grover_iterations
+    iters.argtypes = [ctypes.c_uint32, ctypes.c_uint32]
+    iters.restype = ctypes.c_uint32
+
+    assert iters(64, 1) == 6      # El registro clásico lleno: las 6 iteraciones de siempre
+    assert iters(2, 1) == 0
+    assert iters(100, 0) == 0
+    for n, m in ((200, 1), (2000, 1), (10**6, 1), (10**6, 37), (4, 1)):
+        expected = int(math.pi / 4 * math.sqrt(n / m))
+        assert abs(iters(n, m) - expected) <= 1 and iters(n, m) <= expected, f"N={n} M={m}"
+
+def test_runtime_register_in_arena(qcore_lib):
+    """
+    Registro de 20000 estados creado en runtime sobre una arena del llamador:
+    la recuperación Grover funciona lejos de los 64 slots del registro clásico.
+    """
+    lib = qcore_lib
+    lib.quantum_register_footprint.argtypes = [ctypes.c_uint32]
+    lib.quantum_register_footprint.restype = ctypes.c_size_t
+    lib.quantum_register_create.argtypes = [ctypes.c_void_p, ctypes.c_size_t, ctypes.c_uint32]
+    lib.quantum_register_create.restype = ctypes.c_void_p
+    lib.quantum_register_write.argtypes = [ctypes.c_void_p, ctypes.c_int32]
+    lib.quantum_register_read.argtypes = [ctypes.c_void_p, ctypes.c_int32]
+    lib.quantum_register_read.restype = ctypes.c_int32
+    lib.quantum_register_slot_of.argtypes = [ctypes.c_void_p, ctypes.c_int32]
+    lib.quantum_register_slot_of.restype = ctypes.c_int32
+
+    capacity = 20000
+    size = lib.quantum_register_footprint(capacity)
+    arena = ctypes.create_string_buffer(size)
+    assert lib.quantum_register_create(arena, size - 1, capacity) is None
+    assert lib.quantum_register_create(arena, size, 0) is None
+
+    reg = lib.quantum_register_create(arena, size, capacity)
+    assert reg is not None
+
+    for k in range(capacity // 2):
+        lib.quantum_register_write(reg, 7 * k + 1)
+    assert lib.quantum_register_slot_of(reg, 7 * 4321 + 1) == 2 * 4321
+
+    assert lib.quantum_register_read(reg, 7 * 4321 + 1) == 7 * 4321 + 1
+
+def test_large_register_diffusion_mean_is_exact(qcore_lib):
+    """
+    2^19 estados (2^18 señales de 0x2000 y otras tantas fugas de 0x200):
+    Σ amplitudes ≈ 2.3e9 no cabe en 32 bits. Las amplitudes toman pocos
+    valores, así que Grover se modela por clases con sumas exactas y la media
+    de cada difusión se comprueba en los valores finales del registro.
+    """
+    class RegisterHead(ctypes.Structure):
+        _fields_ = [("capacity", ctypes.c_uint32),
+                    ("index_mask", ctypes.c_uint32),
+                    ("amplitude_real", ctypes.POINTER(ctypes.c_int32)),
+                    ("amplitude_imag", ctypes.POINTER(ctypes.c_int32)),
+                    ("data", ctypes.POINTER(ctypes.c_int32))]
+
+    lib = qcore_lib
+    lib.quantum_register_footprint.argtypes = [ctypes.c_uint32]
+    lib.quantum_register_footprint.restype = ctypes.c_size_t
+    lib.quantum_register_create.argtypes = [ctypes.c_void_p, ctypes.c_size_t, ctypes.c_uint32]
+    lib.quantum_register_create.restype = ctypes.POINTER(RegisterHead)
+    lib.quantum_register_write.argtypes = [ctypes.POINTER(RegisterHead), ctypes.c_int32]
+    lib.quantum_register_read.argtypes = [ctypes.POINTER(RegisterHead), ctypes.c_int32]
+    lib.quantum_register_read.restype = ctypes.c_int32
+    lib.quantum_grover_iterations.argtypes = [ctypes.c_uint32, ctypes.c_uint32]
+    lib.quantum_grover_iterations.restype = ctypes.c_uint32
+
+    capacity = 1 << 19
+    size = lib.quantum_register_footprint(capacity)
+    arena = ctypes.create_string_buffer(size)
+    reg = lib.quantum_register_create(arena, size, capacity)
+    for k in range(capacity // 2):
+        lib.quantum_register_write(reg, k + 1)
+    target = 12345 + 1
+
+    def s32(x):
+        x &= 0xFFFFFFFF
+        return x - 2**32 if x >= 2**31 else x
+
+    def model(wrap):
+        # [valor, número de estados]: objetivo, resto de señales, fugas
+        classes = [[0x2000, 1], [0x2000, capacity // 2 - 1], [0x200, capacity // 2]]
+        for _ in range(lib.quantum_grover_iterations(capacity, 1)):
+            classes[0][0] = -classes[0][0]
+            live = [c for c in classes if c[0] != 0]
+            total = sum(v * n for v, n in live)
+            count = sum(n for _, n in live)
+            if wrap:
+                total = s32(total)
+            mean = abs(total) // count * (1 if total >= 0 else -1)
+            for c in live:
+                c[0] = s32(2 * mean - c[0])
+        return [v for v, _ in classes]
+
+    expected = model(wrap=False)
+    assert expected != model(wrap=True), "El modelo de 32 bits debe divergir a esta escala"
+
+    assert lib.quantum_register_read(reg, target) == target
+    amp = reg.contents.amplitude_real
+    assert amp[2 * (target - 1)] == expected[0]
+    assert all(amp[2 * k] == expected[1] for k in range(0, capacity // 2, 997) if k != target - 1)
+    assert all(amp[2 * k + 1] == expected[2] for k in range(0, capacity // 2, 997))
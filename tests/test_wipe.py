@@ -0,0 +1,183 @@
+"""
+Test Suite for the Singularity wipe engine (qcore_wipe.c)
+
+Verifica:
+1. Cada palabra de cada región coincide con el flujo de clave de referencia
+2. Varios workers concurrentes (hilos) se reparten los trozos sin huecos ni solapes
+3. Lo que queda fuera de las regiones no se toca
+4. Progreso medible y la región 0 marcada como terminada antes que el trabajo
+5. La pila del hart 0 se borra entera salvo la ventana viva del borrado
+"""
+
+import ctypes
+import threading
+
+import pytest
+
+POOL_WORDS = 8
+MAX_REGIONS = 6
+STACK_RESERVE = 1024
+CHUNK_BYTES = 256 * 1024
+MASK64 = (1 << 64) - 1
+GOLDEN_64 = 0x9E3779B97F4A7C15
+
+
+class WipeRegion(ctypes.Structure):
+    _fields_ = [
+        ("start", ctypes.c_size_t),
+        ("end", ctypes.c_size_t),
+        ("first_chunk", ctypes.c_uint64),
+        ("n_chunks", ctypes.c_uint64),
+        ("first_word", ctypes.c_uint64),
+    ]
+
+
+class WipeJob(ctypes.Structure):
+    _fields_ = [
+        ("region", WipeRegion * MAX_REGIONS),
+        ("n_regions", ctypes.c_uint32),
+        ("total_chunks", ctypes.c_uint64),
+        ("total_bytes", ctypes.c_uint64),
+        ("pool", ctypes.c_uint64 * POOL_WORDS),
+        ("next_chunk", ctypes.c_uint64),
+        ("chunks_done", ctypes.c_uint64),
+        ("bytes_done", ctypes.c_uint64),
+        ("region_chunks_done", ctypes.c_uint64 * MAX_REGIONS),
+        ("tick_start", ctypes.c_uint64),
+        ("tick_first_region", ctypes.c_uint64),
+        ("tick_end", ctypes.c_uint64),
+    ]
+
+
+@pytest.fixture
+def wipe(qcore_lib):
+    lib = qcore_lib
+    lib.wipe_job_init.argtypes = [ctypes.POINTER(WipeJob), ctypes.POINTER(ctypes.c_uint64)]
+    lib.wipe_job_init.restype = None
+    lib.wipe_add_region.argtypes = [ctypes.POINTER(WipeJob), ctypes.c_size_t, ctypes.c_size_t]
+    lib.wipe_add_region.restype = ctypes.c_int
+    lib.wipe_add_stack.argtypes = [ctypes.POINTER(WipeJob)] + [ctypes.c_size_t] * 4
+    lib.wipe_add_stack.restype = ctypes.c_int
+    lib.wipe_run_worker.argtypes = [ctypes.POINTER(WipeJob)]
+    lib.wipe_run_worker.restype = ctypes.c_uint64
+    lib.wipe_run_all_harts.argtypes = [ctypes.POINTER(WipeJob)]
+    lib.wipe_run_all_harts.restype = None
+    lib.wipe_progress.argtypes = [ctypes.POINTER(WipeJob)]
+    lib.wipe_progress.restype = ctypes.c_uint64
+    lib.wipe_done.argtypes = [ctypes.POINTER(WipeJob)]
+    lib.wipe_done.restype = ctypes.c_int
+    lib.wipe_keystream_word.argtypes = [ctypes.POINTER(WipeJob), ctypes.c_uint64]
+    lib.wipe_keystream_word.restype = ctypes.c_uint64
+    return lib
+
+
+def mix64(z):
+    z = ((z ^ (z >> 30)) * 0xBF58476D1CE4E5B9) & MASK64
+    z = ((z ^ (z >> 27)) * 0x94D049BB133111EB) & MASK64
+    return z ^ (z >> 31)
+
+
+def keystream(pool, i):
+    return mix64((pool[i % POOL_WORDS] + i * GOLDEN_64) & MASK64)
+
+
+def test_threaded_wipe_matches_keystream(wipe):
+    pool = (ctypes.c_uint64 * POOL_WORDS)(*[0x1111111111111111 * (k + 1) for k in range(POOL_WORDS)])
+    job = WipeJob()
+    wipe.wipe_job_init(ctypes.byref(job), pool)
+
+    canary = 0xA5A5A5A5A5A5A5A5
+    ram = (ctypes.c_uint64 * (320 * 1024))(*([canary] * (320 * 1024)))
+    base = ctypes.addressof(ram)
+    # (inicio, fin) en bytes: región 0 de varios trozos con cola, una pequeña
+    # desalineada (se recorta a 8 bytes) y otra vacía que se ignora
+    spans = [(8192, 8192 + 4 * CHUNK_BYTES + 200), (8192 + 4 * CHUNK_BYTES + 4096 + 3, 2_500_000 + 5),
+             (2_540_000, 2_540_000), (2_560_000, 2_600_000)]
+    for lo, hi in spans:
+        assert wipe.wipe_add_region(ctypes.byref(job), base + lo, base + hi) == 0
+    assert job.n_regions == 3
+    assert [job.region[r].n_chunks for r in range(3)] == [5, 6, 1] and job.total_chunks == 12
+
+    counts = []
+    workers = [threading.Thread(target=lambda: counts.append(wipe.wipe_run_worker(ctypes.byref(job))))
+               for _ in range(4)]
+    for w in workers:
+        w.start()
+    for w in workers:
+        w.join()
+
+    assert sum(counts) == job.total_chunks
+    assert wipe.wipe_done(ctypes.byref(job))
+    assert wipe.wipe_progress(ctypes.byref(job)) == job.total_bytes
+    assert 0 < job.tick_first_region <= job.tick_end
+
+    wiped = set()
+    word = 0
+    for r in range(job.n_regions):
+        reg = job.region[r]
+        assert reg.first_word == word
+        for a in range((reg.start - base) // 8, (reg.end - base) // 8):
+            assert ram[a] == keystream(pool, word), (r, a)
+            wiped.add(a)
+            word += 1
+    assert word * 8 == job.total_bytes
+    assert all(ram[a] == canary for a in range(len(ram)) if a not in wiped)
+
+
+def test_harvested_pool_and_region_limit(wipe):
+    job = WipeJob()
+    wipe.wipe_job_init(ctypes.byref(job), None)
+    pool = list(job.pool)
+    for i in (0, 1, 7, 8, 12345, 1 << 40):
+        assert wipe.wipe_keystream_word(ctypes.byref(job), i) == keystream(pool, i)
+
+    buf = (ctypes.c_uint64 * (16 * MAX_REGIONS))()
+    base = ctypes.addressof(buf)
+    for k in range(MAX_REGIONS):
+        assert wipe.wipe_add_region(ctypes.byref(job), base + 128 * k, base + 128 * k + 64) == 0
+    assert wipe.wipe_add_region(ctypes.byref(job), base + 96, base + 128) == -1
+
+    # En el host wipe_run_all_harts trabaja solo con el hilo llamante
+    wipe.wipe_run_all_harts(ctypes.byref(job))
+    assert wipe.wipe_done(ctypes.byref(job)) and job.chunks_done == MAX_REGIONS
+    for k in range(MAX_REGIONS):
+        for w in range(8):
+            assert buf[16 * k + w] == keystream(pool, 8 * k + w)
+        assert all(buf[16 * k + 8 + w] == 0 for w in range(8))
+
+
+def test_main_stack_wiped_around_live_frame(wipe):
+    """
+    Como trigger_singularity: la pila del hart 0 (secure_buffer y el
+    atractor de kernel_main) se borra por debajo de sp - WIPE_STACK_RESERVE
+    y por encima del marco del borrado; solo esa ventana queda intacta.
+    """
+    pool = (ctypes.c_uint64 * POOL_WORDS)(*range(1, POOL_WORDS + 1))
+    job = WipeJob()
+    wipe.wipe_job_init(ctypes.byref(job), pool)
+
+    words = 16 * 1024                       # Pila de 128 KiB
+    stack = (ctypes.c_uint64 * words)(*[0xCAFEBABE00000000 + i for i in range(words)])
+    bottom = ctypes.addressof(stack)
+    top = bottom + 8 * words
+    sp, frame_top = bottom + 100_000, bottom + 100_512
+    live = range((sp - STACK_RESERVE - bottom) // 8, (frame_top - bottom) // 8)
+
+    assert wipe.wipe_add_stack(ctypes.byref(job), bottom, top, sp - STACK_RESERVE, frame_top) == 0
+    assert job.n_regions == 2
+    wipe.wipe_run_all_harts(ctypes.byref(job))
+    assert wipe.wipe_done(ctypes.byref(job))
+
+    seq = [a for a in range(words) if a not in live]
+    assert job.total_bytes == 8 * len(seq)
+    assert all(stack[a] == keystream(pool, i) for i, a in enumerate(seq))
+    assert all(stack[a] == 0xCAFEBABE00000000 + a for a in live)
+
+    # Ventana fuera de la pila: se recorta y la pila se borra entera
+    job = WipeJob()
+    wipe.wipe_job_init(ctypes.byref(job), pool)
+    assert wipe.wipe_add_stack(ctypes.byref(job), bottom, top, top + 64, top + 128) == 0
+    assert job.n_regions == 1 and job.total_bytes == 8 * words
+    for _ in range(MAX_REGIONS - 1):
+        wipe.wipe_add_region(ctypes.byref(job), bottom, bottom + 64)
+    assert wipe.wipe_add_stack(ctypes.byref(job), bottom, top, sp, frame_top) == -1
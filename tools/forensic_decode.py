@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""
+Decodificador del anillo forense (include/qcore_forensic.h).
+
+Lee la región desde un volcado de memoria y lista los registros válidos en
+orden de secuencia. Un registro es válido si su sello coincide con la
+posición que le corresponde en el anillo según head; los vacíos, a medio
+escribir o sobrescritos se descartan.
+
+Uso:
+    forensic_decode.py DUMP [--offset N] [--base ADDR]
+
+--offset es la posición de la región dentro del fichero; con --base (la
+dirección física del primer byte del volcado) se calcula a partir de
+FORENSIC_MEM_ADDR.
+"""
+
+import argparse
+import struct
+import sys
+
+FORENSIC_MEM_ADDR = 0x00001000
+MAGIC = 0x464C4F47
+HEADER = struct.Struct("<IHHQ")           # magic, record_size, capacity, head
+RECORD = struct.Struct("<QiIIBBH")         # tick, surprise, cycle, seq, majorana, state, reserved
+STATES = {0: "LAMINAR_ACTIVE", 1: "HIBERNATION", 2: "SINGULARITY"}
+
+
+def decode(buf, offset=0):
+    """Registros válidos como dicts, del más antiguo al más reciente"""
+    magic, record_size, capacity, head = HEADER.unpack_from(buf, offset)
+    if magic != MAGIC:
+        raise ValueError("no forensic ring at offset 0x%x (magic 0x%08x)" % (offset, magic))
+    if record_size != RECORD.size:
+        raise ValueError("unsupported record size %d" % record_size)
+
+    records = []
+    for n in range(max(0, head - capacity), head):
+        pos = offset + HEADER.size + (n % capacity) * record_size
+        tick, surprise, cycle, seq, majorana, state, _ = RECORD.unpack_from(buf, pos)
+        if seq != ((n + 1) & 0xFFFFFFFF):
+            continue
+        records.append({
+            "seq": n,
+            "tick": tick,
+            "surprise": surprise,
+            "cycle": cycle,
+            "majorana": majorana,
+            "state": state,
+        })
+    return records
+
+
+def format_record(r):
+    return "#%-6d tick=%-20d cycle=%-10d surprise=%11.5f majorana=0x%02x (phase=%3d, collapse=%d) %s" % (
+        r["seq"], r["tick"], r["cycle"], r["surprise"] / 65536.0, r["majorana"],
+        r["majorana"] & 0x7F, r["majorana"] >> 7, STATES.get(r["state"], str(r["state"])))
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("dump")
+    parser.add_argument("--offset", type=lambda v: int(v, 0), default=None)
+    parser.add_argument("--base", type=lambda v: int(v, 0), default=None)
+    args = parser.parse_args(argv)
+
+    offset = args.offset
+    if offset is None:
+        offset = FORENSIC_MEM_ADDR - args.base if args.base is not None else 0
+    with open(args.dump, "rb") as f:
+        buf = f.read()
+
+    try:
+        records = decode(buf, offset)
+    except (ValueError, struct.error) as e:
+        print("forensic_decode: %s" % e, file=sys.stderr)
+        return 1
+    for r in records:
+        print(format_record(r))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,26 @@
+// Generador de la tabla de cuarto de onda para fixed_cos/fixed_sin.
+// Se ejecuta en el host durante el build y emite kernel/qcore_sintab.c.
+// La tabla no se versiona: siempre se regenera desde esta fuente.
+// El tamaño sale de QCORE_SINTAB_BITS en qcore_math.h (única fuente).
+#include <math.h>
+#include <stdio.h>
+#include "../include/qcore_math.h"
+
+#define SINTAB_SIZE (1 << QCORE_SINTAB_BITS)
+
+int main(void) {
+    const double pi = 3.14159265358979323846;
+
+    printf("// Auto-generado por tools/gen_sintab.c - NO EDITAR\n");
+    printf("// sin(i * (pi/2) / %d) en Q2.30, i = 0..%d (+1 guarda para interpolar)\n",
+           SINTAB_SIZE, SINTAB_SIZE + 1);
+    printf("#include \"../include/qcore_math.h\"\n\n");
+    printf("const int32_t qcore_sintab_q30[(1 << QCORE_SINTAB_BITS) + 2] = {\n");
+    for (int i = 0; i < SINTAB_SIZE + 2; i++) {
+        double v = sin((double)i * (pi / 2.0) / (double)SINTAB_SIZE);
+        long q = lround(v * 1073741824.0);
+        printf("%s%ld,%s", (i % 6 == 0) ? "    " : " ", q, (i % 6 == 5) ? "\n" : "");
+    }
+    printf("\n};\n");
+    return 0;
+}